@@ -0,0 +1,180 @@
+//! This file is a part of Dreamy Utilities.
+//! Licensed under the MIT license (see LICENSE file).
+
+#include "Allocator.hpp"
+
+namespace dreamy {
+
+IAllocator &IAllocator::Heap(void) {
+  // Never destroyed so that buffers can still be freed during static destruction
+  static CHeapAllocator *pHeap = new CHeapAllocator;
+  return *pHeap;
+};
+
+void *CHeapAllocator::Allocate(size_t iSize, size_t iAlign) {
+  if (iSize == 0) iSize = 1;
+
+  if (iAlign <= DEFAULT_ALIGN) {
+    return malloc(iSize);
+  }
+
+  // Allocate more and remember the original pointer right before the aligned one
+  c8 *pMemory = (c8 *)malloc(iSize + iAlign + sizeof(void *));
+  if (pMemory == nullptr) return nullptr;
+
+  const size_t iAddress = size_t(pMemory + sizeof(void *));
+  c8 *pAligned = (c8 *)((iAddress + iAlign - 1) & ~(iAlign - 1));
+
+  ((void **)pAligned)[-1] = pMemory;
+  return pAligned;
+};
+
+void *CHeapAllocator::Reallocate(void *pMemory, size_t iOldSize, size_t iNewSize, size_t iAlign) {
+  if (iNewSize == 0) iNewSize = 1;
+
+  if (iAlign <= DEFAULT_ALIGN) {
+    return realloc(pMemory, iNewSize);
+  }
+
+  void *pNewMemory = Allocate(iNewSize, iAlign);
+  if (pNewMemory == nullptr) return nullptr;
+
+  if (pMemory != nullptr) {
+    memcpy(pNewMemory, pMemory, (iOldSize < iNewSize) ? iOldSize : iNewSize);
+    Free(pMemory, iOldSize, iAlign);
+  }
+
+  return pNewMemory;
+};
+
+void CHeapAllocator::Free(void *pMemory, size_t iSize, size_t iAlign) {
+  if (pMemory == nullptr) return;
+
+  if (iAlign <= DEFAULT_ALIGN) {
+    free(pMemory);
+  } else {
+    free(((void **)pMemory)[-1]);
+  }
+
+  (void)iSize;
+};
+
+CArenaAllocator::CArenaAllocator(size_t iFirstBlock, IAllocator *pParent) :
+  _pParent(pParent != nullptr ? pParent : &IAllocator::Heap()), _iCurrent(0), _iUsed(0),
+  _iNextBlock(iFirstBlock != 0 ? iFirstBlock : size_t(DEFAULT_BLOCK)), _pLast(nullptr)
+{
+};
+
+CArenaAllocator::~CArenaAllocator() {
+  Release();
+};
+
+void *CArenaAllocator::Allocate(size_t iSize, size_t iAlign) {
+  // Try the current block and then the ones after it that have been kept after a reset
+  for (; _iCurrent < _aBlocks.size(); ++_iCurrent, _iUsed = 0) {
+    const Block &block = _aBlocks[_iCurrent];
+
+    const size_t iAddress = size_t(block.pData + _iUsed);
+    const size_t iPadding = (iAlign - (iAddress & (iAlign - 1))) & (iAlign - 1);
+
+    if (block.iSize - _iUsed >= iPadding + iSize) {
+      _pLast = block.pData + _iUsed + iPadding;
+      _iUsed += iPadding + iSize;
+      return _pLast;
+    }
+  }
+
+  // Add a block that fits the memory with any alignment
+  Block block;
+  block.iSize = (iSize + iAlign > _iNextBlock) ? iSize + iAlign : _iNextBlock;
+  block.pData = (c8 *)_pParent->Allocate(block.iSize);
+
+  if (block.pData == nullptr) {
+    _iCurrent = (_aBlocks.empty() ? 0 : _aBlocks.size() - 1);
+    _iUsed = (_aBlocks.empty() ? 0 : _aBlocks.back().iSize);
+    return nullptr;
+  }
+
+  // Allocate larger blocks as more memory is needed
+  if (_iNextBlock < DEFAULT_BLOCK * 256) _iNextBlock *= 2;
+
+  _aBlocks.push_back(block);
+  _iCurrent = _aBlocks.size() - 1;
+  _iUsed = 0;
+
+  return Allocate(iSize, iAlign);
+};
+
+void *CArenaAllocator::Reallocate(void *pMemory, size_t iOldSize, size_t iNewSize, size_t iAlign) {
+  if (pMemory == nullptr) return Allocate(iNewSize, iAlign);
+
+  // Resize the latest allocation in place
+  if (pMemory == _pLast) {
+    const Block &block = _aBlocks[_iCurrent];
+    const size_t iOffset = size_t(_pLast - block.pData);
+
+    if (block.iSize - iOffset >= iNewSize) {
+      _iUsed = iOffset + iNewSize;
+      return pMemory;
+    }
+  }
+
+  void *pNewMemory = Allocate(iNewSize, iAlign);
+  if (pNewMemory == nullptr) return nullptr;
+
+  memcpy(pNewMemory, pMemory, (iOldSize < iNewSize) ? iOldSize : iNewSize);
+  return pNewMemory;
+};
+
+void CArenaAllocator::Free(void *pMemory, size_t iSize, size_t iAlign) {
+  // Give back the latest allocation
+  if (pMemory != nullptr && pMemory == _pLast) {
+    _iUsed = size_t(_pLast - _aBlocks[_iCurrent].pData);
+    _pLast = nullptr;
+  }
+
+  (void)iSize;
+  (void)iAlign;
+};
+
+void CArenaAllocator::Reset(void) {
+  _iCurrent = 0;
+  _iUsed = 0;
+  _pLast = nullptr;
+};
+
+void CArenaAllocator::Release(void) {
+  const size_t ct = _aBlocks.size();
+
+  for (size_t i = 0; i < ct; ++i) {
+    _pParent->Free(_aBlocks[i].pData, _aBlocks[i].iSize);
+  }
+
+  _aBlocks.clear();
+  Reset();
+};
+
+size_t CArenaAllocator::Used(void) const {
+  if (_aBlocks.empty()) return 0;
+
+  size_t iUsed = _iUsed;
+
+  for (size_t i = 0; i < _iCurrent; ++i) {
+    iUsed += _aBlocks[i].iSize;
+  }
+
+  return iUsed;
+};
+
+size_t CArenaAllocator::Capacity(void) const {
+  size_t iCapacity = 0;
+  const size_t ct = _aBlocks.size();
+
+  for (size_t i = 0; i < ct; ++i) {
+    iCapacity += _aBlocks[i].iSize;
+  }
+
+  return iCapacity;
+};
+
+}; // namespace dreamy
@@ -0,0 +1,207 @@
+//! This file is a part of Dreamy Utilities.
+//! Licensed under the MIT license (see LICENSE file).
+
+#ifndef _DREAMYUTILITIES_INCL_ALLOCATOR_H
+#define _DREAMYUTILITIES_INCL_ALLOCATOR_H
+
+#include "../DreamyUtilitiesBase.hpp"
+
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+#include <vector>
+
+#if _DREAMY_CPP11
+  #include <utility>
+#endif
+
+namespace dreamy {
+
+// Interface for allocating raw memory
+class IAllocator {
+
+public:
+  // Alignment that's used when none is specified (same as malloc() guarantees)
+  enum { DEFAULT_ALIGN = sizeof(void *) * 2 };
+
+public:
+  // Destructor
+  virtual ~IAllocator() {};
+
+  // Allocate memory aligned to a power of two or return nullptr on failure
+  virtual void *Allocate(size_t iSize, size_t iAlign = DEFAULT_ALIGN) = 0;
+
+  // Change size of allocated memory while keeping its contents or return nullptr on failure (old memory stays valid then)
+  virtual void *Reallocate(void *pMemory, size_t iOldSize, size_t iNewSize, size_t iAlign = DEFAULT_ALIGN) = 0;
+
+  // Free allocated memory of some size and alignment
+  virtual void Free(void *pMemory, size_t iSize, size_t iAlign = DEFAULT_ALIGN) = 0;
+
+  // Get allocator that uses the global heap
+  static IAllocator &Heap(void);
+};
+
+// Allocator that uses the global heap
+class CHeapAllocator : public IAllocator {
+
+public:
+  virtual void *Allocate(size_t iSize, size_t iAlign = DEFAULT_ALIGN);
+  virtual void *Reallocate(void *pMemory, size_t iOldSize, size_t iNewSize, size_t iAlign = DEFAULT_ALIGN);
+  virtual void Free(void *pMemory, size_t iSize, size_t iAlign = DEFAULT_ALIGN);
+};
+
+// Allocator that takes memory from large blocks by moving a pointer forward
+// Individual allocations are only freed if they are the last ones and everything else is released at once
+// Not thread-safe and all memory must outlive objects that use it
+class CArenaAllocator : public IAllocator {
+
+private:
+  // One block of memory
+  struct Block {
+    c8 *pData;
+    size_t iSize;
+  };
+
+  IAllocator *_pParent; // Allocator for blocks
+  std::vector<Block> _aBlocks; // Blocks in the order of usage
+  size_t _iCurrent; // Current block
+  size_t _iUsed; // Used bytes in the current block
+  size_t _iNextBlock; // Size of the next block
+  c8 *_pLast; // Latest allocation that can still be resized or freed
+
+public:
+  // Default size of the first block
+  enum { DEFAULT_BLOCK = 64 * 1024 };
+
+  // Constructor with a size of the first block and an allocator for blocks (heap if none)
+  CArenaAllocator(size_t iFirstBlock = DEFAULT_BLOCK, IAllocator *pParent = nullptr);
+
+  // Destructor
+  ~CArenaAllocator();
+
+  virtual void *Allocate(size_t iSize, size_t iAlign = DEFAULT_ALIGN);
+  virtual void *Reallocate(void *pMemory, size_t iOldSize, size_t iNewSize, size_t iAlign = DEFAULT_ALIGN);
+  virtual void Free(void *pMemory, size_t iSize, size_t iAlign = DEFAULT_ALIGN);
+
+  // Make all memory available again while keeping blocks for reuse
+  void Reset(void);
+
+  // Free all blocks
+  void Release(void);
+
+  // Get amount of bytes taken from all blocks so far
+  size_t Used(void) const;
+
+  // Get amount of bytes in all blocks
+  size_t Capacity(void) const;
+
+private:
+  // Copying is not allowed
+  CArenaAllocator(const CArenaAllocator &);
+  CArenaAllocator &operator=(const CArenaAllocator &);
+};
+
+// Allocator for STL containers that takes memory from an allocator interface (heap if none)
+template<typename Type>
+class CAllocatorAdapter {
+
+public:
+  // STL styled typedefs
+  typedef Type value_type;
+  typedef Type *pointer;
+  typedef const Type *const_pointer;
+  typedef Type &reference;
+  typedef const Type &const_reference;
+  typedef size_t size_type;
+  typedef ptrdiff_t difference_type;
+
+  // Same allocator for another type
+  template<typename Other>
+  struct rebind {
+    typedef CAllocatorAdapter<Other> other;
+  };
+
+  IAllocator *_pAllocator;
+
+public:
+  // Constructor with a specific allocator
+  CAllocatorAdapter(IAllocator *pAllocator = nullptr) : _pAllocator(pAllocator != nullptr ? pAllocator : &IAllocator::Heap())
+  {
+  };
+
+  // Conversion from an adapter of another type
+  template<typename Other>
+  CAllocatorAdapter(const CAllocatorAdapter<Other> &other) : _pAllocator(other._pAllocator)
+  {
+  };
+
+  // Allocate memory for some amount of values
+  Type *allocate(size_t ct, const void * = nullptr) {
+    void *pMemory = _pAllocator->Allocate(ct * sizeof(Type), AlignOf());
+    if (pMemory == nullptr) throw std::bad_alloc();
+
+    return (Type *)pMemory;
+  };
+
+  // Free memory of some amount of values
+  void deallocate(Type *p, size_t ct) {
+    _pAllocator->Free(p, ct * sizeof(Type), AlignOf());
+  };
+
+  // Construct a value in allocated memory
+  void construct(Type *p, const Type &val) {
+    new ((void *)p) Type(val);
+  };
+
+  // Destroy a value without freeing memory
+  void destroy(Type *p) {
+    p->~Type();
+  };
+
+#if _DREAMY_CPP11
+  // Construct a value of any type from any arguments
+  template<typename Other, typename... Args>
+  void construct(Other *p, Args &&... args) {
+    new ((void *)p) Other(std::forward<Args>(args)...);
+  };
+
+  // Destroy a value of any type
+  template<typename Other>
+  void destroy(Other *p) {
+    p->~Other();
+  };
+#endif
+
+  // Get address of a value
+  Type *address(Type &val) const { return &val; };
+  const Type *address(const Type &val) const { return &val; };
+
+  // Maximum amount of values that can be allocated
+  size_t max_size(void) const {
+    return size_t(-1) / sizeof(Type);
+  };
+
+  // Memory from one adapter can be freed by another one with the same allocator
+  template<typename Other>
+  bool operator==(const CAllocatorAdapter<Other> &other) const {
+    return _pAllocator == other._pAllocator;
+  };
+
+  template<typename Other>
+  bool operator!=(const CAllocatorAdapter<Other> &other) const {
+    return _pAllocator != other._pAllocator;
+  };
+
+private:
+  // Alignment of the value type
+  static size_t AlignOf(void) {
+    struct Aligned { c8 ch; Type val; };
+    const size_t iAlign = sizeof(Aligned) - sizeof(Type);
+
+    return (iAlign < sizeof(void *)) ? sizeof(void *) : iAlign;
+  };
+};
+
+}; // namespace dreamy
+
+#endif // (Dreamy Utilities Include Guard)
@@ -0,0 +1,32 @@
+//! This file is a part of Dreamy Utilities.
+//! Licensed under the MIT license (see LICENSE file).
+
+#include "Atomic.hpp"
+
+#if !_DREAMY_UNIX && !_DREAMY_CPP11
+
+#ifndef WIN32_LEAN_AND_MEAN
+  #define WIN32_LEAN_AND_MEAN
+#endif
+
+#ifndef NOMINMAX
+  #define NOMINMAX
+#endif
+
+#include <windows.h>
+
+namespace dreamy {
+
+// Increment the counter and return its new value
+long AtomicIncrement(AtomicCounter &ct) {
+  return InterlockedIncrement((long *)&ct);
+};
+
+// Decrement the counter and return its new value
+long AtomicDecrement(AtomicCounter &ct) {
+  return InterlockedDecrement((long *)&ct);
+};
+
+}; // namespace dreamy
+
+#endif
@@ -0,0 +1,49 @@
+//! This file is a part of Dreamy Utilities.
+//! Licensed under the MIT license (see LICENSE file).
+
+#ifndef _DREAMYUTILITIES_INCL_ATOMIC_H
+#define _DREAMYUTILITIES_INCL_ATOMIC_H
+
+#include "../DreamyUtilitiesBase.hpp"
+
+// Interlocked intrinsics
+#if !_DREAMY_UNIX && _DREAMY_CPP11
+  #include <intrin.h>
+#endif
+
+namespace dreamy {
+
+// Counter that can be safely changed from multiple threads
+typedef volatile long AtomicCounter;
+
+#if !_DREAMY_UNIX && !_DREAMY_CPP11
+
+// Old compilers may lack the intrinsics, so these use Win32 functions in the source file to keep <windows.h> out of headers
+long AtomicIncrement(AtomicCounter &ct);
+long AtomicDecrement(AtomicCounter &ct);
+
+#else
+
+// Increment the counter and return its new value
+inline long AtomicIncrement(AtomicCounter &ct) {
+#if !_DREAMY_UNIX
+  return _InterlockedIncrement(&ct);
+#else
+  return __sync_add_and_fetch(&ct, 1);
+#endif
+};
+
+// Decrement the counter and return its new value
+inline long AtomicDecrement(AtomicCounter &ct) {
+#if !_DREAMY_UNIX
+  return _InterlockedDecrement(&ct);
+#else
+  return __sync_sub_and_fetch(&ct, 1);
+#endif
+};
+
+#endif
+
+}; // namespace dreamy
+
+#endif // (Dreamy Utilities Include Guard)
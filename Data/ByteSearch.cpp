@@ -0,0 +1,370 @@
+//! This file is a part of Dreamy Utilities.
+//! Licensed under the MIT license (see LICENSE file).
+
+#include "ByteSearch.hpp"
+#include "SIMD.hpp"
+
+namespace dreamy {
+
+// Bytes in their original order
+struct ForwardBytes {
+  const u8 *p;
+
+  ForwardBytes(const c8 *pch) : p((const u8 *)pch) {};
+
+  inline u8 operator[](size_t i) const {
+    return p[i];
+  };
+};
+
+// Bytes in reverse order (index 0 is the last byte)
+struct BackwardBytes {
+  const u8 *p;
+
+  BackwardBytes(const c8 *pch, size_t iLength) : p((const u8 *)pch + iLength - 1) {};
+
+  inline u8 operator[](size_t i) const {
+    return *(p - i);
+  };
+};
+
+// Find the first occurrence of a sequence of at least 2 bytes using the Two-Way algorithm (Crochemore & Perrin)
+// Takes O(iLength + iFindLength) time and constant memory
+template<class Bytes>
+static size_t TwoWaySearch(const Bytes &h, size_t iLength, const Bytes &n, size_t m) {
+  if (m > iLength) return NULL_POS;
+
+  // Remember which bytes are in the needle and how far from the end they appear last
+  u32 aByteSet[8] = { 0 };
+  size_t aShift[256];
+
+  for (size_t i = 0; i < m; ++i) {
+    aByteSet[n[i] >> 5] |= (1UL << (n[i] & 31));
+    aShift[n[i]] = i + 1;
+  }
+
+  // Compute the maximal suffix
+  size_t ip = NULL_POS, jp = 0, k = 1, p = 1;
+
+  while (jp + k < m) {
+    if (n[ip + k] == n[jp + k]) {
+      if (k == p) {
+        jp += p;
+        k = 1;
+      } else {
+        ++k;
+      }
+
+    } else if (n[ip + k] > n[jp + k]) {
+      jp += k;
+      k = 1;
+      p = jp - ip;
+
+    } else {
+      ip = jp++;
+      k = p = 1;
+    }
+  }
+
+  size_t ms = ip;
+  const size_t p0 = p;
+
+  // And with the opposite comparison
+  ip = NULL_POS; jp = 0; k = p = 1;
+
+  while (jp + k < m) {
+    if (n[ip + k] == n[jp + k]) {
+      if (k == p) {
+        jp += p;
+        k = 1;
+      } else {
+        ++k;
+      }
+
+    } else if (n[ip + k] < n[jp + k]) {
+      jp += k;
+      k = 1;
+      p = jp - ip;
+
+    } else {
+      ip = jp++;
+      k = p = 1;
+    }
+  }
+
+  // Pick the later critical position
+  if (ip + 1 > ms + 1) {
+    ms = ip;
+  } else {
+    p = p0;
+  }
+
+  // Check if the needle is periodic
+  bool bPeriodic = true;
+
+  for (size_t i = 0; i < ms + 1; ++i) {
+    if (n[i] != n[i + p]) {
+      bPeriodic = false;
+      break;
+    }
+  }
+
+  size_t mem0 = 0;
+
+  if (bPeriodic) {
+    mem0 = m - p;
+  } else {
+    p = ((ms > m - ms - 1) ? ms : m - ms - 1) + 1;
+  }
+
+  size_t mem = 0;
+  size_t iPos = 0;
+
+  while (iPos + m <= iLength) {
+    // Check the last byte first and skip ahead on a mismatch
+    const u8 chLast = h[iPos + m - 1];
+
+    if (!(aByteSet[chLast >> 5] & (1UL << (chLast & 31)))) {
+      iPos += m;
+      mem = 0;
+      continue;
+    }
+
+    k = m - aShift[chLast];
+
+    if (k != 0) {
+      if (k < mem) k = mem;
+
+      iPos += k;
+      mem = 0;
+      continue;
+    }
+
+    // Compare the right half
+    for (k = (ms + 1 > mem) ? ms + 1 : mem; k < m && n[k] == h[iPos + k]; ++k);
+
+    if (k < m) {
+      iPos += k - ms;
+      mem = 0;
+      continue;
+    }
+
+    // Compare the left half
+    for (k = ms + 1; k > mem && n[k - 1] == h[iPos + k - 1]; --k);
+
+    if (k <= mem) return iPos;
+
+    iPos += p;
+    mem = mem0;
+  }
+
+  return NULL_POS;
+};
+
+#if _DREAMY_SSE2
+
+// Check candidate positions whose first and last bytes match in 16-byte blocks (Mula's filter)
+// Gives up once false candidates take too much time and returns how many positions have been examined
+static size_t FindBytes_SSE2(const c8 *pch, size_t iLength, const c8 *pchFind, size_t m, size_t &iScanned) {
+  const __m128i vFirst = _mm_set1_epi8(pchFind[0]);
+  const __m128i vLast = _mm_set1_epi8(pchFind[m - 1]);
+
+  size_t iWork = 0;
+  size_t i = 0;
+
+  for (; i + m + 15 <= iLength; i += 16) {
+    const __m128i vBlockFirst = _mm_loadu_si128((const __m128i *)(pch + i));
+    const __m128i vBlockLast = _mm_loadu_si128((const __m128i *)(pch + i + m - 1));
+
+    u32 iMask = _mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(vBlockFirst, vFirst), _mm_cmpeq_epi8(vBlockLast, vLast)));
+
+    while (iMask != 0) {
+      const u32 iBit = LowestSetBit(iMask);
+      if (memcmp(pch + i + iBit + 1, pchFind + 1, m - 2) == 0) return i + iBit;
+
+      iWork += m;
+      iMask &= iMask - 1;
+    }
+
+    // Too many false candidates
+    if (iWork > i * 2 + m * 4 + 64) {
+      iScanned = i + 16;
+      return NULL_POS;
+    }
+  }
+
+  iScanned = i;
+  return NULL_POS;
+};
+
+// Same as FindBytes_SSE2() but from the end and returns how many positions remain at the beginning
+static size_t FindLastBytes_SSE2(const c8 *pch, size_t iLength, const c8 *pchFind, size_t m, size_t &iRemaining) {
+  const __m128i vFirst = _mm_set1_epi8(pchFind[0]);
+  const __m128i vLast = _mm_set1_epi8(pchFind[m - 1]);
+
+  const size_t ctPositions = iLength - m + 1;
+  size_t iWork = 0;
+  size_t iEnd = ctPositions;
+
+  while (iEnd >= 16) {
+    const size_t i = iEnd - 16;
+
+    const __m128i vBlockFirst = _mm_loadu_si128((const __m128i *)(pch + i));
+    const __m128i vBlockLast = _mm_loadu_si128((const __m128i *)(pch + i + m - 1));
+
+    u32 iMask = _mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(vBlockFirst, vFirst), _mm_cmpeq_epi8(vBlockLast, vLast)));
+
+    while (iMask != 0) {
+      const u32 iBit = HighestSetBit(iMask);
+      if (memcmp(pch + i + iBit + 1, pchFind + 1, m - 2) == 0) return i + iBit;
+
+      iWork += m;
+      iMask &= ~(1UL << iBit);
+    }
+
+    iEnd = i;
+
+    // Too many false candidates
+    if (iWork > (ctPositions - iEnd) * 2 + m * 4 + 64) break;
+  }
+
+  iRemaining = iEnd;
+  return NULL_POS;
+};
+
+#endif // _DREAMY_SSE2
+
+size_t FindByte(const c8 *pch, size_t iLength, c8 ch) {
+  // Standard library implementations are already vectorized
+  const c8 *pchFound = (const c8 *)memchr(pch, ch, iLength);
+  return (pchFound != nullptr) ? size_t(pchFound - pch) : NULL_POS;
+};
+
+size_t FindLastByte(const c8 *pch, size_t iLength, c8 ch) {
+  size_t i = iLength;
+
+#if _DREAMY_SSE2
+  const __m128i vByte = _mm_set1_epi8(ch);
+
+  while (i >= 16) {
+    i -= 16;
+
+    const u32 iMask = _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_loadu_si128((const __m128i *)(pch + i)), vByte));
+    if (iMask != 0) return i + HighestSetBit(iMask);
+  }
+#endif
+
+  // Remaining bytes
+  while (i > 0) {
+    if (pch[--i] == ch) return i;
+  }
+
+  return NULL_POS;
+};
+
+size_t CountByte(const c8 *pch, size_t iLength, c8 ch) {
+  size_t ct = 0;
+  size_t i = 0;
+
+#if _DREAMY_SSE2
+  const __m128i vByte = _mm_set1_epi8(ch);
+
+  for (; i + 16 <= iLength; i += 16) {
+    ct += CountSetBits(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_loadu_si128((const __m128i *)(pch + i)), vByte)));
+  }
+#endif
+
+  // Remaining bytes
+  for (; i < iLength; ++i) {
+    if (pch[i] == ch) ++ct;
+  }
+
+  return ct;
+};
+
+// Compare all positions directly when there are few of them
+static inline bool FewPositions(size_t ctPositions, size_t m) {
+  return ctPositions * m <= 256;
+};
+
+size_t FindBytes(const c8 *pch, size_t iLength, const c8 *pchFind, size_t iFindLength) {
+  const size_t m = iFindLength;
+
+  if (m == 0) return 0;
+  if (m > iLength) return NULL_POS;
+  if (m == 1) return FindByte(pch, iLength, pchFind[0]);
+
+  size_t i = 0;
+
+#if _DREAMY_SSE2
+  const size_t iFound = FindBytes_SSE2(pch, iLength, pchFind, m, i);
+  if (iFound != NULL_POS) return iFound;
+#endif
+
+  // Remaining positions
+  if (i + m > iLength) return NULL_POS;
+
+  if (FewPositions(iLength - m + 1 - i, m)) {
+    for (; i + m <= iLength; ++i) {
+      if (pch[i] == pchFind[0] && memcmp(pch + i + 1, pchFind + 1, m - 1) == 0) return i;
+    }
+
+    return NULL_POS;
+  }
+
+  const size_t iPos = TwoWaySearch(ForwardBytes(pch + i), iLength - i, ForwardBytes(pchFind), m);
+  return (iPos != NULL_POS) ? i + iPos : NULL_POS;
+};
+
+size_t FindLastBytes(const c8 *pch, size_t iLength, const c8 *pchFind, size_t iFindLength) {
+  const size_t m = iFindLength;
+
+  if (m == 0) return iLength;
+  if (m > iLength) return NULL_POS;
+  if (m == 1) return FindLastByte(pch, iLength, pchFind[0]);
+
+  // Amount of positions that haven't been examined
+  size_t iEnd = iLength - m + 1;
+
+#if _DREAMY_SSE2
+  const size_t iFound = FindLastBytes_SSE2(pch, iLength, pchFind, m, iEnd);
+  if (iFound != NULL_POS) return iFound;
+#endif
+
+  if (iEnd == 0) return NULL_POS;
+
+  if (FewPositions(iEnd, m)) {
+    while (iEnd > 0) {
+      --iEnd;
+      if (pch[iEnd] == pchFind[0] && memcmp(pch + iEnd + 1, pchFind + 1, m - 1) == 0) return iEnd;
+    }
+
+    return NULL_POS;
+  }
+
+  // Search from the end of the remaining bytes
+  const size_t iRegion = iEnd + m - 1;
+  const size_t iPos = TwoWaySearch(BackwardBytes(pch, iRegion), iRegion, BackwardBytes(pchFind, m), m);
+
+  return (iPos != NULL_POS) ? iRegion - iPos - m : NULL_POS;
+};
+
+size_t CountBytes(const c8 *pch, size_t iLength, const c8 *pchFind, size_t iFindLength) {
+  if (iFindLength == 0) return 0;
+  if (iFindLength == 1) return CountByte(pch, iLength, pchFind[0]);
+
+  size_t ct = 0;
+  size_t i = 0;
+
+  while (true) {
+    const size_t iPos = FindBytes(pch + i, iLength - i, pchFind, iFindLength);
+    if (iPos == NULL_POS) break;
+
+    ++ct;
+    i += iPos + iFindLength;
+  }
+
+  return ct;
+};
+
+}; // namespace dreamy
@@ -0,0 +1,33 @@
+//! This file is a part of Dreamy Utilities.
+//! Licensed under the MIT license (see LICENSE file).
+
+#ifndef _DREAMYUTILITIES_INCL_BYTESEARCH_H
+#define _DREAMYUTILITIES_INCL_BYTESEARCH_H
+
+#include "../DreamyUtilitiesBase.hpp"
+
+namespace dreamy {
+
+// Find position of the first occurrence of a byte or return NULL_POS
+size_t FindByte(const c8 *pch, size_t iLength, c8 ch);
+
+// Find position of the last occurrence of a byte or return NULL_POS
+size_t FindLastByte(const c8 *pch, size_t iLength, c8 ch);
+
+// Count occurrences of a byte
+size_t CountByte(const c8 *pch, size_t iLength, c8 ch);
+
+// Find position of the first occurrence of a byte sequence or return NULL_POS
+// Takes linear time in the worst case (an empty sequence is found at the beginning)
+size_t FindBytes(const c8 *pch, size_t iLength, const c8 *pchFind, size_t iFindLength);
+
+// Find position of the last occurrence of a byte sequence or return NULL_POS
+// Takes linear time in the worst case (an empty sequence is found at the end)
+size_t FindLastBytes(const c8 *pch, size_t iLength, const c8 *pchFind, size_t iFindLength);
+
+// Count non-overlapping occurrences of a non-empty byte sequence
+size_t CountBytes(const c8 *pch, size_t iLength, const c8 *pchFind, size_t iFindLength);
+
+}; // namespace dreamy
+
+#endif // (Dreamy Utilities Include Guard)
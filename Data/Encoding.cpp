@@ -0,0 +1,513 @@
+//! This file is a part of Dreamy Utilities.
+//! Licensed under the MIT license (see LICENSE file).
+
+#include "Encoding.hpp"
+#include "SIMD.hpp"
+
+namespace dreamy {
+
+// Encoding kernel that returns amount of processed source bytes
+typedef size_t (*CEncodingKernel)(c8 *pDst, const c8 *pSrc, size_t iLength);
+
+// Kernel that processes nothing and leaves everything to the scalar loop
+static size_t EncodeNone(c8 *, const c8 *, size_t) {
+  return 0;
+};
+
+static const c8 *_strHexDigits = "0123456789ABCDEF";
+static const c8 *_strBase64Digits = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+static const c8 *_strBase85Digits = "0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz!#$%&()*+-;<=>?@^_`{|}~";
+
+// Get value of a hexadecimal digit or 0xFF if it's not one
+static inline u8 HexNibble(c8 ch) {
+  if (ch >= '0' && ch <= '9') return u8(ch - '0');
+  if (ch >= 'A' && ch <= 'F') return u8(ch - 'A' + 10);
+  if (ch >= 'a' && ch <= 'f') return u8(ch - 'a' + 10);
+  return 0xFF;
+};
+
+// Get value of a base64 digit or 0xFF if it's not one
+static inline u8 Base64Value(c8 ch) {
+  if (ch >= 'A' && ch <= 'Z') return u8(ch - 'A');
+  if (ch >= 'a' && ch <= 'z') return u8(ch - 'a' + 26);
+  if (ch >= '0' && ch <= '9') return u8(ch - '0' + 52);
+  if (ch == '+') return 62;
+  if (ch == '/') return 63;
+  return 0xFF;
+};
+
+// Table of base85 digit values (0xFF for invalid characters)
+struct Base85Table {
+  u8 aValues[256];
+
+  Base85Table() {
+    memset(aValues, 0xFF, sizeof(aValues));
+
+    for (u32 i = 0; i < 85; ++i) {
+      aValues[u8(_strBase85Digits[i])] = u8(i);
+    }
+  };
+};
+
+#if _DREAMY_SSE2
+
+// Decode 32 hexadecimal digits at a time until an invalid one
+static size_t DecodeHex_SSE2(c8 *pDst, const c8 *pSrc, size_t iLength) {
+  const __m128i vZero = _mm_set1_epi8('0');
+  const __m128i vLetter = _mm_set1_epi8('a');
+  const __m128i vLowerCase = _mm_set1_epi8(0x20);
+  const __m128i vNine = _mm_set1_epi8(9);
+  const __m128i vFive = _mm_set1_epi8(5);
+  const __m128i vTen = _mm_set1_epi8(10);
+  const __m128i vLowByte = _mm_set1_epi16(0x00FF);
+
+  size_t i = 0;
+
+  for (; i + 32 <= iLength; i += 32) {
+    __m128i avBytes[2];
+
+    for (s32 iHalf = 0; iHalf < 2; ++iHalf) {
+      const __m128i v = _mm_loadu_si128((const __m128i *)(pSrc + i + iHalf * 16));
+
+      // Unsigned range checks for digits and letters of any case
+      const __m128i vDigit = _mm_sub_epi8(v, vZero);
+      const __m128i vAlpha = _mm_sub_epi8(_mm_or_si128(v, vLowerCase), vLetter);
+      const __m128i vIsDigit = _mm_cmpeq_epi8(_mm_min_epu8(vDigit, vNine), vDigit);
+      const __m128i vIsAlpha = _mm_cmpeq_epi8(_mm_min_epu8(vAlpha, vFive), vAlpha);
+
+      if (_mm_movemask_epi8(_mm_or_si128(vIsDigit, vIsAlpha)) != 0xFFFF) return i;
+
+      const __m128i vNibbles = _mm_or_si128(_mm_and_si128(vIsDigit, vDigit), _mm_and_si128(vIsAlpha, _mm_add_epi8(vAlpha, vTen)));
+
+      // Join high nibbles at even positions with low nibbles at odd positions
+      const __m128i vHigh = _mm_slli_epi16(_mm_and_si128(vNibbles, vLowByte), 4);
+      avBytes[iHalf] = _mm_or_si128(vHigh, _mm_srli_epi16(vNibbles, 8));
+    }
+
+    _mm_storeu_si128((__m128i *)(pDst + i / 2), _mm_packus_epi16(avBytes[0], avBytes[1]));
+  }
+
+  return i;
+};
+
+#endif // _DREAMY_SSE2
+
+#if _DREAMY_SIMD_DISPATCH
+
+// Encode 16 bytes at a time as 32 hexadecimal digits
+DREAMY_TARGET_SSSE3
+static size_t EncodeHex_SSSE3(c8 *pDst, const c8 *pSrc, size_t iSize) {
+  const __m128i vDigits = _mm_loadu_si128((const __m128i *)_strHexDigits);
+  const __m128i vNibble = _mm_set1_epi8(0x0F);
+
+  const size_t iVecSize = iSize & ~size_t(15);
+
+  for (size_t i = 0; i < iVecSize; i += 16) {
+    const __m128i v = _mm_loadu_si128((const __m128i *)(pSrc + i));
+
+    const __m128i vHigh = _mm_shuffle_epi8(vDigits, _mm_and_si128(_mm_srli_epi16(v, 4), vNibble));
+    const __m128i vLow = _mm_shuffle_epi8(vDigits, _mm_and_si128(v, vNibble));
+
+    _mm_storeu_si128((__m128i *)(pDst + i * 2), _mm_unpacklo_epi8(vHigh, vLow));
+    _mm_storeu_si128((__m128i *)(pDst + i * 2 + 16), _mm_unpackhi_epi8(vHigh, vLow));
+  }
+
+  return iVecSize;
+};
+
+// Encode 32 bytes at a time as 64 hexadecimal digits
+DREAMY_TARGET_AVX2
+static size_t EncodeHex_AVX2(c8 *pDst, const c8 *pSrc, size_t iSize) {
+  const __m256i vDigits = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i *)_strHexDigits));
+  const __m256i vNibble = _mm256_set1_epi8(0x0F);
+
+  const size_t iVecSize = iSize & ~size_t(31);
+
+  for (size_t i = 0; i < iVecSize; i += 32) {
+    const __m256i v = _mm256_loadu_si256((const __m256i *)(pSrc + i));
+
+    const __m256i vHigh = _mm256_shuffle_epi8(vDigits, _mm256_and_si256(_mm256_srli_epi16(v, 4), vNibble));
+    const __m256i vLow = _mm256_shuffle_epi8(vDigits, _mm256_and_si256(v, vNibble));
+
+    // Interleaving happens within 128-bit lanes, so put the lanes back in order
+    const __m256i vFirst = _mm256_unpacklo_epi8(vHigh, vLow);
+    const __m256i vSecond = _mm256_unpackhi_epi8(vHigh, vLow);
+
+    _mm256_storeu_si256((__m256i *)(pDst + i * 2), _mm256_permute2x128_si256(vFirst, vSecond, 0x20));
+    _mm256_storeu_si256((__m256i *)(pDst + i * 2 + 32), _mm256_permute2x128_si256(vFirst, vSecond, 0x31));
+  }
+
+  return iVecSize;
+};
+
+// Encode 12 bytes at a time as 16 base64 characters (reads 16 bytes)
+DREAMY_TARGET_SSSE3
+static size_t EncodeBase64_SSSE3(c8 *pDst, const c8 *pSrc, size_t iSize) {
+  // Spread every 3 bytes over 4 bytes, take 6 bits for each and turn them into characters via offsets
+  const __m128i vSpread = _mm_set_epi8(10, 11, 9, 10, 7, 8, 6, 7, 4, 5, 3, 4, 1, 2, 0, 1);
+  const __m128i vOffsets = _mm_setr_epi8('a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+    '0' - 52, '0' - 52, '0' - 52, '0' - 52, '+' - 62, '/' - 63, 'A', 0, 0);
+
+  size_t i = 0;
+  c8 *pch = pDst;
+
+  for (; i + 16 <= iSize; i += 12, pch += 16) {
+    const __m128i v = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)(pSrc + i)), vSpread);
+
+    const __m128i vHigh = _mm_mulhi_epu16(_mm_and_si128(v, _mm_set1_epi32(0x0FC0FC00)), _mm_set1_epi32(0x04000040));
+    const __m128i vLow = _mm_mullo_epi16(_mm_and_si128(v, _mm_set1_epi32(0x003F03F0)), _mm_set1_epi32(0x01000010));
+    const __m128i vIndices = _mm_or_si128(vHigh, vLow);
+
+    // Select offset for each range of indices
+    __m128i vRange = _mm_subs_epu8(vIndices, _mm_set1_epi8(51));
+    const __m128i vUpper = _mm_cmpgt_epi8(_mm_set1_epi8(26), vIndices);
+    vRange = _mm_or_si128(vRange, _mm_and_si128(vUpper, _mm_set1_epi8(13)));
+
+    _mm_storeu_si128((__m128i *)pch, _mm_add_epi8(vIndices, _mm_shuffle_epi8(vOffsets, vRange)));
+  }
+
+  return i;
+};
+
+// Encode 24 bytes at a time as 32 base64 characters (reads 28 bytes)
+DREAMY_TARGET_AVX2
+static size_t EncodeBase64_AVX2(c8 *pDst, const c8 *pSrc, size_t iSize) {
+  const __m256i vSpread = _mm256_broadcastsi128_si256(_mm_set_epi8(10, 11, 9, 10, 7, 8, 6, 7, 4, 5, 3, 4, 1, 2, 0, 1));
+  const __m256i vOffsets = _mm256_broadcastsi128_si256(_mm_setr_epi8('a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+    '0' - 52, '0' - 52, '0' - 52, '0' - 52, '+' - 62, '/' - 63, 'A', 0, 0));
+
+  size_t i = 0;
+  c8 *pch = pDst;
+
+  for (; i + 28 <= iSize; i += 24, pch += 32) {
+    // Each lane gets its own 12 bytes
+    const __m128i vFirst = _mm_loadu_si128((const __m128i *)(pSrc + i));
+    const __m128i vSecond = _mm_loadu_si128((const __m128i *)(pSrc + i + 12));
+
+    __m256i v = _mm256_inserti128_si256(_mm256_castsi128_si256(vFirst), vSecond, 1);
+    v = _mm256_shuffle_epi8(v, vSpread);
+
+    const __m256i vHigh = _mm256_mulhi_epu16(_mm256_and_si256(v, _mm256_set1_epi32(0x0FC0FC00)), _mm256_set1_epi32(0x04000040));
+    const __m256i vLow = _mm256_mullo_epi16(_mm256_and_si256(v, _mm256_set1_epi32(0x003F03F0)), _mm256_set1_epi32(0x01000010));
+    const __m256i vIndices = _mm256_or_si256(vHigh, vLow);
+
+    __m256i vRange = _mm256_subs_epu8(vIndices, _mm256_set1_epi8(51));
+    const __m256i vUpper = _mm256_cmpgt_epi8(_mm256_set1_epi8(26), vIndices);
+    vRange = _mm256_or_si256(vRange, _mm256_and_si256(vUpper, _mm256_set1_epi8(13)));
+
+    _mm256_storeu_si256((__m256i *)pch, _mm256_add_epi8(vIndices, _mm256_shuffle_epi8(vOffsets, vRange)));
+  }
+
+  return i;
+};
+
+// Decode 16 base64 characters at a time into 12 bytes until an invalid character (writes 16 bytes)
+DREAMY_TARGET_SSSE3
+static size_t DecodeBase64_SSSE3(c8 *pDst, const c8 *pSrc, size_t iLength) {
+  // Characters are valid if their nibbles don't share any bits in these tables
+  const __m128i vLowBits = _mm_setr_epi8(0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A);
+  const __m128i vHighBits = _mm_setr_epi8(0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10);
+  const __m128i vOffsets = _mm_setr_epi8(0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0);
+  const __m128i vPack = _mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1);
+  const __m128i vSlash = _mm_set1_epi8(0x2F);
+  const __m128i vZero = _mm_setzero_si128();
+
+  size_t i = 0;
+  c8 *pch = pDst;
+
+  // Leave the last group with padding and enough space for the extra bytes
+  for (; i + 24 <= iLength; i += 16, pch += 12) {
+    const __m128i v = _mm_loadu_si128((const __m128i *)(pSrc + i));
+    const __m128i vHigh = _mm_and_si128(_mm_srli_epi32(v, 4), vSlash);
+
+    const __m128i vCheck = _mm_and_si128(_mm_shuffle_epi8(vLowBits, _mm_and_si128(v, vSlash)), _mm_shuffle_epi8(vHighBits, vHigh));
+    if (_mm_movemask_epi8(_mm_cmpeq_epi8(vCheck, vZero)) != 0xFFFF) break;
+
+    // Turn characters into 6-bit values and join them into bytes
+    const __m128i vShift = _mm_shuffle_epi8(vOffsets, _mm_add_epi8(_mm_cmpeq_epi8(v, vSlash), vHigh));
+    const __m128i vValues = _mm_add_epi8(v, vShift);
+
+    const __m128i vPairs = _mm_maddubs_epi16(vValues, _mm_set1_epi32(0x01400140));
+    const __m128i vGroups = _mm_madd_epi16(vPairs, _mm_set1_epi32(0x00011000));
+
+    _mm_storeu_si128((__m128i *)pch, _mm_shuffle_epi8(vGroups, vPack));
+  }
+
+  return i;
+};
+
+// Decode 32 base64 characters at a time into 24 bytes until an invalid character (writes 28 bytes)
+DREAMY_TARGET_AVX2
+static size_t DecodeBase64_AVX2(c8 *pDst, const c8 *pSrc, size_t iLength) {
+  const __m256i vLowBits = _mm256_broadcastsi128_si256(_mm_setr_epi8(0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A));
+  const __m256i vHighBits = _mm256_broadcastsi128_si256(_mm_setr_epi8(0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10));
+  const __m256i vOffsets = _mm256_broadcastsi128_si256(_mm_setr_epi8(0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0));
+  const __m256i vPack = _mm256_broadcastsi128_si256(_mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1));
+  const __m256i vSlash = _mm256_set1_epi8(0x2F);
+  const __m256i vZero = _mm256_setzero_si256();
+
+  size_t i = 0;
+  c8 *pch = pDst;
+
+  for (; i + 40 <= iLength; i += 32, pch += 24) {
+    const __m256i v = _mm256_loadu_si256((const __m256i *)(pSrc + i));
+    const __m256i vHigh = _mm256_and_si256(_mm256_srli_epi32(v, 4), vSlash);
+
+    const __m256i vCheck = _mm256_and_si256(_mm256_shuffle_epi8(vLowBits, _mm256_and_si256(v, vSlash)), _mm256_shuffle_epi8(vHighBits, vHigh));
+    if (u32(_mm256_movemask_epi8(_mm256_cmpeq_epi8(vCheck, vZero))) != 0xFFFFFFFF) break;
+
+    const __m256i vShift = _mm256_shuffle_epi8(vOffsets, _mm256_add_epi8(_mm256_cmpeq_epi8(v, vSlash), vHigh));
+    const __m256i vValues = _mm256_add_epi8(v, vShift);
+
+    const __m256i vPairs = _mm256_maddubs_epi16(vValues, _mm256_set1_epi32(0x01400140));
+    const __m256i vGroups = _mm256_shuffle_epi8(_mm256_madd_epi16(vPairs, _mm256_set1_epi32(0x00011000)), vPack);
+
+    // Second lane overwrites unused bytes of the first one
+    _mm_storeu_si128((__m128i *)pch, _mm256_castsi256_si128(vGroups));
+    _mm_storeu_si128((__m128i *)(pch + 12), _mm256_extracti128_si256(vGroups, 1));
+  }
+
+  return i;
+};
+
+#endif // _DREAMY_SIMD_DISPATCH
+
+// Pick the fastest hex encoder supported by the processor
+static CEncodingKernel SelectEncodeHex(void) {
+#if _DREAMY_SIMD_DISPATCH
+  if (cpu::HasAVX2()) return &EncodeHex_AVX2;
+  if (cpu::HasSSSE3()) return &EncodeHex_SSSE3;
+#endif
+
+  return &EncodeNone;
+};
+
+// Pick the fastest hex decoder supported by the processor
+static CEncodingKernel SelectDecodeHex(void) {
+#if _DREAMY_SSE2
+  return &DecodeHex_SSE2;
+#else
+  return &EncodeNone;
+#endif
+};
+
+// Pick the fastest base64 encoder supported by the processor
+static CEncodingKernel SelectEncodeBase64(void) {
+#if _DREAMY_SIMD_DISPATCH
+  if (cpu::HasAVX2()) return &EncodeBase64_AVX2;
+  if (cpu::HasSSSE3()) return &EncodeBase64_SSSE3;
+#endif
+
+  return &EncodeNone;
+};
+
+// Pick the fastest base64 decoder supported by the processor
+static CEncodingKernel SelectDecodeBase64(void) {
+#if _DREAMY_SIMD_DISPATCH
+  if (cpu::HasAVX2()) return &DecodeBase64_AVX2;
+  if (cpu::HasSSSE3()) return &DecodeBase64_SSSE3;
+#endif
+
+  return &EncodeNone;
+};
+
+void EncodeHex(c8 *pDst, const c8 *pSrc, size_t iSize) {
+  static const CEncodingKernel pKernel = SelectEncodeHex();
+
+  // Vectorized bulk and the remaining tail
+  for (size_t i = pKernel(pDst, pSrc, iSize); i < iSize; ++i) {
+    const u8 iByte = u8(pSrc[i]);
+    pDst[i * 2 + 0] = _strHexDigits[iByte >> 4];
+    pDst[i * 2 + 1] = _strHexDigits[iByte & 0x0F];
+  }
+};
+
+size_t DecodeHex(c8 *pDst, const c8 *pSrc, size_t iLength) {
+  static const CEncodingKernel pKernel = SelectDecodeHex();
+
+  if (iLength % 2 != 0) return NULL_POS;
+
+  for (size_t i = pKernel(pDst, pSrc, iLength); i < iLength; i += 2) {
+    const u8 iHigh = HexNibble(pSrc[i]);
+    const u8 iLow = HexNibble(pSrc[i + 1]);
+
+    if ((iHigh | iLow) == 0xFF) return NULL_POS;
+
+    pDst[i / 2] = c8((iHigh << 4) | iLow);
+  }
+
+  return iLength / 2;
+};
+
+void EncodeBase64(c8 *pDst, const c8 *pSrc, size_t iSize) {
+  static const CEncodingKernel pKernel = SelectEncodeBase64();
+
+  size_t i = pKernel(pDst, pSrc, iSize);
+  c8 *pch = pDst + i / 3 * 4;
+
+  // Complete groups
+  for (; i + 3 <= iSize; i += 3) {
+    const u32 iGroup = (u32(u8(pSrc[i])) << 16) | (u32(u8(pSrc[i + 1])) << 8) | u32(u8(pSrc[i + 2]));
+
+    *pch++ = _strBase64Digits[(iGroup >> 18) & 63];
+    *pch++ = _strBase64Digits[(iGroup >> 12) & 63];
+    *pch++ = _strBase64Digits[(iGroup >> 6) & 63];
+    *pch++ = _strBase64Digits[iGroup & 63];
+  }
+
+  // Padded group
+  const size_t iRest = iSize - i;
+  if (iRest == 0) return;
+
+  u32 iGroup = u32(u8(pSrc[i])) << 16;
+  if (iRest == 2) iGroup |= u32(u8(pSrc[i + 1])) << 8;
+
+  *pch++ = _strBase64Digits[(iGroup >> 18) & 63];
+  *pch++ = _strBase64Digits[(iGroup >> 12) & 63];
+  *pch++ = (iRest == 2) ? _strBase64Digits[(iGroup >> 6) & 63] : '=';
+  *pch++ = '=';
+};
+
+size_t DecodeBase64(c8 *pDst, const c8 *pSrc, size_t iLength) {
+  static const CEncodingKernel pKernel = SelectDecodeBase64();
+
+  if (iLength % 4 != 0) return NULL_POS;
+  if (iLength == 0) return 0;
+
+  // Amount of padding characters at the end
+  size_t ctPadding = 0;
+  if (pSrc[iLength - 1] == '=') ++ctPadding;
+  if (pSrc[iLength - 2] == '=') ++ctPadding;
+
+  size_t i = pKernel(pDst, pSrc, iLength);
+  c8 *pch = pDst + i / 4 * 3;
+
+  for (; i < iLength; i += 4) {
+    const bool bLast = (i + 4 == iLength);
+    const size_t ctDigits = bLast ? 4 - ctPadding : 4;
+
+    u32 iGroup = 0;
+
+    for (size_t iDigit = 0; iDigit < 4; ++iDigit) {
+      u8 iValue = 0;
+
+      if (iDigit < ctDigits) {
+        iValue = Base64Value(pSrc[i + iDigit]);
+        if (iValue == 0xFF) return NULL_POS;
+      }
+
+      iGroup = (iGroup << 6) | iValue;
+    }
+
+    *pch++ = c8(iGroup >> 16);
+    if (ctDigits > 2) *pch++ = c8(iGroup >> 8);
+    if (ctDigits > 3) *pch++ = c8(iGroup);
+  }
+
+  return size_t(pch - pDst);
+};
+
+void EncodeBase85(c8 *pDst, const c8 *pSrc, size_t iSize) {
+  c8 *pch = pDst;
+
+  for (size_t i = 0; i < iSize; i += 4) {
+    const size_t ctBytes = (iSize - i < 4) ? iSize - i : 4;
+
+    // Big-endian group padded with zeros
+    u32 iGroup = 0;
+
+    for (size_t iByte = 0; iByte < 4; ++iByte) {
+      iGroup = (iGroup << 8) | (iByte < ctBytes ? u8(pSrc[i + iByte]) : 0);
+    }
+
+    c8 strDigits[5];
+
+    for (s32 iDigit = 4; iDigit >= 0; --iDigit) {
+      strDigits[iDigit] = _strBase85Digits[iGroup % 85];
+      iGroup /= 85;
+    }
+
+    // Partial group only needs one digit more than bytes
+    const size_t ctDigits = ctBytes + 1;
+    memcpy(pch, strDigits, ctDigits);
+    pch += ctDigits;
+  }
+};
+
+size_t DecodeBase85(c8 *pDst, const c8 *pSrc, size_t iLength) {
+  static const Base85Table table;
+
+  if (iLength % 5 == 1) return NULL_POS;
+
+  c8 *pch = pDst;
+
+  for (size_t i = 0; i < iLength; i += 5) {
+    const size_t ctDigits = (iLength - i < 5) ? iLength - i : 5;
+
+    // Partial group is padded with the highest digit
+    u64 iGroup = 0;
+
+    for (size_t iDigit = 0; iDigit < 5; ++iDigit) {
+      u8 iValue = 84;
+
+      if (iDigit < ctDigits) {
+        iValue = table.aValues[u8(pSrc[i + iDigit])];
+        if (iValue == 0xFF) return NULL_POS;
+      }
+
+      iGroup = iGroup * 85 + iValue;
+    }
+
+    if (iGroup > 0xFFFFFFFF) return NULL_POS;
+
+    const size_t ctBytes = ctDigits - 1;
+
+    for (size_t iByte = 0; iByte < ctBytes; ++iByte) {
+      *pch++ = c8(iGroup >> (24 - iByte * 8));
+    }
+  }
+
+  return size_t(pch - pDst);
+};
+
+// Encode bytes in pieces through a small buffer and write them into a device or a stream
+// Each piece should be a multiple of the group size
+template<class Writer> static
+size_t WriteEncoded(Writer &out, const c8 *pSrc, size_t iSize, size_t iPiece,
+  void (*pEncode)(c8 *, const c8 *, size_t), size_t (*pEncodedLength)(size_t))
+{
+  c8 aBuffer[4096];
+  size_t ctWritten = 0;
+
+  for (size_t i = 0; i < iSize; i += iPiece) {
+    const size_t ctBytes = (iSize - i < iPiece) ? iSize - i : iPiece;
+    const size_t ctChars = pEncodedLength(ctBytes);
+
+    pEncode(aBuffer, pSrc + i, ctBytes);
+
+    const size_t iWritten = out.Write(aBuffer, ctChars);
+    if (iWritten == NULL_POS) break;
+
+    ctWritten += iWritten;
+    if (iWritten != ctChars) break;
+  }
+
+  return ctWritten;
+};
+
+// Define hex, base64 and base85 writers for a device and a stream
+#define DEFINE_ENCODED_WRITER(_Name, _Piece) \
+  size_t Write##_Name(IReadWriteDevice &d, const c8 *pSrc, size_t iSize) { \
+    return WriteEncoded(d, pSrc, iSize, _Piece, &Encode##_Name, &_Name##EncodedLength); \
+  }; \
+  size_t Write##_Name(CDataStream &strm, const c8 *pSrc, size_t iSize) { \
+    return WriteEncoded(strm, pSrc, iSize, _Piece, &Encode##_Name, &_Name##EncodedLength); \
+  };
+
+DEFINE_ENCODED_WRITER(Hex, 2048);
+DEFINE_ENCODED_WRITER(Base64, 3072);
+DEFINE_ENCODED_WRITER(Base85, 3072);
+
+#undef DEFINE_ENCODED_WRITER
+
+}; // namespace dreamy
@@ -0,0 +1,88 @@
+//! This file is a part of Dreamy Utilities.
+//! Licensed under the MIT license (see LICENSE file).
+
+#ifndef _DREAMYUTILITIES_INCL_ENCODING_H
+#define _DREAMYUTILITIES_INCL_ENCODING_H
+
+#include "../DreamyUtilitiesBase.hpp"
+
+#include "../IO/DataStream.hpp"
+#include "../IO/ReadWriteDevice.hpp"
+
+namespace dreamy {
+
+// Get amount of hexadecimal digits for an amount of bytes
+inline size_t HexEncodedLength(size_t iSize) {
+  return iSize * 2;
+};
+
+// Get amount of bytes that are encoded in hexadecimal digits
+inline size_t HexDecodedLength(size_t iLength) {
+  return iLength / 2;
+};
+
+// Encode bytes as uppercase hexadecimal digits
+void EncodeHex(c8 *pDst, const c8 *pSrc, size_t iSize);
+
+// Decode hexadecimal digits of any case and return amount of decoded bytes
+// Returns NULL_POS if there's an odd amount of digits or any other character
+size_t DecodeHex(c8 *pDst, const c8 *pSrc, size_t iLength);
+
+// Get amount of characters for an amount of bytes in base64 (with padding)
+inline size_t Base64EncodedLength(size_t iSize) {
+  return (iSize + 2) / 3 * 4;
+};
+
+// Get maximum amount of bytes that are encoded in base64 characters
+inline size_t Base64DecodedLength(size_t iLength) {
+  return iLength / 4 * 3;
+};
+
+// Encode bytes in base64 using the standard alphabet with padding (RFC 4648)
+void EncodeBase64(c8 *pDst, const c8 *pSrc, size_t iSize);
+
+// Decode padded base64 text and return amount of decoded bytes
+// Returns NULL_POS if the text isn't made of complete groups of valid characters with padding only at the end
+size_t DecodeBase64(c8 *pDst, const c8 *pSrc, size_t iLength);
+
+// Get amount of characters for an amount of bytes in base85
+inline size_t Base85EncodedLength(size_t iSize) {
+  const size_t iRest = iSize % 4;
+  return iSize / 4 * 5 + (iRest != 0 ? iRest + 1 : 0);
+};
+
+// Get amount of bytes that are encoded in base85 characters
+inline size_t Base85DecodedLength(size_t iLength) {
+  const size_t iRest = iLength % 5;
+  return iLength / 5 * 4 + (iRest > 1 ? iRest - 1 : 0);
+};
+
+// Encode bytes in base85 using the RFC 1924 alphabet without padding
+// Every 4 bytes become 5 characters and a partial group of N bytes becomes N + 1 characters
+void EncodeBase85(c8 *pDst, const c8 *pSrc, size_t iSize);
+
+// Decode base85 text and return amount of decoded bytes
+// Returns NULL_POS if there are invalid characters, a group overflows or the last group is a single character
+size_t DecodeBase85(c8 *pDst, const c8 *pSrc, size_t iLength);
+
+// Encode bytes as hexadecimal digits straight into a device and return amount of written characters
+size_t WriteHex(IReadWriteDevice &d, const c8 *pSrc, size_t iSize);
+
+// Encode bytes as hexadecimal digits straight into a stream and return amount of written characters
+size_t WriteHex(CDataStream &strm, const c8 *pSrc, size_t iSize);
+
+// Encode bytes in base64 straight into a device and return amount of written characters
+size_t WriteBase64(IReadWriteDevice &d, const c8 *pSrc, size_t iSize);
+
+// Encode bytes in base64 straight into a stream and return amount of written characters
+size_t WriteBase64(CDataStream &strm, const c8 *pSrc, size_t iSize);
+
+// Encode bytes in base85 straight into a device and return amount of written characters
+size_t WriteBase85(IReadWriteDevice &d, const c8 *pSrc, size_t iSize);
+
+// Encode bytes in base85 straight into a stream and return amount of written characters
+size_t WriteBase85(CDataStream &strm, const c8 *pSrc, size_t iSize);
+
+}; // namespace dreamy
+
+#endif // (Dreamy Utilities Include Guard)
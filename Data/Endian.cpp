@@ -2,198 +2,223 @@
 //! Licensed under the MIT license (see LICENSE file).
 
 #include "Endian.hpp"
-#include "Memory.hpp"
+#include "SIMD.hpp"
 
 namespace dreamy {
 
-namespace endian {
+// Array byte-swapping kernel that returns amount of processed values
+typedef size_t (*CByteSwapKernel)(void *pDst, const void *pSrc, size_t ct);
 
-u16 ToLittle(u16 iSrc)
-{
-  #if _DREAMY_BYTE_ORDER == _DREAMY_LITTLE_ENDIAN
-    return iSrc;
-  #else
-    return ByteSwap16(iSrc);
-  #endif
-};
+#if _DREAMY_SSE2
 
-u32 ToLittle(u32 iSrc)
-{
-  #if _DREAMY_BYTE_ORDER == _DREAMY_LITTLE_ENDIAN
-    return iSrc;
-  #else
-    return ByteSwap32(iSrc);
-  #endif
+// Swap bytes within 16-bit lanes
+static inline __m128i SwapLanes16_SSE2(__m128i v) {
+  return _mm_or_si128(_mm_slli_epi16(v, 8), _mm_srli_epi16(v, 8));
 };
 
-u64 ToLittle(u64 iSrc)
-{
-  #if _DREAMY_BYTE_ORDER == _DREAMY_LITTLE_ENDIAN
-    return iSrc;
-  #else
-    return ByteSwap64(iSrc);
-  #endif
+static size_t Swap16_SSE2(void *pDst, const void *pSrc, size_t ct) {
+  const size_t ctVec = ct & ~size_t(7);
+
+  for (size_t i = 0; i < ctVec; i += 8) {
+    __m128i v = _mm_loadu_si128((const __m128i *)((const u16 *)pSrc + i));
+    _mm_storeu_si128((__m128i *)((u16 *)pDst + i), SwapLanes16_SSE2(v));
+  }
+
+  return ctVec;
 };
 
-s16 ToLittle(s16 iSrc)
-{
-  #if _DREAMY_BYTE_ORDER == _DREAMY_LITTLE_ENDIAN
-    return iSrc;
-  #else
-    return ByteSwap16(iSrc);
-  #endif
+static size_t Swap32_SSE2(void *pDst, const void *pSrc, size_t ct) {
+  const size_t ctVec = ct & ~size_t(3);
+
+  for (size_t i = 0; i < ctVec; i += 4) {
+    __m128i v = _mm_loadu_si128((const __m128i *)((const u32 *)pSrc + i));
+
+    // Swap 16-bit halves, then bytes within them
+    v = _mm_shufflelo_epi16(v, _MM_SHUFFLE(2, 3, 0, 1));
+    v = _mm_shufflehi_epi16(v, _MM_SHUFFLE(2, 3, 0, 1));
+    _mm_storeu_si128((__m128i *)((u32 *)pDst + i), SwapLanes16_SSE2(v));
+  }
+
+  return ctVec;
 };
 
-s32 ToLittle(s32 iSrc)
-{
-  #if _DREAMY_BYTE_ORDER == _DREAMY_LITTLE_ENDIAN
-    return iSrc;
-  #else
-    return ByteSwap32(iSrc);
-  #endif
+static size_t Swap64_SSE2(void *pDst, const void *pSrc, size_t ct) {
+  const size_t ctVec = ct & ~size_t(1);
+
+  for (size_t i = 0; i < ctVec; i += 2) {
+    __m128i v = _mm_loadu_si128((const __m128i *)((const u64 *)pSrc + i));
+
+    // Reverse 16-bit quarters, then bytes within them
+    v = _mm_shufflelo_epi16(v, _MM_SHUFFLE(0, 1, 2, 3));
+    v = _mm_shufflehi_epi16(v, _MM_SHUFFLE(0, 1, 2, 3));
+    _mm_storeu_si128((__m128i *)((u64 *)pDst + i), SwapLanes16_SSE2(v));
+  }
+
+  return ctVec;
 };
 
-s64 ToLittle(s64 iSrc)
-{
-  #if _DREAMY_BYTE_ORDER == _DREAMY_LITTLE_ENDIAN
-    return iSrc;
-  #else
-    return ByteSwap64(iSrc);
-  #endif
+#endif // _DREAMY_SSE2
+
+#if _DREAMY_SIMD_DISPATCH
+
+// Byte shuffle masks for each value size
+static const c8 _aShuffle16[16] = { 1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14 };
+static const c8 _aShuffle32[16] = { 3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12 };
+static const c8 _aShuffle64[16] = { 7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8 };
+
+// Swap bytes in 16-byte blocks using a shuffle mask
+DREAMY_TARGET_SSSE3
+static size_t SwapBlocks_SSSE3(void *pDst, const void *pSrc, size_t iBytes, const c8 *pMask) {
+  const __m128i vMask = _mm_loadu_si128((const __m128i *)pMask);
+  const size_t iVecBytes = iBytes & ~size_t(15);
+
+  for (size_t i = 0; i < iVecBytes; i += 16) {
+    __m128i v = _mm_loadu_si128((const __m128i *)((const u8 *)pSrc + i));
+    _mm_storeu_si128((__m128i *)((u8 *)pDst + i), _mm_shuffle_epi8(v, vMask));
+  }
+
+  return iVecBytes;
 };
 
-f32 ToLittle(f32 fSrc)
-{
-  #if _DREAMY_BYTE_ORDER == _DREAMY_LITTLE_ENDIAN
-    return fSrc;
-  #else
-    u32 *piSrc = reinterpret_cast<u32 *>(&fSrc);
-    *piSrc = ByteSwap32(*piSrc);
-    return fSrc;
-  #endif
+// Swap bytes in 32-byte blocks using a shuffle mask
+DREAMY_TARGET_AVX2
+static size_t SwapBlocks_AVX2(void *pDst, const void *pSrc, size_t iBytes, const c8 *pMask) {
+  const __m128i vHalf = _mm_loadu_si128((const __m128i *)pMask);
+  const __m256i vMask = _mm256_broadcastsi128_si256(vHalf);
+  const size_t iVecBytes = iBytes & ~size_t(31);
+
+  for (size_t i = 0; i < iVecBytes; i += 32) {
+    __m256i v = _mm256_loadu_si256((const __m256i *)((const u8 *)pSrc + i));
+    _mm256_storeu_si256((__m256i *)((u8 *)pDst + i), _mm256_shuffle_epi8(v, vMask));
+  }
+
+  return iVecBytes;
 };
 
-f64 ToLittle(f64 fSrc)
-{
-  #if _DREAMY_BYTE_ORDER == _DREAMY_LITTLE_ENDIAN
-    return fSrc;
-  #else
-    u64 *piSrc = reinterpret_cast<u64 *>(&fSrc);
-    *piSrc = ByteSwap64(*piSrc);
-    return fSrc;
-  #endif
+static size_t Swap16_SSSE3(void *pDst, const void *pSrc, size_t ct) { return SwapBlocks_SSSE3(pDst, pSrc, ct * 2, _aShuffle16) / 2; };
+static size_t Swap32_SSSE3(void *pDst, const void *pSrc, size_t ct) { return SwapBlocks_SSSE3(pDst, pSrc, ct * 4, _aShuffle32) / 4; };
+static size_t Swap64_SSSE3(void *pDst, const void *pSrc, size_t ct) { return SwapBlocks_SSSE3(pDst, pSrc, ct * 8, _aShuffle64) / 8; };
+
+static size_t Swap16_AVX2(void *pDst, const void *pSrc, size_t ct) { return SwapBlocks_AVX2(pDst, pSrc, ct * 2, _aShuffle16) / 2; };
+static size_t Swap32_AVX2(void *pDst, const void *pSrc, size_t ct) { return SwapBlocks_AVX2(pDst, pSrc, ct * 4, _aShuffle32) / 4; };
+static size_t Swap64_AVX2(void *pDst, const void *pSrc, size_t ct) { return SwapBlocks_AVX2(pDst, pSrc, ct * 8, _aShuffle64) / 8; };
+
+#endif // _DREAMY_SIMD_DISPATCH
+
+// Kernel that processes nothing and leaves everything to the scalar loop
+static size_t SwapNone(void *, const void *, size_t) {
+  return 0;
 };
 
-#if _DREAMY_UNIX
-
-size_t ToLittle(size_t iSrc)
-{
-  #if _DREAMY_BYTE_ORDER == _DREAMY_LITTLE_ENDIAN
-    return iSrc;
-  #else
-    if (sizeof(size_t) == 8) {
-      return ByteSwap64((u64)iSrc);
-    } else {
-      return ByteSwap32((u32)iSrc);
+// Pick the fastest kernel supported by the processor
+static CByteSwapKernel SelectKernel(size_t iValueSize) {
+#if _DREAMY_SIMD_DISPATCH
+  if (cpu::HasAVX2()) {
+    switch (iValueSize) {
+      case 2: return &Swap16_AVX2;
+      case 4: return &Swap32_AVX2;
+      case 8: return &Swap64_AVX2;
     }
-  #endif
-};
+  }
 
+  if (cpu::HasSSSE3()) {
+    switch (iValueSize) {
+      case 2: return &Swap16_SSSE3;
+      case 4: return &Swap32_SSSE3;
+      case 8: return &Swap64_SSSE3;
+    }
+  }
 #endif
 
-u16 ToBig(u16 iSrc)
-{
-  #if _DREAMY_BYTE_ORDER == _DREAMY_BIG_ENDIAN
-    return iSrc;
-  #else
-    return ByteSwap16(iSrc);
-  #endif
-};
+#if _DREAMY_SSE2
+  switch (iValueSize) {
+    case 2: return &Swap16_SSE2;
+    case 4: return &Swap32_SSE2;
+    case 8: return &Swap64_SSE2;
+  }
+#endif
 
-u32 ToBig(u32 iSrc)
-{
-  #if _DREAMY_BYTE_ORDER == _DREAMY_BIG_ENDIAN
-    return iSrc;
-  #else
-    return ByteSwap32(iSrc);
-  #endif
+  (void)iValueSize;
+  return &SwapNone;
 };
 
-u64 ToBig(u64 iSrc)
-{
-  #if _DREAMY_BYTE_ORDER == _DREAMY_BIG_ENDIAN
-    return iSrc;
-  #else
-    return ByteSwap64(iSrc);
-  #endif
-};
+void ByteSwapArray16(u16 *aDst, const u16 *aSrc, size_t ct) {
+  static const CByteSwapKernel pKernel = SelectKernel(2);
 
-s16 ToBig(s16 iSrc)
-{
-  #if _DREAMY_BYTE_ORDER == _DREAMY_BIG_ENDIAN
-    return iSrc;
-  #else
-    return ByteSwap16(iSrc);
-  #endif
+  // Vectorized bulk and the remaining tail
+  for (size_t i = pKernel(aDst, aSrc, ct); i < ct; ++i) {
+    aDst[i] = ByteSwap16(aSrc[i]);
+  }
 };
 
-s32 ToBig(s32 iSrc)
-{
-  #if _DREAMY_BYTE_ORDER == _DREAMY_BIG_ENDIAN
-    return iSrc;
-  #else
-    return ByteSwap32(iSrc);
-  #endif
-};
+void ByteSwapArray32(u32 *aDst, const u32 *aSrc, size_t ct) {
+  static const CByteSwapKernel pKernel = SelectKernel(4);
 
-s64 ToBig(s64 iSrc)
-{
-  #if _DREAMY_BYTE_ORDER == _DREAMY_BIG_ENDIAN
-    return iSrc;
-  #else
-    return ByteSwap64(iSrc);
-  #endif
+  // Vectorized bulk and the remaining tail
+  for (size_t i = pKernel(aDst, aSrc, ct); i < ct; ++i) {
+    aDst[i] = ByteSwap32(aSrc[i]);
+  }
 };
 
-f32 ToBig(f32 fSrc)
-{
-  #if _DREAMY_BYTE_ORDER == _DREAMY_BIG_ENDIAN
-    return fSrc;
-  #else
-    u32 *piSrc = reinterpret_cast<u32 *>(&fSrc);
-    *piSrc = ByteSwap32(*piSrc);
-    return fSrc;
-  #endif
-};
+void ByteSwapArray64(u64 *aDst, const u64 *aSrc, size_t ct) {
+  static const CByteSwapKernel pKernel = SelectKernel(8);
 
-f64 ToBig(f64 fSrc)
-{
-  #if _DREAMY_BYTE_ORDER == _DREAMY_BIG_ENDIAN
-    return fSrc;
-  #else
-    u64 *piSrc = reinterpret_cast<u64 *>(&fSrc);
-    *piSrc = ByteSwap64(*piSrc);
-    return fSrc;
-  #endif
+  // Vectorized bulk and the remaining tail
+  for (size_t i = pKernel(aDst, aSrc, ct); i < ct; ++i) {
+    aDst[i] = ByteSwap64(aSrc[i]);
+  }
 };
 
-#if _DREAMY_UNIX
-
-size_t ToBig(size_t iSrc)
-{
-  #if _DREAMY_BYTE_ORDER == _DREAMY_BIG_ENDIAN
-    return iSrc;
-  #else
-    if (sizeof(size_t) == 8) {
-      return ByteSwap64((u64)iSrc);
-    } else {
-      return ByteSwap32((u32)iSrc);
-    }
-  #endif
-};
+namespace endian {
 
+// Define array converters that keep the platform byte order
+#define ENDIAN_NATIVE_ARRAY(_Func, _Type) \
+  void _Func(_Type *aValues, size_t ct) { \
+    (void)aValues; (void)ct; \
+  }; \
+  void _Func(_Type *aDst, const _Type *aSrc, size_t ct) { \
+    if (aDst != aSrc) memmove(aDst, aSrc, ct * sizeof(_Type)); \
+  };
+
+// Define array converters that reverse the platform byte order
+#define ENDIAN_SWAP_ARRAY(_Func, _Type, _Bits) \
+  void _Func(_Type *aValues, size_t ct) { \
+    ByteSwapArray##_Bits((u##_Bits *)aValues, (const u##_Bits *)aValues, ct); \
+  }; \
+  void _Func(_Type *aDst, const _Type *aSrc, size_t ct) { \
+    ByteSwapArray##_Bits((u##_Bits *)aDst, (const u##_Bits *)aSrc, ct); \
+  };
+
+#if _DREAMY_BYTE_ORDER == _DREAMY_LITTLE_ENDIAN
+  ENDIAN_NATIVE_ARRAY(ToLittle, u16);
+  ENDIAN_NATIVE_ARRAY(ToLittle, u32);
+  ENDIAN_NATIVE_ARRAY(ToLittle, u64);
+  ENDIAN_NATIVE_ARRAY(ToLittle, f32);
+  ENDIAN_NATIVE_ARRAY(ToLittle, f64);
+
+  ENDIAN_SWAP_ARRAY(ToBig, u16, 16);
+  ENDIAN_SWAP_ARRAY(ToBig, u32, 32);
+  ENDIAN_SWAP_ARRAY(ToBig, u64, 64);
+  ENDIAN_SWAP_ARRAY(ToBig, f32, 32);
+  ENDIAN_SWAP_ARRAY(ToBig, f64, 64);
+
+#else
+  ENDIAN_SWAP_ARRAY(ToLittle, u16, 16);
+  ENDIAN_SWAP_ARRAY(ToLittle, u32, 32);
+  ENDIAN_SWAP_ARRAY(ToLittle, u64, 64);
+  ENDIAN_SWAP_ARRAY(ToLittle, f32, 32);
+  ENDIAN_SWAP_ARRAY(ToLittle, f64, 64);
+
+  ENDIAN_NATIVE_ARRAY(ToBig, u16);
+  ENDIAN_NATIVE_ARRAY(ToBig, u32);
+  ENDIAN_NATIVE_ARRAY(ToBig, u64);
+  ENDIAN_NATIVE_ARRAY(ToBig, f32);
+  ENDIAN_NATIVE_ARRAY(ToBig, f64);
 #endif
 
+#undef ENDIAN_NATIVE_ARRAY
+#undef ENDIAN_SWAP_ARRAY
+
 }; // namespace endian
 
 }; // namespace dreamy
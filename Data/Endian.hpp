@@ -6,6 +6,8 @@
 
 #include "../DreamyUtilitiesBase.hpp"
 
+#include "Memory.hpp"
+
 namespace dreamy {
 
 // Check if operating in little-endian at runtime
@@ -20,32 +22,100 @@ __forceinline bool IsBigEndian(void) {
   return *((u8 *)&i) == 0x01;
 };
 
+// Reverse the order of bytes in each 16-bit value of an array (source and destination may be the same)
+void ByteSwapArray16(u16 *aDst, const u16 *aSrc, size_t ct);
+
+// Reverse the order of bytes in each 32-bit value of an array (source and destination may be the same)
+void ByteSwapArray32(u32 *aDst, const u32 *aSrc, size_t ct);
+
+// Reverse the order of bytes in each 64-bit value of an array (source and destination may be the same)
+void ByteSwapArray64(u64 *aDst, const u64 *aSrc, size_t ct);
+
 // Converters between big and little endianness
 namespace endian {
 
-u16 ToLittle(u16 iSrc);
-u32 ToLittle(u32 iSrc);
-u64 ToLittle(u64 iSrc);
-s16 ToLittle(s16 iSrc);
-s32 ToLittle(s32 iSrc);
-s64 ToLittle(s64 iSrc);
-f32 ToLittle(f32 fSrc);
-f64 ToLittle(f64 fSrc);
-
-u16 ToBig(u16 iSrc);
-u32 ToBig(u32 iSrc);
-u64 ToBig(u64 iSrc);
-s16 ToBig(s16 iSrc);
-s32 ToBig(s32 iSrc);
-s64 ToBig(s64 iSrc);
-f32 ToBig(f32 fSrc);
-f64 ToBig(f64 fSrc);
+#if _DREAMY_BYTE_ORDER == _DREAMY_LITTLE_ENDIAN
+
+__forceinline u16 ToLittle(u16 iSrc) { return iSrc; };
+__forceinline u32 ToLittle(u32 iSrc) { return iSrc; };
+__forceinline u64 ToLittle(u64 iSrc) { return iSrc; };
+__forceinline s16 ToLittle(s16 iSrc) { return iSrc; };
+__forceinline s32 ToLittle(s32 iSrc) { return iSrc; };
+__forceinline s64 ToLittle(s64 iSrc) { return iSrc; };
+__forceinline f32 ToLittle(f32 fSrc) { return fSrc; };
+__forceinline f64 ToLittle(f64 fSrc) { return fSrc; };
+
+__forceinline u16 ToBig(u16 iSrc) { return ByteSwap16(iSrc); };
+__forceinline u32 ToBig(u32 iSrc) { return ByteSwap32(iSrc); };
+__forceinline u64 ToBig(u64 iSrc) { return ByteSwap64(iSrc); };
+__forceinline s16 ToBig(s16 iSrc) { return (s16)ByteSwap16((u16)iSrc); };
+__forceinline s32 ToBig(s32 iSrc) { return (s32)ByteSwap32((u32)iSrc); };
+__forceinline s64 ToBig(s64 iSrc) { return (s64)ByteSwap64((u64)iSrc); };
+__forceinline f32 ToBig(f32 fSrc) { return ByteSwapF32(fSrc); };
+__forceinline f64 ToBig(f64 fSrc) { return ByteSwapF64(fSrc); };
+
+#else
+
+__forceinline u16 ToLittle(u16 iSrc) { return ByteSwap16(iSrc); };
+__forceinline u32 ToLittle(u32 iSrc) { return ByteSwap32(iSrc); };
+__forceinline u64 ToLittle(u64 iSrc) { return ByteSwap64(iSrc); };
+__forceinline s16 ToLittle(s16 iSrc) { return (s16)ByteSwap16((u16)iSrc); };
+__forceinline s32 ToLittle(s32 iSrc) { return (s32)ByteSwap32((u32)iSrc); };
+__forceinline s64 ToLittle(s64 iSrc) { return (s64)ByteSwap64((u64)iSrc); };
+__forceinline f32 ToLittle(f32 fSrc) { return ByteSwapF32(fSrc); };
+__forceinline f64 ToLittle(f64 fSrc) { return ByteSwapF64(fSrc); };
+
+__forceinline u16 ToBig(u16 iSrc) { return iSrc; };
+__forceinline u32 ToBig(u32 iSrc) { return iSrc; };
+__forceinline u64 ToBig(u64 iSrc) { return iSrc; };
+__forceinline s16 ToBig(s16 iSrc) { return iSrc; };
+__forceinline s32 ToBig(s32 iSrc) { return iSrc; };
+__forceinline s64 ToBig(s64 iSrc) { return iSrc; };
+__forceinline f32 ToBig(f32 fSrc) { return fSrc; };
+__forceinline f64 ToBig(f64 fSrc) { return fSrc; };
+
+#endif
 
 #if _DREAMY_UNIX
-size_t ToLittle(size_t iSrc);
-size_t ToBig(size_t iSrc);
+
+__forceinline size_t ToLittle(size_t iSrc) {
+  if (sizeof(size_t) == 8) return (size_t)ToLittle((u64)iSrc);
+  return (size_t)ToLittle((u32)iSrc);
+};
+
+__forceinline size_t ToBig(size_t iSrc) {
+  if (sizeof(size_t) == 8) return (size_t)ToBig((u64)iSrc);
+  return (size_t)ToBig((u32)iSrc);
+};
+
 #endif
 
+// Convert arrays of values in place
+void ToLittle(u16 *aValues, size_t ct);
+void ToLittle(u32 *aValues, size_t ct);
+void ToLittle(u64 *aValues, size_t ct);
+void ToLittle(f32 *aValues, size_t ct);
+void ToLittle(f64 *aValues, size_t ct);
+
+void ToBig(u16 *aValues, size_t ct);
+void ToBig(u32 *aValues, size_t ct);
+void ToBig(u64 *aValues, size_t ct);
+void ToBig(f32 *aValues, size_t ct);
+void ToBig(f64 *aValues, size_t ct);
+
+// Convert arrays of values into another array
+void ToLittle(u16 *aDst, const u16 *aSrc, size_t ct);
+void ToLittle(u32 *aDst, const u32 *aSrc, size_t ct);
+void ToLittle(u64 *aDst, const u64 *aSrc, size_t ct);
+void ToLittle(f32 *aDst, const f32 *aSrc, size_t ct);
+void ToLittle(f64 *aDst, const f64 *aSrc, size_t ct);
+
+void ToBig(u16 *aDst, const u16 *aSrc, size_t ct);
+void ToBig(u32 *aDst, const u32 *aSrc, size_t ct);
+void ToBig(u64 *aDst, const u64 *aSrc, size_t ct);
+void ToBig(f32 *aDst, const f32 *aSrc, size_t ct);
+void ToBig(f64 *aDst, const f64 *aSrc, size_t ct);
+
 }; // namespace endian
 
 }; // namespace dreamy
@@ -89,6 +89,26 @@ __forceinline u64 ByteSwap64(u64 i64)
   #endif
 };
 
+// Reverse the order of bytes in a single precision float
+__forceinline f32 ByteSwapF32(f32 f)
+{
+  u32 i;
+  memcpy(&i, &f, sizeof(i));
+  i = ByteSwap32(i);
+  memcpy(&f, &i, sizeof(f));
+  return f;
+};
+
+// Reverse the order of bytes in a double precision float
+__forceinline f64 ByteSwapF64(f64 f)
+{
+  u64 i;
+  memcpy(&i, &f, sizeof(i));
+  i = ByteSwap64(i);
+  memcpy(&f, &i, sizeof(f));
+  return f;
+};
+
 // Resize array by constructing values in place and moving the data bytes
 template<typename Type> inline
 void ResizeBuffer_memcpy(Type **pBuffer, size_t iOldSize, size_t iNewSize) {
@@ -0,0 +1,75 @@
+//! This file is a part of Dreamy Utilities.
+//! Licensed under the MIT license (see LICENSE file).
+
+#include "SIMD.hpp"
+
+#if _DREAMY_SIMD_DISPATCH && !_DREAMY_UNIX
+  #include <intrin.h>
+#endif
+
+namespace dreamy {
+
+namespace cpu {
+
+#if _DREAMY_SIMD_DISPATCH && _DREAMY_UNIX
+
+// Query processor features via compiler builtins
+static bool DetectFeature(bool bAVX2) {
+  // May be called during static initialization
+  __builtin_cpu_init();
+
+  if (bAVX2) return __builtin_cpu_supports("avx2") != 0;
+  return __builtin_cpu_supports("ssse3") != 0;
+};
+
+#elif _DREAMY_SIMD_DISPATCH
+
+// Query processor features via CPUID on MSVC
+static bool DetectFeature(bool bAVX2) {
+  int aiRegs[4];
+  __cpuid(aiRegs, 0);
+
+  const int iMaxLeaf = aiRegs[0];
+  if (iMaxLeaf < 1) return false;
+
+  __cpuid(aiRegs, 1);
+
+  // SSSE3 is bit 9 of ECX
+  if (!bAVX2) return (aiRegs[2] & (1 << 9)) != 0;
+
+  // AVX needs OSXSAVE (bit 27) and AVX (bit 28) as well as the OS saving YMM registers
+  if ((aiRegs[2] & (3 << 27)) != (3 << 27)) return false;
+  if ((_xgetbv(0) & 6) != 6) return false;
+
+  if (iMaxLeaf < 7) return false;
+
+  // AVX2 is bit 5 of EBX
+  __cpuidex(aiRegs, 7, 0);
+  return (aiRegs[1] & (1 << 5)) != 0;
+};
+
+#endif
+
+bool HasSSSE3(void) {
+#if !_DREAMY_SIMD_DISPATCH
+  return false;
+
+#else
+  static const bool bSupported = DetectFeature(false);
+  return bSupported;
+#endif
+};
+
+bool HasAVX2(void) {
+#if !_DREAMY_SIMD_DISPATCH
+  return false;
+
+#else
+  static const bool bSupported = DetectFeature(true);
+  return bSupported;
+#endif
+};
+
+}; // namespace cpu
+
+}; // namespace dreamy
@@ -0,0 +1,134 @@
+//! This file is a part of Dreamy Utilities.
+//! Licensed under the MIT license (see LICENSE file).
+
+#ifndef _DREAMYUTILITIES_INCL_SIMD_H
+#define _DREAMYUTILITIES_INCL_SIMD_H
+
+#include "../DreamyUtilitiesBase.hpp"
+
+// Define _DREAMY_NO_SIMD to force scalar code paths everywhere
+#if !defined(_DREAMY_NO_SIMD)
+
+  // SSE2 is the baseline on x64 and can be assumed if the compiler targets it on x86
+  #if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #if _DREAMY_UNIX || _DREAMY_CPP11
+      #define _DREAMY_SSE2 1
+    #endif
+  #endif
+
+  // Newer instruction sets can be compiled per function and selected at runtime
+  #if _DREAMY_SSE2
+    #if _DREAMY_UNIX && (defined(__clang__) || __GNUC__ >= 5)
+      #define _DREAMY_SIMD_DISPATCH 1
+
+    #elif !_DREAMY_UNIX
+      #define _DREAMY_SIMD_DISPATCH 1
+    #endif
+  #endif
+
+#endif
+
+#if !defined(_DREAMY_SSE2)
+  #define _DREAMY_SSE2 0
+#endif
+
+#if !defined(_DREAMY_SIMD_DISPATCH)
+  #define _DREAMY_SIMD_DISPATCH 0
+#endif
+
+#if _DREAMY_SIMD_DISPATCH
+  #include <immintrin.h>
+
+#elif _DREAMY_SSE2
+  #include <emmintrin.h>
+#endif
+
+#if _DREAMY_SSE2 && !_DREAMY_UNIX
+  #include <intrin.h>
+#endif
+
+// Compile a function for a specific instruction set
+#if _DREAMY_SIMD_DISPATCH && _DREAMY_UNIX
+  #define DREAMY_TARGET_SSSE3 __attribute__((target("ssse3")))
+  #define DREAMY_TARGET_AVX2  __attribute__((target("avx2")))
+#else
+  #define DREAMY_TARGET_SSSE3
+  #define DREAMY_TARGET_AVX2
+#endif
+
+namespace dreamy {
+
+// Processor features detected at runtime
+namespace cpu {
+
+// Check if the processor supports SSSE3 instructions
+bool HasSSSE3(void);
+
+// Check if the processor and the OS support AVX2 instructions
+bool HasAVX2(void);
+
+}; // namespace cpu
+
+// Get index of the lowest set bit in a non-zero mask (e.g. from _mm_movemask_epi8)
+inline u32 LowestSetBit(u32 iMask) {
+  D_ASSERT(iMask != 0);
+
+#if _DREAMY_UNIX
+  return (u32)__builtin_ctz(iMask);
+
+#elif _DREAMY_SSE2
+  unsigned long iIndex;
+  _BitScanForward(&iIndex, iMask);
+  return (u32)iIndex;
+
+#else
+  u32 iIndex = 0;
+
+  while (!(iMask & 1)) {
+    iMask >>= 1;
+    ++iIndex;
+  }
+
+  return iIndex;
+#endif
+};
+
+// Get index of the highest set bit in a non-zero mask
+inline u32 HighestSetBit(u32 iMask) {
+  D_ASSERT(iMask != 0);
+
+#if _DREAMY_UNIX
+  return 31 - (u32)__builtin_clz(iMask);
+
+#elif _DREAMY_SSE2
+  unsigned long iIndex;
+  _BitScanReverse(&iIndex, iMask);
+  return (u32)iIndex;
+
+#else
+  u32 iIndex = 31;
+
+  while (!(iMask & 0x80000000UL)) {
+    iMask <<= 1;
+    --iIndex;
+  }
+
+  return iIndex;
+#endif
+};
+
+// Count set bits in a mask
+inline u32 CountSetBits(u32 iMask) {
+#if _DREAMY_UNIX
+  return (u32)__builtin_popcount(iMask);
+
+#else
+  iMask = iMask - ((iMask >> 1) & 0x55555555UL);
+  iMask = (iMask & 0x33333333UL) + ((iMask >> 2) & 0x33333333UL);
+  return (((iMask + (iMask >> 4)) & 0x0F0F0F0FUL) * 0x01010101UL) >> 24;
+#endif
+};
+
+}; // namespace dreamy
+
+#endif // (Dreamy Utilities Include Guard)
@@ -2,8 +2,13 @@
 //! Licensed under the MIT license (see LICENSE file).
 
 // Compile all source files in a single place for convenience
+#include "Data/Allocator.cpp"
+#include "Data/Atomic.cpp"
+#include "Data/ByteSearch.cpp"
 #include "Data/DataDump.cpp"
+#include "Data/Encoding.cpp"
 #include "Data/Endian.cpp"
+#include "Data/SIMD.cpp"
 
 #include "Hashing/CRC32.cpp"
 #include "Hashing/SimpleHasher.cpp"
@@ -14,11 +19,22 @@
 #include "IO/FileDevice.cpp"
 #include "IO/Files.cpp"
 #include "IO/ReadWriteDevice.cpp"
+#include "IO/StringBuilderDevice.cpp"
 #include "IO/StringStream.cpp"
 
 #include "Parser/JSON.cpp"
+#include "Parser/JSONDocument.cpp"
+#include "Parser/NumberParser.cpp"
 #include "Parser/ParserData.cpp"
 
 #include "Types/ByteArray.cpp"
+#include "Types/CharSet.cpp"
+#include "Types/Format.cpp"
+#include "Types/ObjectShape.cpp"
+#include "Types/PathTable.cpp"
+#include "Types/PatternMatcher.cpp"
 #include "Types/String.cpp"
+#include "Types/StringBuilder.cpp"
 #include "Types/Variant.cpp"
+#include "Types/VariantBinary.cpp"
+#include "Types/Wildcard.cpp"
@@ -132,6 +132,15 @@
   #define vswprintf _vsnwprintf
 #endif
 
+// Copy variable argument lists on compilers without C99 support
+#if !defined(va_copy)
+  #if defined(__va_copy)
+    #define va_copy(_Dst, _Src) __va_copy(_Dst, _Src)
+  #else
+    #define va_copy(_Dst, _Src) ((_Dst) = (_Src))
+  #endif
+#endif
+
 namespace dreamy {
 
 // Scalar types
@@ -161,6 +170,9 @@ typedef char c8; // ASCII character
 // Maximum value of size_t
 #define NULL_POS static_cast<size_t>(-1)
 
+// 64-bit integer constant out of two 32-bit halves (for compilers without 64-bit literals)
+#define DREAMY_U64(_High, _Low) ((static_cast<dreamy::u64>(_High) << 32) | static_cast<dreamy::u64>(_Low))
+
 }; // namespace dreamy
 
 #endif // (Dreamy Utilities Include Guard)
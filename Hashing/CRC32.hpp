@@ -25,6 +25,7 @@ public:
 
   // Hash an array of bytes (adds up to the current hash)
   virtual void AddData(const c8 *pData, size_t iSize);
+  using IHasher::AddData;
 
   // Get hash value as a sequence of bytes
   virtual CByteArray GetBytes(void) const;
@@ -36,6 +37,11 @@ public:
   // Get CRC32 value of an array of bytes
   u32 operator()(const c8 *pData, size_t iSize);
 
+  // Get CRC32 value of a view of bytes
+  inline u32 operator()(const CByteView &data) {
+    return operator()(data.Data(), data.Size());
+  };
+
   // Begin CRC32 calculation from an existing hash value
   void Begin(u32 iHash = 0);
 
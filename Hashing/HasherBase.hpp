@@ -6,7 +6,7 @@
 
 #include "../DreamyUtilitiesBase.hpp"
 
-#include "../Types/ByteArray.hpp"
+#include "../Types/ByteView.hpp"
 
 namespace dreamy {
 
@@ -19,6 +19,11 @@ public:
   // Hash an array of bytes (adds up to the current hash)
   virtual void AddData(const c8 *pData, size_t iSize) = 0;
 
+  // Hash a view of bytes (adds up to the current hash)
+  inline void AddData(const CByteView &data) {
+    AddData(data.Data(), data.Size());
+  };
+
   // Get hash value as a sequence of bytes
   virtual CByteArray GetBytes(void) const = 0;
 };
@@ -26,6 +26,7 @@ public:
 
   // Hash an array of bytes (adds up to the current hash)
   virtual void AddData(const c8 *pData, size_t iSize);
+  using IHasher::AddData;
 
   // Get hash value as a sequence of bytes
   virtual CByteArray GetBytes(void) const;
@@ -42,6 +43,11 @@ public:
 public:
   // Get hash from an array of bytes
   u64 operator()(const c8 *pData, size_t iSize);
+
+  // Get hash from a view of bytes
+  inline u64 operator()(const CByteView &data) {
+    return operator()(data.Data(), data.Size());
+  };
 };
 
 }; // namespace dreamy
@@ -108,6 +108,38 @@ size_t CBufferDevice::Write(const c8 *pData, size_t iMaxSize) {
   return iMaxSize;
 };
 
+size_t CBufferDevice::WriteChunks(const DataChunk *aChunks, size_t ctChunks) {
+  if (_pData == nullptr || !IsWritable()) {
+    return NULL_POS;
+  }
+
+  size_t iTotal = 0;
+
+  for (size_t i = 0; i < ctChunks; ++i) {
+    iTotal += aChunks[i].iSize;
+  }
+
+  if (iTotal == 0) return 0;
+
+  // Grow the buffer only once
+  if (_iPos + iTotal > Size()) {
+    _pData->Resize(_iPos + iTotal);
+  }
+
+  c8 *pDest = &_pData->Data()[_iPos];
+
+  for (size_t i = 0; i < ctChunks; ++i) {
+    const DataChunk &chunk = aChunks[i];
+    if (chunk.iSize == 0) continue;
+
+    memcpy(pDest, chunk.pData, chunk.iSize);
+    pDest += chunk.iSize;
+  }
+
+  _iPos += iTotal;
+  return iTotal;
+};
+
 void CBufferDevice::SetBuffer(CByteArray *pData) {
   if (IsOpen()) return;
   _pData = pData;
@@ -53,6 +53,9 @@ public:
   // Put bytes into the device
   virtual size_t Write(const c8 *pData, size_t iMaxSize);
 
+  // Put multiple ranges of bytes into the device after resizing the buffer once
+  virtual size_t WriteChunks(const DataChunk *aChunks, size_t ctChunks);
+
   // Get type of the device class
   virtual EDeviceType GetType(void) const {
     return TYPE_BUFFER;
@@ -27,4 +27,21 @@ size_t IReadWriteDevice::Write(const CByteArray &baData) {
   return Write(baData.ConstData(), baData.Size());
 };
 
+size_t IReadWriteDevice::WriteChunks(const DataChunk *aChunks, size_t ctChunks) {
+  size_t iTotal = 0;
+
+  for (size_t i = 0; i < ctChunks; ++i) {
+    const DataChunk &chunk = aChunks[i];
+    if (chunk.iSize == 0) continue;
+
+    const size_t iWritten = Write(chunk.pData, chunk.iSize);
+    if (iWritten == NULL_POS) return NULL_POS;
+
+    iTotal += iWritten;
+    if (iWritten != chunk.iSize) break;
+  }
+
+  return iTotal;
+};
+
 }; // namespace dreamy
@@ -28,6 +28,13 @@ public:
     TYPE_BUFFER,
     TYPE_FILE,
     TYPE_LOCALSOCKET,
+    TYPE_STRINGBUILDER,
+  };
+
+  // Range of bytes for writing multiple buffers at once
+  struct DataChunk {
+    const c8 *pData;
+    size_t iSize;
   };
 
 protected:
@@ -101,6 +108,9 @@ public:
   // Put bytes into the device
   virtual size_t Write(const CByteArray &baData);
 
+  // Put multiple ranges of bytes into the device one after another and return their total size
+  virtual size_t WriteChunks(const DataChunk *aChunks, size_t ctChunks);
+
   // Get type of the device class
   virtual EDeviceType GetType(void) const {
     return TYPE_INVALID;
@@ -0,0 +1,80 @@
+//! This file is a part of Dreamy Utilities.
+//! Licensed under the MIT license (see LICENSE file).
+
+#include "StringBuilderDevice.hpp"
+
+namespace dreamy {
+
+CStringBuilderDevice::CStringBuilderDevice() : _pBuilder(nullptr)
+{
+  _eOpenMode = OM_UNOPEN;
+};
+
+CStringBuilderDevice::CStringBuilderDevice(CStringBuilder *pBuilder) : _pBuilder(pBuilder)
+{
+  _eOpenMode = OM_UNOPEN;
+};
+
+bool CStringBuilderDevice::Open(EOpenMode eOpenMode) {
+  if (_pBuilder == nullptr || eOpenMode != OM_WRITEONLY) {
+    return false;
+  }
+
+  _eOpenMode = eOpenMode;
+  return true;
+};
+
+void CStringBuilderDevice::Close(void) {
+  _eOpenMode = OM_UNOPEN;
+};
+
+bool CStringBuilderDevice::AtEnd(void) const {
+  return true;
+};
+
+size_t CStringBuilderDevice::Pos(void) const {
+  return IsOpen() ? _pBuilder->Length() : NULL_POS;
+};
+
+size_t CStringBuilderDevice::Size(void) const {
+  return (_pBuilder != nullptr) ? _pBuilder->Length() : NULL_POS;
+};
+
+bool CStringBuilderDevice::Seek(size_t iOffset) {
+  return IsOpen() && iOffset == _pBuilder->Length();
+};
+
+size_t CStringBuilderDevice::Skip(size_t iMaxSize) {
+  (void)iMaxSize;
+  return IsOpen() ? 0 : NULL_POS;
+};
+
+size_t CStringBuilderDevice::Read(c8 *pData, size_t iMaxSize) {
+  // Write-only device
+  (void)pData;
+  (void)iMaxSize;
+  return NULL_POS;
+};
+
+size_t CStringBuilderDevice::Peek(c8 *pData, size_t iMaxSize) {
+  // Write-only device
+  (void)pData;
+  (void)iMaxSize;
+  return NULL_POS;
+};
+
+size_t CStringBuilderDevice::Write(const c8 *pData, size_t iMaxSize) {
+  if (pData == nullptr || !IsWritable()) {
+    return NULL_POS;
+  }
+
+  _pBuilder->Append(pData, iMaxSize);
+  return iMaxSize;
+};
+
+void CStringBuilderDevice::SetBuilder(CStringBuilder *pBuilder) {
+  if (IsOpen()) return;
+  _pBuilder = pBuilder;
+};
+
+}; // namespace dreamy
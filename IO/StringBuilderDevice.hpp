@@ -0,0 +1,77 @@
+//! This file is a part of Dreamy Utilities.
+//! Licensed under the MIT license (see LICENSE file).
+
+#ifndef _DREAMYUTILITIES_INCL_STRINGBUILDERDEVICE_H
+#define _DREAMYUTILITIES_INCL_STRINGBUILDERDEVICE_H
+
+#include "../DreamyUtilitiesBase.hpp"
+
+#include "ReadWriteDevice.hpp"
+#include "../Types/StringBuilder.hpp"
+
+namespace dreamy {
+
+// Write-only device that appends everything to the end of a string builder
+// Allows streams (e.g. CStringStream) to print large texts without reallocating a single buffer
+class CStringBuilderDevice : public IReadWriteDevice {
+
+protected:
+  CStringBuilder *_pBuilder;
+
+public:
+  // Default constructor
+  CStringBuilderDevice();
+
+  // Constructor that appends to a string builder
+  CStringBuilderDevice(CStringBuilder *pBuilder);
+
+  // Start interacting in a given mode (only writing is possible)
+  virtual bool Open(EOpenMode eOpenMode);
+
+  // End interacting with
+  virtual void Close(void);
+
+  // Check if the carret is at the end
+  virtual bool AtEnd(void) const;
+
+  // Return current carret position
+  virtual size_t Pos(void) const;
+
+  // Length of the built string
+  virtual size_t Size(void) const;
+
+  // Only the end of the string can be seeked to
+  virtual bool Seek(size_t iOffset);
+
+  // Cannot move forward past the end
+  virtual size_t Skip(size_t iMaxSize);
+
+  // Cannot read from the device
+  virtual size_t Read(c8 *pData, size_t iMaxSize);
+
+  // Cannot read from the device
+  virtual size_t Peek(c8 *pData, size_t iMaxSize);
+
+  // Append bytes to the string builder
+  virtual size_t Write(const c8 *pData, size_t iMaxSize);
+
+  // Get type of the device class
+  virtual EDeviceType GetType(void) const {
+    return TYPE_STRINGBUILDER;
+  };
+
+// Builder manipulation
+public:
+
+  // Set new string builder (while unopen)
+  void SetBuilder(CStringBuilder *pBuilder);
+
+  // Get string builder
+  inline CStringBuilder *GetBuilder(void) const {
+    return _pBuilder;
+  };
+};
+
+}; // namespace dreamy
+
+#endif // (Dreamy Utilities Include Guard)
@@ -3,6 +3,8 @@
 
 #include "StringStream.hpp"
 #include "BufferDevice.hpp"
+#include "../Types/Format.hpp"
+#include "../Data/ByteSearch.hpp"
 
 #include <cstdlib>
 
@@ -43,32 +45,98 @@ const c8 *CStringStream::GetString(void) const {
   return ((CBufferDevice *)_pDevice)->GetBuffer();
 };
 
-void CStringStream::PrintF(const c8 *strFormat, ...) {
+size_t CStringStream::GetLine(c8 *strBuffer, size_t iBufferSize, c8 chDelimiter) {
+  // Read one character at a time from other devices
+  if (_pDevice->GetType() != IReadWriteDevice::TYPE_BUFFER || GetStatus() != STATUS_OK) {
+    return GetLine<c8>(strBuffer, iBufferSize, chDelimiter);
+  }
+
+  // Nothing to read
+  if (AtEnd()) {
+    strBuffer[0] = '\0';
+    return 0;
+  }
+
+  const c8 *pchData = ((CBufferDevice *)_pDevice)->GetBuffer();
+  const size_t iStart = Pos();
+  const size_t iSize = _pDevice->Size();
+
+  // Line ends before the delimiter or the last character
+  size_t iEnd = FindByte(pchData + iStart, iSize - iStart, chDelimiter);
+  iEnd = (iEnd != NULL_POS) ? iStart + iEnd : iSize - 1;
+
+  size_t iChars = 0;
+  size_t i = iStart;
+
+  while (i < iEnd) {
+    // Copy characters up to the next carriage return
+    const c8 *pchReturn = (const c8 *)memchr(pchData + i, '\r', iEnd - i);
+    size_t iCopy = (pchReturn != nullptr) ? size_t(pchReturn - pchData) - i : iEnd - i;
+
+    if (iCopy > iBufferSize - iChars) iCopy = iBufferSize - iChars;
+
+    memcpy(strBuffer + iChars, pchData + i, iCopy);
+    iChars += iCopy;
+    i += iCopy;
+
+    // Reached the limit
+    if (iChars == iBufferSize) {
+      Skip(i - iStart);
+      return iChars;
+    }
+
+    // Ignore carriage return characters
+    if (i < iEnd) ++i;
+  }
+
+  // Skip the delimiter or the last character
+  strBuffer[iChars] = '\0';
+  Skip(iEnd + 1 - iStart);
+
+  return iChars;
+};
+
+void CStringStream::VPrintF(const c8 *strFormat, va_list arg) {
+  // Try printing into a stack buffer first
+  c8 strBuffer[256];
+
+  va_list argCopy;
+  va_copy(argCopy, arg);
+  const size_t iLength = VPrintToBuffer(strBuffer, sizeof(strBuffer), strFormat, argCopy);
+  va_end(argCopy);
+
+  if (iLength < sizeof(strBuffer)) {
+    if (Write(strBuffer, iLength) != iLength) SetStatus(STATUS_WRITEFAILED);
+    return;
+  }
+
+  // Too long for the buffer
   CString strOut;
-  DREAMY_PRINTF_INLINE(strOut, strFormat);
+  strOut.VPrintF(strFormat, arg);
 
   *this << strOut;
 };
 
-CDataStream &CStringStream::operator<<(const c8 *str) {
-  // Write every character
-  size_t iSize = strlen(str);
+void CStringStream::PrintF(const c8 *strFormat, ...) {
+  va_list arg;
+  va_start(arg, strFormat);
+  VPrintF(strFormat, arg);
+  va_end(arg);
+};
 
-  for (size_t i = 0; i < iSize; ++i) {
-    *this << str[i];
-  }
+CDataStream &CStringStream::operator<<(const c8 *str) {
+  // Write all characters at once
+  const size_t iSize = strlen(str);
 
+  if (iSize != 0 && Write(str, iSize) != iSize) SetStatus(STATUS_WRITEFAILED);
   return *this;
 };
 
 CDataStream &CStringStream::operator<<(const CString &str) {
-  // Write every character
-  size_t iSize = str.length();
-
-  for (size_t i = 0; i < iSize; ++i) {
-    *this << str[i];
-  }
+  // Write all characters at once
+  const size_t iSize = str.length();
 
+  if (iSize != 0 && Write(str.c_str(), iSize) != iSize) SetStatus(STATUS_WRITEFAILED);
   return *this;
 };
 
@@ -82,29 +150,42 @@ CDataStream &CStringStream::operator>>(c8 &dst) {
   return *this;
 };
 
-// Define method for printing a simple value into the stream
-#define WRITE_VAL(_Type, _Format) \
+// Define method for printing an integer into the stream
+#define WRITE_VAL(_Type, _Formatter, _Cast) \
   CDataStream &CStringStream::operator<<(_Type val) { \
-    c8 str[128]; \
-    sprintf(str, _Format, val); \
-    return operator<<(str); \
+    c8 str[32]; \
+    const size_t iLength = _Formatter(str, _Cast(val)); \
+    if (Write(str, iLength) != iLength) SetStatus(STATUS_WRITEFAILED); \
+    return *this; \
   };
 
-WRITE_VAL(u8 , "%hhu");
-WRITE_VAL(u16, "%hu");
-WRITE_VAL(u32, "%lu");
-WRITE_VAL(u64, "%llu");
-WRITE_VAL(s8 , "%hhd");
-WRITE_VAL(s16, "%hd");
-WRITE_VAL(s32, "%ld");
-WRITE_VAL(s64, "%lld");
-WRITE_VAL(f32, "%g");
-WRITE_VAL(f64, "%g");
+WRITE_VAL(u8 , FormatUInt, u64);
+WRITE_VAL(u16, FormatUInt, u64);
+WRITE_VAL(u32, FormatUInt, u64);
+WRITE_VAL(u64, FormatUInt, u64);
+WRITE_VAL(s8 , FormatInt, s64);
+WRITE_VAL(s16, FormatInt, s64);
+WRITE_VAL(s32, FormatInt, s64);
+WRITE_VAL(s64, FormatInt, s64);
 
 #if _DREAMY_UNIX
-  WRITE_VAL(size_t, "%llu");
+  WRITE_VAL(size_t, FormatUInt, u64);
 #endif
 
 #undef WRITE_VAL
 
+// Define method for printing a real number into the stream
+#define WRITE_VAL(_Type) \
+  CDataStream &CStringStream::operator<<(_Type val) { \
+    c8 str[128]; \
+    const size_t iLength = FormatReal(str, sizeof(str), val); \
+    if (Write(str, iLength) != iLength) SetStatus(STATUS_WRITEFAILED); \
+    return *this; \
+  };
+
+WRITE_VAL(f32);
+WRITE_VAL(f64);
+
+#undef WRITE_VAL
+
 }; // namespace dreamy
@@ -7,6 +7,7 @@
 #include "../DreamyUtilitiesBase.hpp"
 
 #include "DataStream.hpp"
+#include "../Types/Format.hpp"
 
 namespace dreamy {
 
@@ -29,9 +30,22 @@ public:
   // Return data as a string
   const c8 *GetString(void) const;
 
+  // Print into the stream using a list of arguments
+  void VPrintF(const c8 *strFormat, va_list arg);
+
   // Print into the stream
   void PrintF(const c8 *strFormat, ...);
 
+#if _DREAMY_CPP11
+  // Print into the stream using a compiled format string
+  template<typename... Args>
+  void Format(const CFormatString &fmt, const Args &... args) {
+    CString strOut;
+    FormatAppend(strOut, fmt, args...);
+    *this << strOut;
+  };
+#endif
+
   // Read a text line until a specific delimiter
   template<typename Type>
   size_t GetLine(Type *strBuffer, size_t iBufferSize, Type chDelimiter = '\n') {
@@ -71,6 +85,10 @@ public:
     return iChars;
   };
 
+  // Read a text line until a specific delimiter
+  // Scans the whole line at once if the stream is reading from a buffer
+  size_t GetLine(c8 *strBuffer, size_t iBufferSize, c8 chDelimiter = '\n');
+
 // Stream methods
 public:
 
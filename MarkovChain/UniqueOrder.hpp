@@ -130,6 +130,29 @@ struct hash<dreamy::CUniqueOrder<Type>>
 };
 
 }; // namespace std
+
+#else
+namespace dreamy {
+
+// Unique order hasher
+template<typename Type>
+struct MapHash< CUniqueOrder<Type> >
+{
+  size_t operator()(const CUniqueOrder<Type> &order) const {
+    MapHash<Type> hasher;
+    size_t hash = 0;
+
+    const size_t iSize = order.size();
+
+    for (size_t i = 0; i < iSize; ++i) {
+      hash = hash * 31 + hasher(order[i]);
+    }
+
+    return hash;
+  }
+};
+
+}; // namespace dreamy
 #endif
 
 #endif // (Dreamy Utilities Include Guard)
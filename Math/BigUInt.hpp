@@ -0,0 +1,165 @@
+//! This file is a part of Dreamy Utilities.
+//! Licensed under the MIT license (see LICENSE file).
+
+#ifndef _DREAMYUTILITIES_INCL_MATH_BIGUINT_H
+#define _DREAMYUTILITIES_INCL_MATH_BIGUINT_H
+
+#include "../DreamyUtilitiesBase.hpp"
+
+namespace dreamy {
+
+// Unsigned integer of a fixed maximum size for exact conversions between decimal and binary numbers
+// Values that don't fit are silently truncated, so callers must keep within the limit
+class CBigUInt {
+
+public:
+  // Maximum amount of 32-bit limbs (enough for any double with 768 decimal digits)
+  enum { MAX_LIMBS = 128 };
+
+private:
+  u32 _aLimbs[MAX_LIMBS]; // Lowest limb first
+  u32 _ctLimbs; // Amount of used limbs without leading zero limbs
+
+public:
+  // Constructor from a small number
+  CBigUInt(u64 i = 0) {
+    Set(i);
+  };
+
+  // Replace the value with a small number
+  inline void Set(u64 i) {
+    _aLimbs[0] = u32(i);
+    _aLimbs[1] = u32(i >> 32);
+    _ctLimbs = (_aLimbs[1] != 0) ? 2 : (_aLimbs[0] != 0);
+  };
+
+  // Check if the value is zero
+  inline bool IsZero(void) const {
+    return _ctLimbs == 0;
+  };
+
+  // Get amount of significant bits
+  inline u32 Bits(void) const {
+    if (_ctLimbs == 0) return 0;
+
+    u32 ct = (_ctLimbs - 1) * 32;
+    for (u32 iTop = _aLimbs[_ctLimbs - 1]; iTop != 0; iTop >>= 1) ++ct;
+
+    return ct;
+  };
+
+  // Multiply by a small number
+  void Mul(u32 iFactor) {
+    u64 iCarry = 0;
+
+    for (u32 i = 0; i < _ctLimbs; ++i) {
+      iCarry += u64(_aLimbs[i]) * iFactor;
+      _aLimbs[i] = u32(iCarry);
+      iCarry >>= 32;
+    }
+
+    if (iCarry != 0 && _ctLimbs < MAX_LIMBS) _aLimbs[_ctLimbs++] = u32(iCarry);
+    Trim();
+  };
+
+  // Add a small number
+  void Add(u32 iAddend) {
+    u64 iCarry = iAddend;
+
+    for (u32 i = 0; i < _ctLimbs && iCarry != 0; ++i) {
+      iCarry += _aLimbs[i];
+      _aLimbs[i] = u32(iCarry);
+      iCarry >>= 32;
+    }
+
+    if (iCarry != 0 && _ctLimbs < MAX_LIMBS) _aLimbs[_ctLimbs++] = u32(iCarry);
+  };
+
+  // Multiply by a power of five
+  void MulPow5(u32 iPower) {
+    // 5^13 is the largest power that fits 32 bits
+    for (; iPower >= 13; iPower -= 13) Mul(1220703125);
+
+    u32 iFactor = 1;
+    while (iPower-- != 0) iFactor *= 5;
+
+    if (iFactor != 1) Mul(iFactor);
+  };
+
+  // Divide by a small number and return the remainder
+  u32 Div(u32 iDivisor) {
+    u64 iRemainder = 0;
+
+    for (u32 i = _ctLimbs; i-- != 0;) {
+      iRemainder = (iRemainder << 32) | _aLimbs[i];
+      _aLimbs[i] = u32(iRemainder / iDivisor);
+      iRemainder %= iDivisor;
+    }
+
+    Trim();
+    return u32(iRemainder);
+  };
+
+  // Shift bits to the left
+  void ShiftLeft(u32 iBits) {
+    if (_ctLimbs == 0) return;
+
+    const u32 iLimbShift = iBits / 32;
+    const u32 iBitShift = iBits % 32;
+
+    // Limbs that are shifted past the limit are lost
+    u32 ctNew = _ctLimbs + iLimbShift + (iBitShift != 0);
+    if (ctNew > MAX_LIMBS) ctNew = MAX_LIMBS;
+
+    for (u32 i = ctNew; i-- != 0;) {
+      const s32 iSrc = s32(i) - s32(iLimbShift);
+      u32 iLimb = 0;
+
+      if (iSrc >= 0 && u32(iSrc) < _ctLimbs) iLimb = _aLimbs[iSrc] << iBitShift;
+      if (iBitShift != 0 && iSrc >= 1 && u32(iSrc - 1) < _ctLimbs) iLimb |= _aLimbs[iSrc - 1] >> (32 - iBitShift);
+
+      _aLimbs[i] = iLimb;
+    }
+
+    _ctLimbs = ctNew;
+    Trim();
+  };
+
+  // Remove and return all bits starting from a specific one (the result must fit 32 bits)
+  u32 SplitAt(u32 iBit) {
+    const u32 iLimb = iBit / 32;
+    const u32 iBitShift = iBit % 32;
+
+    if (iLimb >= _ctLimbs) return 0;
+
+    u64 iHigh = _aLimbs[iLimb];
+    if (iLimb + 1 < _ctLimbs) iHigh |= u64(_aLimbs[iLimb + 1]) << 32;
+
+    _aLimbs[iLimb] &= (iBitShift != 0) ? (u32(1) << iBitShift) - 1 : 0;
+    _ctLimbs = iLimb + 1;
+    Trim();
+
+    return u32(iHigh >> iBitShift);
+  };
+
+  // Compare with another number (-1, 0 or 1)
+  s32 Compare(const CBigUInt &other) const {
+    if (_ctLimbs != other._ctLimbs) return (_ctLimbs < other._ctLimbs) ? -1 : 1;
+
+    for (u32 i = _ctLimbs; i-- != 0;) {
+      if (_aLimbs[i] != other._aLimbs[i]) return (_aLimbs[i] < other._aLimbs[i]) ? -1 : 1;
+    }
+
+    return 0;
+  };
+
+private:
+  // Forget leading zero limbs
+  inline void Trim(void) {
+    while (_ctLimbs != 0 && _aLimbs[_ctLimbs - 1] == 0) --_ctLimbs;
+  };
+};
+
+}; // namespace dreamy
+
+#endif // (Dreamy Utilities Include Guard)
@@ -13,7 +13,8 @@ namespace json {
 const Constants _constants;
 
 // Tokenize JSON file contents
-void Tokenize(CTokenList &aTokens, const CString &strJSON, const CValObject &oConstants) {
+template<typename TokenList>
+void Tokenize(TokenList &aTokens, const CStringView &strJSON, const CValObject &oConstants) {
   CParserData data(strJSON);
 
   while (data.CanParse()) {
@@ -66,83 +67,132 @@ void Tokenize(CTokenList &aTokens, const CString &strJSON, const CValObject &oCo
 };
 
 // Build a JSON array
-void BuildArray(CVariant &aArray, CTokenList::const_iterator &itCurrent, CTokenList::const_iterator itEnd) {
-  CTokenList::const_iterator itClosing = std::find(itCurrent, itEnd, CParserToken(CParserToken::TKN_GROUP_CLOSE));
-
-  // Unclosed array
-  if (itClosing == itEnd) {
-    throw CTokenException(itCurrent->GetTokenPos(), "Unclosed array");
-  }
+template<typename TokenList>
+void BuildArray(CVariant &aArray, const TokenList &aTokens, typename TokenList::const_iterator &it, CObjectShapeCache *pShapes) {
+  const typename TokenList::const_iterator itStart = it;
 
   CValArray aValues;
-  bool bNext = false; // Search for the next array entry
 
-  while (itCurrent != itClosing) {
-    const CParserToken &tkn = (*itCurrent)(bNext ? CParserToken::TKN_COMMA : CParserToken::TKN_VALUE);
+  while (it != aTokens.end() && it->GetType() != CParserToken::TKN_GROUP_CLOSE) {
+    // Values are separated by commas
+    if (!aValues.empty()) {
+      (*(it++))(CParserToken::TKN_COMMA);
 
-    // Add one value
-    if (!bNext) {
-      aValues.push_back(tkn.GetValue());
+      // Reached the array end right after a comma
+      if (it == aTokens.end() || it->GetType() == CParserToken::TKN_GROUP_CLOSE) {
+        break;
+      }
     }
 
-    bNext = !bNext;
-    ++itCurrent;
+    // Add one value
+    aValues.push_back(CVariant());
+    BuildValue(aValues.back(), aTokens, it, pShapes);
+
+    ++it;
+  }
+
+  // Unclosed array (report at the opening bracket, since there may be nothing after it)
+  if (it == aTokens.end()) {
+    throw CTokenException((itStart - 1)->GetTokenPos(), "Unclosed array");
   }
 
-  aArray.FromArray(aValues);
+  // Take over the built array instead of copying it
+  aArray.FromArray(CValArray());
+  aArray.ToArray().swap(aValues);
 };
 
 // Build a JSON object
-void BuildObject(CVariant &valObject, const CTokenList &aTokens, CTokenList::const_iterator &it) {
-  const CTokenList::const_iterator itStart = it;
+template<typename TokenList>
+void BuildObject(CVariant &valObject, const TokenList &aTokens, typename TokenList::const_iterator &it, CObjectShapeCache *pShapes) {
+  const typename TokenList::const_iterator itStart = it;
 
-  CValObject oValues;
-  bool bNext = false; // Search for the next array entry
+  std::vector<CHashedString> aKeys;
+  CValObject::Values_t aValues;
+  unordered_map<u64, u32> mapKeys; // Key lookup for large objects
 
-  while (it != aTokens.end()) {
-    // The next token should be a key string
-    if (!bNext) {
-      // Add one key-value pair
-      CValPair pair;
-      BuildPair(pair, aTokens, it);
-
-      oValues.insert(pair);
-      ++it;
-
-    // The next token should be a comma
-    } else {
+  while (it != aTokens.end() && it->GetType() != CParserToken::TKN_BLOCK_CLOSE) {
+    // Pairs are separated by commas
+    if (!aKeys.empty()) {
       (*(it++))(CParserToken::TKN_COMMA);
 
       // Reached the block end right after a comma
-      if (it->GetType() == CParserToken::TKN_BLOCK_CLOSE) {
+      if (it == aTokens.end() || it->GetType() == CParserToken::TKN_BLOCK_CLOSE) {
         break;
       }
     }
 
-    bNext = !bNext;
+    // Add one key-value pair
+    CValPair pair;
+    BuildPair(pair, aTokens, it, pShapes);
+
+    ++it;
+
+    // Keep the first value of a repeating key
+    const size_t ctKeys = aKeys.size();
+    bool bRepeated = false;
+
+    if (ctKeys < 16) {
+      for (size_t i = 0; i < ctKeys && !bRepeated; ++i) {
+        bRepeated = (aKeys[i] == pair.first);
+      }
+
+    } else {
+      // Start indexing keys once there are enough of them
+      if (mapKeys.empty()) {
+        for (size_t i = 0; i < ctKeys; ++i) {
+          mapKeys.insert(std::make_pair(aKeys[i].GetHash(), (u32)i));
+        }
+      }
+
+      bRepeated = !mapKeys.insert(std::make_pair(pair.first.GetHash(), (u32)ctKeys)).second;
+    }
+
+    if (bRepeated) continue;
+
+    // Move the built value into the object instead of copying it
+    aKeys.push_back(CHashedString());
+    aKeys.back().Swap(pair.first);
+
+    aValues.push_back(CVariant());
+    aValues.back().Swap(pair.second);
   }
 
-  // Unclosed object
+  // Unclosed object (report at the opening brace, since there may be nothing after it)
   if (it == aTokens.end()) {
-    throw CTokenException(itStart->GetTokenPos(), "Unclosed object");
+    throw CTokenException((itStart - 1)->GetTokenPos(), "Unclosed object");
+  }
+
+  valObject.FromObject(CValObject());
+  if (aKeys.empty()) return;
+
+  // Objects with the same keys share them
+  CObjectShape *pShape;
+
+  if (pShapes != nullptr) {
+    pShape = pShapes->Intern(&aKeys[0], aKeys.size());
+  } else {
+    pShape = new CObjectShape(&aKeys[0], aKeys.size());
   }
 
-  valObject.FromObject(oValues);
+  // Take over the built values instead of copying them
+  valObject.ToObject().Assign(pShape, aValues);
+  pShape->Release();
 };
 
 // Build one value
-void BuildValue(CVariant &val, const CTokenList &aTokens, CTokenList::const_iterator &it) {
+template<typename TokenList>
+void BuildValue(CVariant &val, const TokenList &aTokens, typename TokenList::const_iterator &it, CObjectShapeCache *pShapes) {
   const u32 iToken = it->GetType();
 
   switch (iToken) {
     // Object with variables {}
     case CParserToken::TKN_BLOCK_OPEN:
-      BuildObject(val, aTokens, ++it);
+      BuildObject(val, aTokens, ++it, pShapes);
       return;
 
     // Array of values []
     case CParserToken::TKN_GROUP_OPEN:
-      BuildArray(val, ++it, aTokens.end());
+      BuildArray(val, aTokens, ++it, pShapes);
       return;
 
     // Pure value
@@ -150,24 +200,26 @@ void BuildValue(CVariant &val, const CTokenList &aTokens, CTokenList::const_iter
       val = it->GetValue();
       return;
 
-    // Value beginning with a unary operator
+    // Number after a unary operator
     case CParserToken::TKN_ADD:
     case CParserToken::TKN_SUB: {
-      switch (it->GetValue().GetType()) {
-        case CVariant::VAL_INT: {
-          s64 iNumber = it->GetValue().ToInt();
-          val.FromInt(iToken == CParserToken::TKN_SUB ? -iNumber : iNumber);
-        }
+      const CParserToken &tknSign = *(it++);
+      const bool bNegate = (iToken == CParserToken::TKN_SUB);
 
-        case CVariant::VAL_FLOAT: {
-          f64 fNumber = it->GetValue().ToFloat();
-          val.FromFloat(iToken == CParserToken::TKN_SUB ? -fNumber : fNumber);
-        }
+      if (it != aTokens.end() && it->GetType() == CParserToken::TKN_VALUE) {
+        const CVariant &valNumber = it->GetValue();
+
+        if (valNumber.GetType() == CVariant::VAL_INT) {
+          val.FromInt(bNegate ? -valNumber.ToInt() : valNumber.ToInt());
+          return;
 
-        // Not a number
-        default:
-          throw CTokenException(it->GetTokenPos(), "Expected a number after the unary operator");
+        } else if (valNumber.GetType() == CVariant::VAL_FLOAT) {
+          val.FromFloat(bNegate ? -valNumber.ToFloat() : valNumber.ToFloat());
+          return;
+        }
       }
+
+      throw CTokenException(tknSign.GetTokenPos(), "Expected a number after the unary operator");
     }
 
     // Invalid token
@@ -177,40 +229,45 @@ void BuildValue(CVariant &val, const CTokenList &aTokens, CTokenList::const_iter
 };
 
 // Build one key-value pair
-void BuildPair(CValPair &pair, const CTokenList &aTokens, CTokenList::const_iterator &it) {
+template<typename TokenList>
+void BuildPair(CValPair &pair, const TokenList &aTokens, typename TokenList::const_iterator &it, CObjectShapeCache *pShapes) {
   // Key name ("key")
   const CParserToken &tknKey = (*(it++))(CParserToken::TKN_VALUE);
 
   // Not a string
   if (tknKey.GetValue().GetType() != CVariant::VAL_STRING) {
-    throw CTokenException(it->GetTokenPos(), "Expected a name string");
+    throw CTokenException(tknKey.GetTokenPos(), "Expected a name string");
   }
 
   // Key assignment ("key" : )
-  (*(it++))(CParserToken::TKN_COLON);
+  if (it == aTokens.end()) throw CTokenException(tknKey.GetTokenPos(), "Unclosed object");
+  const CParserToken &tknColon = (*(it++))(CParserToken::TKN_COLON);
 
-  // Build the value and make the pair
-  CHashedString hsKey(tknKey.GetValue().ToString());
-  CVariant val;
-  BuildValue(val, aTokens, it);
+  if (it == aTokens.end()) throw CTokenException(tknColon.GetTokenPos(), "Unclosed object");
 
-  pair = std::make_pair(hsKey, val);
+  // Build the value right inside the pair
+  pair.first = CHashedString(tknKey.GetValue().ToString());
+  BuildValue(pair.second, aTokens, it, pShapes);
 };
 
 // Build a tree of values from a tokenized JSON file
-void Build(CVariant &valJSON, const CTokenList &aTokens) {
+template<typename TokenList>
+void Build(CVariant &valJSON, const TokenList &aTokens) {
   // No tokens
   if (aTokens.size() == 0) {
     valJSON = CVariant();
     return;
   }
 
-  CTokenList::const_iterator it = aTokens.begin();
-  BuildValue(valJSON, aTokens, it);
+  // Share keys between objects within the same tree
+  CObjectShapeCache shapes;
+
+  typename TokenList::const_iterator it = aTokens.begin();
+  BuildValue(valJSON, aTokens, it, &shapes);
 };
 
 // Parse JSON string and output it in a variant with optional token list
-void Parse(CVariant &valJSON, CTokenList *paTokens, const CString &strJSON, const CValObject &oConstants) {
+void Parse(CVariant &valJSON, CTokenList *paTokens, const CStringView &strJSON, const CValObject &oConstants) {
   static CTokenList aTokenList;
 
   // Supply local token list if none specified
@@ -224,6 +281,29 @@ void Parse(CVariant &valJSON, CTokenList *paTokens, const CString &strJSON, cons
   Build(valJSON, *paTokens);
 };
 
+// Parse JSON string and output it in a variant while taking memory for temporary tokens from an allocator
+void Parse(CVariant &valJSON, IAllocator &allocTemp, const CStringView &strJSON, const CValObject &oConstants) {
+  CAllocTokenList aTokens((CTokenAllocator(&allocTemp)));
+
+  Tokenize(aTokens, strJSON, oConstants);
+  Build(valJSON, aTokens);
+};
+
+// Builders for default token lists and ones with a specific allocator
+template void Tokenize(CTokenList &, const CStringView &, const CValObject &);
+template void BuildArray(CVariant &, const CTokenList &, CTokenList::const_iterator &, CObjectShapeCache *);
+template void BuildObject(CVariant &, const CTokenList &, CTokenList::const_iterator &, CObjectShapeCache *);
+template void BuildValue(CVariant &, const CTokenList &, CTokenList::const_iterator &, CObjectShapeCache *);
+template void BuildPair(CValPair &, const CTokenList &, CTokenList::const_iterator &, CObjectShapeCache *);
+template void Build(CVariant &, const CTokenList &);
+
+template void Tokenize(CAllocTokenList &, const CStringView &, const CValObject &);
+template void BuildArray(CVariant &, const CAllocTokenList &, CAllocTokenList::const_iterator &, CObjectShapeCache *);
+template void BuildObject(CVariant &, const CAllocTokenList &, CAllocTokenList::const_iterator &, CObjectShapeCache *);
+template void BuildValue(CVariant &, const CAllocTokenList &, CAllocTokenList::const_iterator &, CObjectShapeCache *);
+template void BuildPair(CValPair &, const CAllocTokenList &, CAllocTokenList::const_iterator &, CObjectShapeCache *);
+template void Build(CVariant &, const CAllocTokenList &);
+
 }; // namespace json
 
 }; // namespace dreamy
@@ -28,25 +28,35 @@ struct Constants {
 extern const Constants _constants;
 
 // Tokenize JSON file contents
-void Tokenize(CTokenList &aTokens, const CString &strJSON, const CValObject &oConstants = _constants.list);
+template<typename TokenList>
+void Tokenize(TokenList &aTokens, const CStringView &strJSON, const CValObject &oConstants = _constants.list);
 
-// Build a JSON array
-void BuildArray(CVariant &aArray, CTokenList::const_iterator &itCurrent, CTokenList::const_iterator itEnd);
+// Build a JSON array starting right after its opening bracket
+template<typename TokenList>
+void BuildArray(CVariant &aArray, const TokenList &aTokens, typename TokenList::const_iterator &it, CObjectShapeCache *pShapes = nullptr);
 
-// Build a JSON object
-void BuildObject(CVariant &valObject, const CTokenList &aTokens, CTokenList::const_iterator &it);
+// Build a JSON object starting right after its opening brace
+// Objects with the same keys in the same order share them if there's a shape cache
+template<typename TokenList>
+void BuildObject(CVariant &valObject, const TokenList &aTokens, typename TokenList::const_iterator &it, CObjectShapeCache *pShapes = nullptr);
 
 // Build one value
-void BuildValue(CVariant &val, const CTokenList &aTokens, CTokenList::const_iterator &it);
+template<typename TokenList>
+void BuildValue(CVariant &val, const TokenList &aTokens, typename TokenList::const_iterator &it, CObjectShapeCache *pShapes = nullptr);
 
 // Build one key-value pair
-void BuildPair(CValPair &pair, const CTokenList &aTokens, CTokenList::const_iterator &it);
+template<typename TokenList>
+void BuildPair(CValPair &pair, const TokenList &aTokens, typename TokenList::const_iterator &it, CObjectShapeCache *pShapes = nullptr);
 
 // Build a tree of values from a tokenized JSON file
-void Build(CVariant &valJSON, const CTokenList &aTokens);
+template<typename TokenList>
+void Build(CVariant &valJSON, const TokenList &aTokens);
 
 // Parse JSON string and output it in a variant with optional token list
-void Parse(CVariant &valJSON, CTokenList *paTokens, const CString &strJSON, const CValObject &oConstants = _constants.list);
+void Parse(CVariant &valJSON, CTokenList *paTokens, const CStringView &strJSON, const CValObject &oConstants = _constants.list);
+
+// Parse JSON string and output it in a variant while taking memory for temporary tokens from an allocator
+void Parse(CVariant &valJSON, IAllocator &allocTemp, const CStringView &strJSON, const CValObject &oConstants = _constants.list);
 
 }; // namespace json
 
@@ -0,0 +1,363 @@
+//! This file is a part of Dreamy Utilities.
+//! Licensed under the MIT license (see LICENSE file).
+
+#include "JSONDocument.hpp"
+
+#include "../Hashing/SimpleHasher.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+namespace dreamy {
+
+namespace json {
+
+// Find object value under some key (nullptr if none)
+const CNode *CNode::Find(const CStringView &strKey) const {
+  CheckType(NODE_OBJECT);
+
+  CSimpleHasher hasher;
+  const u64 iHash = hasher(strKey.data(), strKey.length());
+
+  for (u32 i = 0; i < _ctSize; ++i) {
+    const CMember &member = _data.aMembers[i];
+
+    if (member.iKeyHash == iHash && member.GetKey() == strKey) {
+      return &member.val;
+    }
+  }
+
+  return nullptr;
+};
+
+// Find object value under some hashed key (nullptr if none)
+const CNode *CNode::Find(const CHashedString &strKey) const {
+  CheckType(NODE_OBJECT);
+
+  // Compare hashes only, like hashed strings do
+  const u64 iHash = strKey.GetHash();
+
+  for (u32 i = 0; i < _ctSize; ++i) {
+    if (_data.aMembers[i].iKeyHash == iHash) return &_data.aMembers[i].val;
+  }
+
+  return nullptr;
+};
+
+// Get object value under some key (null node if none)
+const CNode &CNode::Get(const CStringView &strKey) const {
+  static const CNode _nodeNull;
+
+  const CNode *pNode = Find(strKey);
+  return (pNode != nullptr) ? *pNode : _nodeNull;
+};
+
+// Make a copy of the value in a variant
+void CNode::ToVariant(CVariant &val) const {
+  CObjectShapeCache shapes;
+  ToVariant(val, shapes);
+};
+
+// Copy the value in a variant while sharing object keys
+void CNode::ToVariant(CVariant &val, CObjectShapeCache &shapes) const {
+  switch (_type) {
+    case NODE_NULL: val = CVariant(); return;
+    case NODE_BOOL: val.FromBool(_data.b); return;
+    case NODE_INT: val.FromInt(_data.i); return;
+    case NODE_FLOAT: val.FromFloat(_data.f); return;
+    case NODE_STRING: val.FromString(CString(_data.str, _ctSize)); return;
+
+    case NODE_ARRAY: {
+      CValArray aValues(_ctSize);
+
+      for (u32 i = 0; i < _ctSize; ++i) {
+        _data.aValues[i].ToVariant(aValues[i], shapes);
+      }
+
+      // Take over the array instead of copying it
+      val.FromArray(CValArray());
+      val.ToArray().swap(aValues);
+    } return;
+
+    case NODE_OBJECT: {
+      val.FromObject(CValObject());
+      if (_ctSize == 0) return;
+
+      std::vector<CHashedString> aKeys;
+      CValObject::Values_t aValues(_ctSize);
+      aKeys.reserve(_ctSize);
+
+      for (u32 i = 0; i < _ctSize; ++i) {
+        const CMember &member = _data.aMembers[i];
+
+        aKeys.push_back(CHashedString(CString(member.strKey, member.iKeyLength)));
+        member.val.ToVariant(aValues[i], shapes);
+      }
+
+      // Objects with the same keys share them
+      CObjectShape *pShape = shapes.Intern(&aKeys[0], aKeys.size());
+      val.ToObject().Assign(pShape, aValues);
+      pShape->Release();
+    } return;
+  }
+};
+
+// Constructor with a size of the first arena block
+CDocument::CDocument(size_t iFirstBlock) : _arena(iFirstBlock)
+{
+};
+
+// Parse JSON string and replace the document with it
+void CDocument::Parse(const CStringView &strJSON, const CValObject &oConstants) {
+  Clear();
+
+  _aTokens.clear();
+  _aValueStack.clear();
+  _aMemberStack.clear();
+
+  Tokenize(_aTokens, strJSON, oConstants);
+  if (_aTokens.size() == 0) return;
+
+  CTokenList::const_iterator it = _aTokens.begin();
+  CNode nodeRoot;
+
+  BuildNode(nodeRoot, _aTokens, it);
+  _root = nodeRoot;
+
+  // Tokens are only needed while building
+  _aTokens.clear();
+};
+
+// Remove all values while keeping memory for reuse
+void CDocument::Clear(void) {
+  _arena.Reset();
+  _root = CNode();
+};
+
+// Build one value
+void CDocument::BuildNode(CNode &node, const CTokenList &aTokens, CTokenList::const_iterator &it) {
+  const u32 iToken = it->GetType();
+
+  switch (iToken) {
+    // Object with variables {}
+    case CParserToken::TKN_BLOCK_OPEN:
+      BuildObject(node, aTokens, ++it);
+      return;
+
+    // Array of values []
+    case CParserToken::TKN_GROUP_OPEN:
+      BuildArray(node, aTokens, ++it);
+      return;
+
+    // Pure value
+    case CParserToken::TKN_VALUE:
+      SetValue(node, *it);
+      return;
+
+    // Number after a unary operator
+    case CParserToken::TKN_ADD:
+    case CParserToken::TKN_SUB: {
+      const CParserToken &tknSign = *(it++);
+      const bool bNegate = (iToken == CParserToken::TKN_SUB);
+
+      if (it != aTokens.end() && it->GetType() == CParserToken::TKN_VALUE) {
+        const CVariant &val = it->GetValue();
+
+        if (val.GetType() == CVariant::VAL_INT) {
+          node._type = CNode::NODE_INT;
+          node._data.i = bNegate ? -val.ToInt() : val.ToInt();
+          return;
+
+        } else if (val.GetType() == CVariant::VAL_FLOAT) {
+          node._type = CNode::NODE_FLOAT;
+          node._data.f = bNegate ? -val.ToFloat() : val.ToFloat();
+          return;
+        }
+      }
+
+      throw CTokenException(tknSign.GetTokenPos(), "Expected a number after the unary operator");
+    }
+
+    // Invalid token
+    default:
+      throw CTokenException(it->GetTokenPos(), "Expected an object, an array or a value");
+  }
+};
+
+// Build a JSON array
+void CDocument::BuildArray(CNode &node, const CTokenList &aTokens, CTokenList::const_iterator &it) {
+  const CTokenList::const_iterator itStart = it;
+  const size_t iFirst = _aValueStack.size();
+
+  while (it != aTokens.end() && it->GetType() != CParserToken::TKN_GROUP_CLOSE) {
+    // Values are separated by commas
+    if (_aValueStack.size() != iFirst) {
+      (*(it++))(CParserToken::TKN_COMMA);
+
+      // Reached the array end right after a comma
+      if (it == aTokens.end() || it->GetType() == CParserToken::TKN_GROUP_CLOSE) {
+        break;
+      }
+    }
+
+    // Build the value before adding it, since nested values use the same stack
+    CNode nodeValue;
+    BuildNode(nodeValue, aTokens, it);
+    _aValueStack.push_back(nodeValue);
+
+    ++it;
+  }
+
+  // Unclosed array (report at the opening bracket, since there may be nothing after it)
+  if (it == aTokens.end()) {
+    throw CTokenException((itStart - 1)->GetTokenPos(), "Unclosed array");
+  }
+
+  // Move values from the stack into one block
+  const size_t ctValues = _aValueStack.size() - iFirst;
+
+  node._type = CNode::NODE_ARRAY;
+  node._ctSize = (u32)ctValues;
+
+  if (ctValues != 0) {
+    CNode *aValues = (CNode *)Allocate(ctValues * sizeof(CNode), sizeof(s64));
+    std::copy(_aValueStack.begin() + iFirst, _aValueStack.end(), aValues);
+
+    node._data.aValues = aValues;
+    _aValueStack.erase(_aValueStack.begin() + iFirst, _aValueStack.end());
+  }
+};
+
+// Build a JSON object
+void CDocument::BuildObject(CNode &node, const CTokenList &aTokens, CTokenList::const_iterator &it) {
+  const CTokenList::const_iterator itStart = it;
+  const size_t iFirst = _aMemberStack.size();
+
+  unordered_map<u64, u32> mapKeys; // Key lookup for large objects
+
+  while (it != aTokens.end() && it->GetType() != CParserToken::TKN_BLOCK_CLOSE) {
+    const size_t ctMembers = _aMemberStack.size() - iFirst;
+
+    // Pairs are separated by commas
+    if (ctMembers != 0) {
+      (*(it++))(CParserToken::TKN_COMMA);
+
+      // Reached the block end right after a comma
+      if (it == aTokens.end() || it->GetType() == CParserToken::TKN_BLOCK_CLOSE) {
+        break;
+      }
+    }
+
+    // Key name ("key")
+    const CParserToken &tknKey = (*(it++))(CParserToken::TKN_VALUE);
+
+    if (tknKey.GetValue().GetType() != CVariant::VAL_STRING) {
+      throw CTokenException(tknKey.GetTokenPos(), "Expected a name string");
+    }
+
+    // Key assignment ("key" : )
+    if (it == aTokens.end()) throw CTokenException(tknKey.GetTokenPos(), "Unclosed object");
+    const CParserToken &tknColon = (*(it++))(CParserToken::TKN_COLON);
+
+    if (it == aTokens.end()) throw CTokenException(tknColon.GetTokenPos(), "Unclosed object");
+
+    CMember member;
+    BuildNode(member.val, aTokens, it);
+
+    ++it;
+
+    // Keep the first value of a repeating key
+    const CString &strKey = tknKey.GetValue().ToString();
+
+    CSimpleHasher hasher;
+    member.iKeyHash = hasher(strKey.c_str(), strKey.length());
+
+    bool bRepeated = false;
+
+    if (ctMembers < 16) {
+      for (size_t i = iFirst; i < iFirst + ctMembers && !bRepeated; ++i) {
+        bRepeated = (_aMemberStack[i].iKeyHash == member.iKeyHash);
+      }
+
+    } else {
+      // Start indexing keys once there are enough of them
+      if (mapKeys.empty()) {
+        for (size_t i = 0; i < ctMembers; ++i) {
+          mapKeys.insert(std::make_pair(_aMemberStack[iFirst + i].iKeyHash, (u32)i));
+        }
+      }
+
+      bRepeated = !mapKeys.insert(std::make_pair(member.iKeyHash, (u32)ctMembers)).second;
+    }
+
+    if (bRepeated) continue;
+
+    member.strKey = CopyString(strKey);
+    member.iKeyLength = (u32)strKey.length();
+    _aMemberStack.push_back(member);
+  }
+
+  // Unclosed object (report at the opening brace, since there may be nothing after it)
+  if (it == aTokens.end()) {
+    throw CTokenException((itStart - 1)->GetTokenPos(), "Unclosed object");
+  }
+
+  // Move members from the stack into one block
+  const size_t ctMembers = _aMemberStack.size() - iFirst;
+
+  node._type = CNode::NODE_OBJECT;
+  node._ctSize = (u32)ctMembers;
+
+  if (ctMembers != 0) {
+    CMember *aMembers = (CMember *)Allocate(ctMembers * sizeof(CMember), sizeof(s64));
+    std::copy(_aMemberStack.begin() + iFirst, _aMemberStack.end(), aMembers);
+
+    node._data.aMembers = aMembers;
+    _aMemberStack.erase(_aMemberStack.begin() + iFirst, _aMemberStack.end());
+  }
+};
+
+// Copy a token value into a node
+void CDocument::SetValue(CNode &node, const CParserToken &tkn) {
+  const CVariant &val = tkn.GetValue();
+
+  switch (val.GetType()) {
+    case CVariant::VAL_INVALID: node._type = CNode::NODE_NULL; return;
+    case CVariant::VAL_BOOL: node._type = CNode::NODE_BOOL; node._data.b = val.ToBool(); return;
+    case CVariant::VAL_INT: node._type = CNode::NODE_INT; node._data.i = val.ToInt(); return;
+    case CVariant::VAL_FLOAT: node._type = CNode::NODE_FLOAT; node._data.f = val.ToFloat(); return;
+
+    case CVariant::VAL_STRING: {
+      const CString &str = val.ToString();
+
+      node._type = CNode::NODE_STRING;
+      node._data.str = CopyString(str);
+      node._ctSize = (u32)str.length();
+    } return;
+
+    // Constants of other types
+    default:
+      throw CTokenException(tkn.GetTokenPos(), "Value of this type can't be stored in a JSON document");
+  }
+};
+
+// Copy a string into the arena
+const c8 *CDocument::CopyString(const CString &str) {
+  const size_t iLength = str.length();
+  c8 *strCopy = (c8 *)Allocate(iLength + 1, 1);
+
+  memcpy(strCopy, str.c_str(), iLength + 1);
+  return strCopy;
+};
+
+// Take memory from the arena
+void *CDocument::Allocate(size_t iSize, size_t iAlign) {
+  void *pMemory = _arena.Allocate(iSize, iAlign);
+  if (pMemory == nullptr) throw std::bad_alloc();
+
+  return pMemory;
+};
+
+}; // namespace json
+
+}; // namespace dreamy
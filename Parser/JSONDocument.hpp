@@ -0,0 +1,214 @@
+//! This file is a part of Dreamy Utilities.
+//! Licensed under the MIT license (see LICENSE file).
+
+#ifndef _DREAMYUTILITIES_INCL_JSONDOCUMENT_H
+#define _DREAMYUTILITIES_INCL_JSONDOCUMENT_H
+
+#include "../DreamyUtilitiesBase.hpp"
+
+#include "JSON.hpp"
+#include "../Data/Allocator.hpp"
+#include "../Types/StringView.hpp"
+
+#include <vector>
+
+namespace dreamy {
+
+namespace json {
+
+struct CMember;
+
+// Read-only value of a parsed JSON document
+// All memory belongs to the document, so nodes can't outlive it
+class CNode {
+  friend class CDocument;
+
+public:
+  // Value types
+  enum EType {
+    NODE_NULL,
+    NODE_BOOL,
+    NODE_INT,
+    NODE_FLOAT,
+    NODE_STRING,
+    NODE_ARRAY,
+    NODE_OBJECT,
+  };
+
+private:
+  // Value storage for each type
+  union Storage {
+    bool b; // NODE_BOOL
+    s64 i; // NODE_INT
+    f64 f; // NODE_FLOAT
+    const c8 *str; // NODE_STRING (null-terminated)
+    const CNode *aValues; // NODE_ARRAY
+    const CMember *aMembers; // NODE_OBJECT
+  };
+
+  Storage _data; // Actual value
+  EType _type; // Value type
+  u32 _ctSize; // Length of a string or amount of values in an array or an object
+
+public:
+  // Default constructor
+  CNode() : _type(NODE_NULL), _ctSize(0)
+  {
+    _data.i = 0;
+  };
+
+  // Get value type
+  inline EType GetType(void) const {
+    return _type;
+  };
+
+  // Check if there's no value
+  inline bool IsNull(void) const {
+    return _type == NODE_NULL;
+  };
+
+  inline bool ToBool(void) const {
+    CheckType(NODE_BOOL);
+    return _data.b;
+  };
+
+  inline s64 ToInt(void) const {
+    CheckType(NODE_INT);
+    return _data.i;
+  };
+
+  inline f64 ToFloat(void) const {
+    CheckType(NODE_FLOAT);
+    return _data.f;
+  };
+
+  inline CStringView ToString(void) const {
+    CheckType(NODE_STRING);
+    return CStringView(_data.str, _ctSize);
+  };
+
+  // Get amount of values in an array or an object or length of a string
+  inline size_t Size(void) const {
+    return _ctSize;
+  };
+
+  // Get array value at some index
+  inline const CNode &operator[](size_t i) const {
+    CheckType(NODE_ARRAY);
+    D_ASSERT(i < _ctSize);
+
+    return _data.aValues[i];
+  };
+
+  // Get object member at some index
+  const CMember &GetMember(size_t i) const;
+
+  // Find object value under some key (nullptr if none)
+  const CNode *Find(const CStringView &strKey) const;
+
+  // Find object value under some hashed key (nullptr if none)
+  const CNode *Find(const CHashedString &strKey) const;
+
+  // Find object value under some null-terminated key (nullptr if none)
+  inline const CNode *Find(const c8 *strKey) const {
+    return Find(CStringView(strKey));
+  };
+
+  // Get object value under some key (null node if none)
+  const CNode &Get(const CStringView &strKey) const;
+
+  // Make a copy of the value in a variant
+  void ToVariant(CVariant &val) const;
+
+private:
+  // Make sure the node is of a specific type
+  inline void CheckType(EType eType) const {
+    if (_type != eType) throw CBadAnyCastException();
+  };
+
+  // Copy the value in a variant while sharing object keys
+  void ToVariant(CVariant &val, CObjectShapeCache &shapes) const;
+};
+
+// Key-value pair of a JSON object
+struct CMember {
+  const c8 *strKey; // Null-terminated key
+  u32 iKeyLength;
+  u64 iKeyHash; // Same hash as in CHashedString
+  CNode val;
+
+  // Get the key
+  inline CStringView GetKey(void) const {
+    return CStringView(strKey, iKeyLength);
+  };
+};
+
+inline const CMember &CNode::GetMember(size_t i) const {
+  CheckType(NODE_OBJECT);
+  D_ASSERT(i < _ctSize);
+
+  return _data.aMembers[i];
+};
+
+// JSON document that keeps all of its values, strings, arrays and objects in an arena
+// Parsing only touches the heap for temporary tokens and the whole document is freed at once
+class CDocument {
+
+private:
+  CArenaAllocator _arena; // Memory of all nodes
+  CNode _root; // Topmost value
+
+  // Tokens and values of unfinished arrays and objects during parsing (kept for reuse)
+  CTokenList _aTokens;
+  std::vector<CNode> _aValueStack;
+  std::vector<CMember> _aMemberStack;
+
+public:
+  // Constructor with a size of the first arena block
+  CDocument(size_t iFirstBlock = CArenaAllocator::DEFAULT_BLOCK);
+
+  // Parse JSON string and replace the document with it
+  void Parse(const CStringView &strJSON, const CValObject &oConstants = _constants.list);
+
+  // Remove all values while keeping memory for reuse
+  void Clear(void);
+
+  // Get topmost value
+  inline const CNode &GetRoot(void) const {
+    return _root;
+  };
+
+  // Get amount of bytes used by values
+  inline size_t GetUsedMemory(void) const {
+    return _arena.Used();
+  };
+
+private:
+  // Build one value
+  void BuildNode(CNode &node, const CTokenList &aTokens, CTokenList::const_iterator &it);
+
+  // Build a JSON array
+  void BuildArray(CNode &node, const CTokenList &aTokens, CTokenList::const_iterator &it);
+
+  // Build a JSON object
+  void BuildObject(CNode &node, const CTokenList &aTokens, CTokenList::const_iterator &it);
+
+  // Copy a token value into a node
+  void SetValue(CNode &node, const CParserToken &tkn);
+
+  // Copy a string into the arena
+  const c8 *CopyString(const CString &str);
+
+  // Take memory from the arena
+  void *Allocate(size_t iSize, size_t iAlign);
+
+  // Copying is not allowed
+  CDocument(const CDocument &);
+  CDocument &operator=(const CDocument &);
+};
+
+}; // namespace json
+
+}; // namespace dreamy
+
+#endif // (Dreamy Utilities Include Guard)
@@ -0,0 +1,70 @@
+//! This file is a part of Dreamy Utilities.
+//! Licensed under the MIT license (see LICENSE file).
+
+#ifndef _DREAMYUTILITIES_INCL_NUMBERPARSER_H
+#define _DREAMYUTILITIES_INCL_NUMBERPARSER_H
+
+#include "../DreamyUtilitiesBase.hpp"
+
+#include "../Types/StringView.hpp"
+
+namespace dreamy {
+
+// Outcome of parsing a number from a range of characters
+class CNumberResult {
+
+public:
+  size_t ctChars; // Amount of parsed characters (0 if there was no number)
+  bool bOverflow; // Number didn't fit into the type and has been clamped
+
+public:
+  CNumberResult(size_t ctSetChars = 0, bool bSetOverflow = false) :
+    ctChars(ctSetChars), bOverflow(bSetOverflow) {};
+
+  // Check if there was a number at the beginning
+  inline bool IsNumber(void) const {
+    return ctChars != 0;
+  };
+
+  // Check if the entire range has been parsed into a number without overflowing
+  inline bool IsValid(size_t iLength) const {
+    return ctChars != 0 && ctChars == iLength && !bOverflow;
+  };
+};
+
+// Parse an unsigned decimal integer with an optional '+' sign
+CNumberResult ParseU64(const c8 *pch, size_t iLength, u64 &iValue);
+
+// Parse a signed decimal integer with an optional '+' or '-' sign
+CNumberResult ParseS64(const c8 *pch, size_t iLength, s64 &iValue);
+
+// Parse hexadecimal digits without a prefix
+CNumberResult ParseHex(const c8 *pch, size_t iLength, u64 &iValue);
+
+// Parse a real number in decimal or scientific notation with an optional sign (e.g. "-12.5e+3")
+// The result is correctly rounded regardless of the current locale
+CNumberResult ParseF64(const c8 *pch, size_t iLength, f64 &fValue);
+
+// Parse an unsigned decimal integer from a view
+inline CNumberResult ParseU64(const CStringView &str, u64 &iValue) {
+  return ParseU64(str.data(), str.length(), iValue);
+};
+
+// Parse a signed decimal integer from a view
+inline CNumberResult ParseS64(const CStringView &str, s64 &iValue) {
+  return ParseS64(str.data(), str.length(), iValue);
+};
+
+// Parse hexadecimal digits from a view
+inline CNumberResult ParseHex(const CStringView &str, u64 &iValue) {
+  return ParseHex(str.data(), str.length(), iValue);
+};
+
+// Parse a real number from a view
+inline CNumberResult ParseF64(const CStringView &str, f64 &fValue) {
+  return ParseF64(str.data(), str.length(), fValue);
+};
+
+}; // namespace dreamy
+
+#endif // (Dreamy Utilities Include Guard)
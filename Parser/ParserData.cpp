@@ -2,12 +2,14 @@
 //! Licensed under the MIT license (see LICENSE file).
 
 #include "ParserData.hpp"
+#include "NumberParser.hpp"
 
 namespace dreamy {
 
-CParserData::CParserData(const CString &strSet) : str(strSet), pchCur(&strSet[0]), pchNext(&strSet[1]),
+CParserData::CParserData(const CStringView &strSet) : str(strSet), pchCur(""), pchNext(""),
   iLineCur(0), iLineBeg(0), pos(0, 0, 0, 0)
 {
+  SetToCurrent();
 };
 
 void CParserData::Start(void) {
@@ -25,8 +27,11 @@ bool CParserData::AtEnd(void) {
 };
 
 void CParserData::SetToCurrent(void) {
-  pchCur = &str[pos.iLast];
-  pchNext = pchCur + 1;
+  // Point at a null character past the end, since the view isn't necessarily null-terminated
+  const u32 iLength = (u32)str.length();
+
+  pchCur = (pos.iLast < iLength) ? str.data() + pos.iLast : "";
+  pchNext = (pos.iLast + 1 < iLength) ? str.data() + pos.iLast + 1 : "";
 };
 
 void CParserData::Advance(u32 i) {
@@ -55,10 +60,11 @@ void CParserData::SetPosition(u32 iPos) {
 
 CString CParserData::ExtractString(u32 iBeginOffset) {
   iBeginOffset += pos.iFirst;
-  return str.substr(iBeginOffset, pos.iLast - iBeginOffset);
+  return CString(str.substr(iBeginOffset, pos.iLast - iBeginOffset));
 };
 
-void CParserData::AddEOF(CTokenList &aTokens) {
+template<typename TokenList>
+void CParserData::AddEOF(TokenList &aTokens) {
   const u32 iEndPos = (u32)str.length();
 
   pos = CTokenPos(iEndPos, iEndPos, -1, -1);
@@ -67,7 +73,8 @@ void CParserData::AddEOF(CTokenList &aTokens) {
   AddToken(aTokens, CParserToken::TKN_END, pos);
 };
 
-bool CParserData::ParseComments(CTokenList &aTokens, bool bTokenize) {
+template<typename TokenList>
+bool CParserData::ParseComments(TokenList &aTokens, bool bTokenize) {
   if (*pchCur != '/') {
     return false;
   }
@@ -101,12 +108,12 @@ bool CParserData::ParseComments(CTokenList &aTokens, bool bTokenize) {
     case '*': {
       // Skip until the comment closing
       while (!AtEnd()) {
-        if (str[pos.iLast + 0] == '*'
-          && str[pos.iLast + 1] == '/') {
+        if (CharAt(pos.iLast + 0) == '*'
+          && CharAt(pos.iLast + 1) == '/') {
           break;
 
         // Count lines
-        } else if (str[pos.iLast] == '\n') {
+        } else if (CharAt(pos.iLast) == '\n') {
           CountLine();
         }
 
@@ -132,7 +139,8 @@ bool CParserData::ParseComments(CTokenList &aTokens, bool bTokenize) {
   return false;
 };
 
-bool CParserData::ParseOperators(CTokenList &aTokens) {
+template<typename TokenList>
+bool CParserData::ParseOperators(TokenList &aTokens) {
   switch (*pchCur) {
     // Operators
     case '+': {
@@ -306,7 +314,8 @@ bool CParserData::ParseString(CString &str, const c8 chEnclosed) {
   return true;
 };
 
-bool CParserData::ParseCharSequences(CTokenList &aTokens, const c8 chString, const c8 chCharSeq) {
+template<typename TokenList>
+bool CParserData::ParseCharSequences(TokenList &aTokens, const c8 chString, const c8 chCharSeq) {
   CString str;
 
   // Add string
@@ -339,7 +348,15 @@ bool CParserData::ParseCharSequences(CTokenList &aTokens, const c8 chString, con
   return false;
 };
 
-bool CParserData::ParseNumbers(CTokenList &aTokens) {
+// Make sure that the entire number has been parsed
+void CParserData::CheckNumber(const CNumberResult &res, size_t ctChars) const {
+  if (!res.IsNumber() || res.ctChars != ctChars) {
+    throw CTokenException(pos, "Invalid number");
+  }
+};
+
+template<typename TokenList>
+bool CParserData::ParseNumbers(TokenList &aTokens) {
   if (*pchCur < '0' || *pchCur > '9') {
     return false;
   }
@@ -414,23 +431,36 @@ bool CParserData::ParseNumbers(CTokenList &aTokens) {
     bHexCheck = false;
   }
 
-  // Save the number
-  CString strString = ExtractString(0);
+  // Parse the number directly from the string
+  const c8 *pchNumber = str.data() + pos.iFirst;
+  const size_t ctNumber = pos.iLast - pos.iFirst;
 
   switch (ubType) {
     case 0: { // Integer
-      s64 iValue = strString.ToS64();
+      s64 iValue = 0;
+      const CNumberResult res = ParseS64(pchNumber, ctNumber, iValue);
+      CheckNumber(res, ctNumber);
+
+      // Too large for an integer
+      if (res.bOverflow) {
+        f64 fValue = 0.0;
+        CheckNumber(ParseF64(pchNumber, ctNumber, fValue), ctNumber);
+        AddToken(aTokens, CParserToken::TKN_VALUE, pos, fValue);
+        break;
+      }
+
       AddToken(aTokens, CParserToken::TKN_VALUE, pos, iValue);
     } break;
 
-    case 1: { // Hexadecimal integer
-      s64 iHexValue = 0;
-      sscanf_s(strString.c_str(), "%llx", &iHexValue);
-      AddToken(aTokens, CParserToken::TKN_VALUE, pos, iHexValue);
+    case 1: { // Hexadecimal integer after the prefix
+      u64 iHexValue = 0;
+      CheckNumber(ParseHex(pchNumber + 2, ctNumber - 2, iHexValue), ctNumber - 2);
+      AddToken(aTokens, CParserToken::TKN_VALUE, pos, s64(iHexValue));
     } break;
 
     default: { // Real number
-      f64 fValue = atof(strString.c_str());
+      f64 fValue = 0.0;
+      CheckNumber(ParseF64(pchNumber, ctNumber, fValue), ctNumber);
       AddToken(aTokens, CParserToken::TKN_VALUE, pos, fValue);
     } break;
   }
@@ -438,7 +468,8 @@ bool CParserData::ParseNumbers(CTokenList &aTokens) {
   return true;
 };
 
-bool CParserData::ParseIdentifiers(CTokenList &aTokens) {
+template<typename TokenList>
+bool CParserData::ParseIdentifiers(TokenList &aTokens) {
   // Start identifier names with an underscore or letters
   if (*pchCur == '_'
   || (*pchCur >= 'a' && *pchCur <= 'z')
@@ -469,7 +500,8 @@ bool CParserData::ParseIdentifiers(CTokenList &aTokens) {
   return false;
 };
 
-void TokenizeString(CTokenList &aTokens, const CString &str, bool bTokenizeComments) {
+template<typename TokenList>
+void TokenizeString(TokenList &aTokens, const CStringView &str, bool bTokenizeComments) {
   CParserData data(str);
 
   while (data.CanParse()) {
@@ -500,4 +532,21 @@ void TokenizeString(CTokenList &aTokens, const CString &str, bool bTokenizeComme
   data.AddEOF(aTokens);
 };
 
+// Tokenizers for default token lists and ones with a specific allocator
+template void CParserData::AddEOF(CTokenList &);
+template bool CParserData::ParseComments(CTokenList &, bool);
+template bool CParserData::ParseOperators(CTokenList &);
+template bool CParserData::ParseCharSequences(CTokenList &, const c8, const c8);
+template bool CParserData::ParseNumbers(CTokenList &);
+template bool CParserData::ParseIdentifiers(CTokenList &);
+template void TokenizeString(CTokenList &, const CStringView &, bool);
+
+template void CParserData::AddEOF(CAllocTokenList &);
+template bool CParserData::ParseComments(CAllocTokenList &, bool);
+template bool CParserData::ParseOperators(CAllocTokenList &);
+template bool CParserData::ParseCharSequences(CAllocTokenList &, const c8, const c8);
+template bool CParserData::ParseNumbers(CAllocTokenList &);
+template bool CParserData::ParseIdentifiers(CAllocTokenList &);
+template void TokenizeString(CAllocTokenList &, const CStringView &, bool);
+
 }; // namespace dreamy
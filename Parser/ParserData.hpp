@@ -8,6 +8,7 @@
 
 #include "Token.hpp"
 #include "../Types/String.hpp"
+#include "NumberParser.hpp"
 
 namespace dreamy {
 
@@ -15,8 +16,8 @@ namespace dreamy {
 class CParserData {
 
 public:
-  // String data
-  const CString str;
+  // String data (must outlive the parser)
+  const CStringView str;
 
   const c8 *pchCur; // Current character
   const c8 *pchNext; // Next character
@@ -28,8 +29,8 @@ public:
   CTokenPos pos; // Token beginning and end positions
 
 public:
-  // Default constructor
-  CParserData(const CString &strSet);
+  // Constructor from a view of the string
+  CParserData(const CStringView &strSet);
 
   // Start from a new character
   void Start(void);
@@ -52,36 +53,52 @@ public:
   // Set line and character position based on a character index
   void SetPosition(u32 iPos);
 
+  // Get character at some position or a null character past the end
+  inline c8 CharAt(u32 iPos) const {
+    return (iPos < (u32)str.length()) ? str.data()[iPos] : '\0';
+  };
+
   // Extract a part of the string within the [begin - current character] range
   CString ExtractString(u32 iBeginOffset);
 
+  // Make sure that the entire number has been parsed (throws CTokenException otherwise)
+  // Numbers that don't fit their type aren't errors and are clamped by the parser
+  void CheckNumber(const CNumberResult &res, size_t ctChars) const;
+
 // Parsing from the current character one time
 public:
 
   // Add end-of-file token at the very end
-  void AddEOF(CTokenList &aTokens);
+  template<typename TokenList>
+  void AddEOF(TokenList &aTokens);
 
   // Tokenize C/C++ styled comments
-  bool ParseComments(CTokenList &aTokens, bool bTokenize);
+  template<typename TokenList>
+  bool ParseComments(TokenList &aTokens, bool bTokenize);
 
   // Tokenize operators
-  bool ParseOperators(CTokenList &aTokens);
+  template<typename TokenList>
+  bool ParseOperators(TokenList &aTokens);
 
   // Parse a string enclosed within certain characters
   bool ParseString(CString &str, const c8 chEnclosed);
 
   // Tokenize character sequences
-  bool ParseCharSequences(CTokenList &aTokens, const c8 chString, const c8 chCharSeq);
+  template<typename TokenList>
+  bool ParseCharSequences(TokenList &aTokens, const c8 chString, const c8 chCharSeq);
 
   // Tokenize numbers
-  bool ParseNumbers(CTokenList &aTokens);
+  template<typename TokenList>
+  bool ParseNumbers(TokenList &aTokens);
 
   // Tokenize words
-  bool ParseIdentifiers(CTokenList &aTokens);
+  template<typename TokenList>
+  bool ParseIdentifiers(TokenList &aTokens);
 };
 
 // General tokenization of a string
-void TokenizeString(CTokenList &aTokens, const CString &str, bool bTokenizeComments = false);
+template<typename TokenList>
+void TokenizeString(TokenList &aTokens, const CStringView &str, bool bTokenizeComments = false);
 
 }; // namespace dreamy
 
@@ -6,8 +6,10 @@
 
 #include "../DreamyUtilitiesBase.hpp"
 
+#include "../Data/Allocator.hpp"
 #include "../Math/Algorithm.hpp"
 #include "../Types/Exception.hpp"
+#include "../Types/Format.hpp"
 #include "../Types/Variant.hpp"
 
 namespace dreamy {
@@ -35,7 +37,7 @@ public:
   };
 
   // Copy constructor
-  CTokenPos(const CTokenPos &posOther) {
+  CTokenPos(const CTokenPos &posOther) DREAMY_NOEXCEPT {
     operator=(posOther);
   };
 
@@ -57,7 +59,7 @@ public:
   };
 
   // Assignment
-  inline CTokenPos &operator=(const CTokenPos &posOther) {
+  inline CTokenPos &operator=(const CTokenPos &posOther) DREAMY_NOEXCEPT {
     iFirst = posOther.iFirst;
     iLast  = posOther.iLast;
     iLine  = posOther.iLine;
@@ -110,6 +112,17 @@ public:
 
     throw ex;
   };
+
+#if _DREAMY_CPP11
+  // Quick function for throwing token exceptions with a compiled format string
+  template<typename... Args>
+  static void ThrowF(const CTokenPos &pos, const CFormatString &fmt, const Args &... args) {
+    CTokenException ex(pos);
+    Format(ex._message, fmt, args...);
+
+    throw ex;
+  };
+#endif
 };
 
 // One token from a string
@@ -211,6 +224,14 @@ public:
   {
   };
 
+#if _DREAMY_CPP11
+  // Constructor with a value that's taken over
+  CParserToken(u32 iSetType, CTokenPos posSet, CVariant &&valSet)
+    : _type(iSetType), _pos(posSet), _val(std::move(valSet))
+  {
+  };
+#endif
+
   // Get token type
   inline u32 GetType(void) const {
     return _type;
@@ -268,15 +289,30 @@ public:
   };
 };
 
+// Allocator for token lists
+typedef CAllocatorAdapter<CParserToken> CTokenAllocator;
+
 // List of tokens
 typedef std::vector<CParserToken> CTokenList;
 
+// List of tokens that takes memory from a specific allocator
+typedef std::vector<CParserToken, CTokenAllocator> CAllocTokenList;
+
 // Add one parser token
-inline void AddToken(CTokenList &aTokens, u32 iType,
-                      const CTokenPos &pos, const CVariant &val = CVariant()) {
+template<typename TokenList> inline
+void AddToken(TokenList &aTokens, u32 iType,
+              const CTokenPos &pos, const CVariant &val = CVariant()) {
   aTokens.push_back(CParserToken(iType, pos, val));
 };
 
+#if _DREAMY_CPP11
+// Add one parser token with a value that's taken over
+template<typename TokenList> inline
+void AddToken(TokenList &aTokens, u32 iType, const CTokenPos &pos, CVariant &&val) {
+  aTokens.emplace_back(iType, pos, std::move(val));
+};
+#endif
+
 }; // namespace dreamy
 
 #endif // (Dreamy Utilities Include Guard)
@@ -9,12 +9,67 @@
 #include "Exception.hpp"
 
 #include <algorithm>
+#include <new>
 #include <typeinfo>
 
+#if _DREAMY_CPP11
+  #include <type_traits>
+  #include <utility>
+#endif
+
+// Maximum size of values that are stored inside CAny itself without allocating memory
+#if !defined(_DREAMY_ANY_INLINE)
+  #define _DREAMY_ANY_INLINE 16
+#endif
+
 namespace dreamy {
 
 #define ANY_TEMP template<typename Type>
 
+// Storage of values inside CAny
+union AnyInlineStorage {
+  void *pContent; // Value on the heap
+  c8 aInline[_DREAMY_ANY_INLINE]; // Small value
+  s64 iAlign;
+  f64 fAlign;
+};
+
+// Check if values of some type can be stored inside CAny and copied as raw bytes
+ANY_TEMP struct AnyInlineType {
+#if _DREAMY_CPP11
+  enum {
+    value = std::is_trivially_copyable<Type>::value
+         && sizeof(Type) <= _DREAMY_ANY_INLINE
+         && alignof(Type) <= alignof(AnyInlineStorage)
+  };
+#else
+  enum { value = false };
+#endif
+};
+
+#if !_DREAMY_CPP11
+  // Types that are known to be trivially copyable without type traits
+  #define ANY_INLINE_TYPE(_Type) template<> struct AnyInlineType<_Type> { enum { value = true }; }
+
+  ANY_INLINE_TYPE(bool);
+  ANY_INLINE_TYPE(c8); ANY_INLINE_TYPE(s8); ANY_INLINE_TYPE(u8);
+  ANY_INLINE_TYPE(s16); ANY_INLINE_TYPE(u16);
+  ANY_INLINE_TYPE(s32); ANY_INLINE_TYPE(u32);
+  ANY_INLINE_TYPE(long); ANY_INLINE_TYPE(unsigned long);
+  ANY_INLINE_TYPE(s64); ANY_INLINE_TYPE(u64);
+  ANY_INLINE_TYPE(f32); ANY_INLINE_TYPE(f64);
+
+  #undef ANY_INLINE_TYPE
+
+  ANY_TEMP struct AnyInlineType<Type *> {
+    enum { value = true };
+  };
+
+  ANY_TEMP struct AnyInlineType<const Type> {
+    enum { value = AnyInlineType<Type>::value };
+  };
+#endif
+
 // Type-safe container for single values of any type
 class CAny {
 
@@ -45,6 +100,13 @@ public:
       {
       };
 
+    #if _DREAMY_CPP11
+      // Constructor that takes over a value
+      CHolder(Type &&valSet) : _value(std::move(valSet))
+      {
+      };
+    #endif
+
       // Get value type
       virtual const std::type_info &GetType() const {
         return typeid(Type);
@@ -57,33 +119,71 @@ public:
   };
 
 public:
-  CPlaceholder *_content; // Currently held value
+  // Small trivially copyable values are stored inline and copied as raw bytes
+  // Other values are held on the heap in a CHolder
+  AnyInlineStorage _data;
+  const std::type_info *_pInlineType; // Type of the inline value (nullptr if it's on the heap)
 
 public:
   // Default constructor
-  CAny() : _content(nullptr)
+  CAny() : _pInlineType(nullptr)
   {
+    _data.pContent = nullptr;
   };
 
   // Constructor from a value of any type
-  ANY_TEMP CAny(const Type &valSet) : _content(new CHolder<Type>(valSet))
-  {
+  ANY_TEMP CAny(const Type &valSet) {
+    if (AnyInlineType<Type>::value) {
+      new (_data.aInline) Type(valSet);
+      _pInlineType = &typeid(Type);
+
+    } else {
+      _data.pContent = static_cast<CPlaceholder *>(new CHolder<Type>(valSet));
+      _pInlineType = nullptr;
+    }
   };
 
   // Copy constructor
-  CAny(const CAny &other) : _content(!other.IsEmpty() ? other._content->Clone() : nullptr)
+  CAny(const CAny &other) : _data(other._data), _pInlineType(other._pInlineType)
   {
+    if (!IsInline() && !IsEmpty()) _data.pContent = other.GetHeapContent()->Clone();
   };
 
+#if _DREAMY_CPP11
+  // Constructor that takes over a value of any type
+  template<typename Type, typename = typename std::enable_if<!std::is_same<typename std::decay<Type>::type, CAny>::value>::type>
+  CAny(Type &&valSet) {
+    typedef typename std::decay<Type>::type ValueType;
+
+    if (AnyInlineType<ValueType>::value) {
+      new (_data.aInline) ValueType(std::forward<Type>(valSet));
+      _pInlineType = &typeid(ValueType);
+
+    } else {
+      _data.pContent = static_cast<CPlaceholder *>(new CHolder<ValueType>(std::forward<Type>(valSet)));
+      _pInlineType = nullptr;
+    }
+  };
+
+  // Move constructor
+  CAny(CAny &&other) DREAMY_NOEXCEPT : _data(other._data), _pInlineType(other._pInlineType)
+  {
+    other._data.pContent = nullptr;
+    other._pInlineType = nullptr;
+  };
+#endif
+
   // Destructor
   ~CAny() {
-    delete _content;
+    // Inline values are trivially destructible
+    if (!IsInline()) delete GetHeapContent();
   };
 
 public:
   // Swap values
-  CAny &Swap(CAny &anyOther) {
-    std::swap(_content, anyOther._content);
+  CAny &Swap(CAny &anyOther) DREAMY_NOEXCEPT {
+    std::swap(_data, anyOther._data);
+    std::swap(_pInlineType, anyOther._pInlineType);
     return *this;
   };
 
@@ -99,14 +199,40 @@ public:
     return *this;
   };
 
+#if _DREAMY_CPP11
+  // Take over a value of a new type
+  template<typename Type, typename = typename std::enable_if<!std::is_same<typename std::decay<Type>::type, CAny>::value>::type>
+  CAny &operator=(Type &&valOther) {
+    CAny(std::forward<Type>(valOther)).Swap(*this);
+    return *this;
+  };
+
+  // Take over a value
+  CAny &operator=(CAny &&anyOther) DREAMY_NOEXCEPT {
+    CAny(std::move(anyOther)).Swap(*this);
+    return *this;
+  };
+#endif
+
   // Check if value is empty
   bool IsEmpty() const {
-    return _content == nullptr;
+    return _pInlineType == nullptr && _data.pContent == nullptr;
+  };
+
+  // Check if value is stored inline
+  bool IsInline() const {
+    return _pInlineType != nullptr;
   };
 
   // Get value type
   const std::type_info &GetType() const {
-    return !IsEmpty() ? _content->GetType() : typeid(void);
+    if (IsInline()) return *_pInlineType;
+    return !IsEmpty() ? GetHeapContent()->GetType() : typeid(void);
+  };
+
+  // Get value holder on the heap
+  CPlaceholder *GetHeapContent() const {
+    return static_cast<CPlaceholder *>(_data.pContent);
   };
 };
 
@@ -121,8 +247,14 @@ public:
 
 // Cast any value into a pointer to a typed value
 ANY_TEMP Type *AnyCast(CAny *pValue) {
-  return (pValue != nullptr && pValue->GetType() == typeid(Type)) ?
-          &static_cast<CAny::CHolder<Type> *>(pValue->_content)->_value : nullptr;
+  if (pValue == nullptr || pValue->GetType() != typeid(Type)) return nullptr;
+
+  // Values of the same type are always stored the same way
+  if (AnyInlineType<Type>::value) {
+    return reinterpret_cast<Type *>(pValue->_data.aInline);
+  }
+
+  return &static_cast<CAny::CHolder<Type> *>(pValue->GetHeapContent())->_value;
 };
 
 // Cast any value into a constant pointer to a typed value
@@ -2,19 +2,23 @@
 //! Licensed under the MIT license (see LICENSE file).
 
 #include "ByteArray.hpp"
+#include "StringView.hpp"
+#include "../Data/Allocator.hpp"
+#include "../Data/ByteSearch.hpp"
+#include "../Data/Encoding.hpp"
 
 namespace dreamy {
 
-CByteArray::CByteArray() : _pBuffer(nullptr), _iSize(0)
+CByteArray::CByteArray() : _pBuffer(nullptr), _iSize(0), _pAllocator(nullptr)
 {
 };
 
-CByteArray::CByteArray(const CByteArray &baOther) : _pBuffer(nullptr), _iSize(0)
+CByteArray::CByteArray(const CByteArray &baOther) : _pBuffer(nullptr), _iSize(0), _pAllocator(nullptr)
 {
   Copy(baOther);
 };
 
-CByteArray::CByteArray(const c8 *pData, size_t iSize) : _pBuffer(nullptr), _iSize(0)
+CByteArray::CByteArray(const c8 *pData, size_t iSize) : _pBuffer(nullptr), _iSize(0), _pAllocator(nullptr)
 {
   if (pData == nullptr) return;
 
@@ -29,7 +33,7 @@ CByteArray::CByteArray(const c8 *pData, size_t iSize) : _pBuffer(nullptr), _iSiz
   }
 };
 
-CByteArray::CByteArray(c8 chByte, size_t iSize) : _pBuffer(nullptr), _iSize(0)
+CByteArray::CByteArray(c8 chByte, size_t iSize) : _pBuffer(nullptr), _iSize(0), _pAllocator(nullptr)
 {
   if (iSize != 0) {
     Resize(iSize);
@@ -37,18 +41,134 @@ CByteArray::CByteArray(c8 chByte, size_t iSize) : _pBuffer(nullptr), _iSize(0)
   }
 };
 
+CByteArray::CByteArray(IAllocator *pAllocator) : _pBuffer(nullptr), _iSize(0), _pAllocator(pAllocator)
+{
+};
+
 CByteArray::~CByteArray() {
   Clear();
 };
 
-// Copy data from another byte array
+c8 *CByteArray::AllocateBuffer(size_t iSize) {
+  IAllocator *pAllocator = (_pAllocator != nullptr ? _pAllocator : &IAllocator::Heap());
+
+  const size_t iAllocated = sizeof(SharedHeader) + iSize + 1; // Header + size + terminator
+  c8 *pMemory = (c8 *)pAllocator->Allocate(iAllocated);
+
+  if (pMemory == nullptr) throw std::bad_alloc();
+
+  SharedHeader *pHeader = (SharedHeader *)pMemory;
+  pHeader->ctRefs = 1;
+  pHeader->pAllocator = pAllocator;
+  pHeader->iAllocated = iAllocated;
+
+  c8 *pBuffer = pMemory + sizeof(SharedHeader);
+  pBuffer[iSize] = '\0';
+
+  return pBuffer;
+};
+
+void CByteArray::ReleaseBuffer(void) {
+  if (_pBuffer == nullptr) return;
+
+  // Last one to use the buffer
+  if (!IsInline()) {
+    SharedHeader *pHeader = GetHeader();
+
+    if (AtomicDecrement(pHeader->ctRefs) == 0) {
+      pHeader->pAllocator->Free(pHeader, pHeader->iAllocated);
+    }
+  }
+
+  _pBuffer = nullptr;
+  _iSize = 0;
+};
+
+c8 *CByteArray::Splice(size_t iPos, size_t iRemove, size_t iInsert) {
+  const size_t iRightSize = _iSize - iPos - iRemove;
+  const size_t iNewSize = _iSize - iRemove + iInsert;
+
+  if (iNewSize == 0) {
+    Clear();
+    return nullptr;
+  }
+
+  // Fits into the inline storage
+  if (iNewSize <= _DREAMY_BYTEARRAY_INLINE) {
+    if (IsInline()) {
+      memmove(&_aInline[iPos + iInsert], &_aInline[iPos + iRemove], iRightSize);
+
+    } else {
+      // Copy both parts around the replaced bytes from the heap
+      if (_pBuffer != nullptr) {
+        memcpy(&_aInline[0], _pBuffer, iPos);
+        memcpy(&_aInline[iPos + iInsert], &_pBuffer[iPos + iRemove], iRightSize);
+      }
+
+      ReleaseBuffer();
+      _pBuffer = _aInline;
+    }
+
+    _iSize = iNewSize;
+    _pBuffer[iNewSize] = '\0';
+
+    return &_pBuffer[iPos];
+  }
+
+  // Replace bytes in a unique heap buffer of the same size
+  if (iInsert == iRemove && !IsInline() && !IsShared()) {
+    return &_pBuffer[iPos];
+  }
+
+  // Copy both parts around the replaced bytes into a new buffer
+  c8 *pNewData = AllocateBuffer(iNewSize);
+
+  if (_pBuffer != nullptr) {
+    memcpy(&pNewData[0], _pBuffer, iPos);
+    memcpy(&pNewData[iPos + iInsert], &_pBuffer[iPos + iRemove], iRightSize);
+  }
+
+  ReleaseBuffer();
+
+  _pBuffer = pNewData;
+  _iSize = iNewSize;
+
+  return &_pBuffer[iPos];
+};
+
+void CByteArray::Detach(void) {
+  if (!IsShared()) return;
+
+  c8 *pNewData = AllocateBuffer(_iSize);
+  memcpy(pNewData, _pBuffer, _iSize);
+
+  const size_t iSize = _iSize;
+  ReleaseBuffer();
+
+  _pBuffer = pNewData;
+  _iSize = iSize;
+};
+
+// Share data with another byte array
 void CByteArray::Copy(const CByteArray &baOther) {
+  // Already sharing
+  if (baOther._pBuffer == _pBuffer) return;
+
   Clear();
 
-  if (!baOther.IsNull() && baOther.Size() != 0) {
-    Resize(baOther.Size());
-    memcpy(_pBuffer, baOther.ConstData(), baOther.Size());
+  if (baOther.IsNull()) return;
+
+  // Small arrays are copied right away
+  if (baOther.IsInline()) {
+    memcpy(_aInline, baOther._aInline, baOther._iSize + 1);
+    _pBuffer = _aInline;
+
+  } else {
+    AtomicIncrement(baOther.GetHeader()->ctRefs);
+    _pBuffer = baOther._pBuffer;
   }
+
+  _iSize = baOther._iSize;
 };
 
 CByteArray &CByteArray::Insert(size_t iPos, const c8 *pData, size_t iSize) {
@@ -62,29 +182,21 @@ CByteArray &CByteArray::Insert(size_t iPos, const c8 *pData, size_t iSize) {
     iSize = strlen(pData);
   }
 
-  if (iPos > Size()) {
-    iPos = Size();
+  if (iSize == 0) {
+    return *this;
   }
 
-  // Allocate new buffer
-  size_t iNewSize = Size() + iSize;
-  c8 *pNewData = new c8[iNewSize + 1]; // Size + terminator
-  pNewData[iNewSize] = '\0';
-
-  // Copy first part of the source array
-  if (iPos != 0) {
-    memcpy(&pNewData[0], Data(), iPos);
+  // Inserting own bytes that may be moved
+  if (pData >= ConstData() && pData < ConstData() + Size()) {
+    CByteArray baCopy(pData, iSize);
+    return Insert(iPos, baCopy.ConstData(), iSize);
   }
 
-  memcpy(&pNewData[iPos], pData, iSize); // Copy data from another array
-  memcpy(&pNewData[iPos + iSize], &Data()[iPos], Size() - iPos); // Copy second part of the source array
-
-  // Delete old buffer
-  Clear();
-
-  _pBuffer = pNewData;
-  _iSize = iNewSize;
+  if (iPos > Size()) {
+    iPos = Size();
+  }
 
+  memcpy(Splice(iPos, 0, iSize), pData, iSize); // Copy data from another array
   return *this;
 };
 
@@ -98,25 +210,7 @@ CByteArray &CByteArray::Insert(size_t iPos, size_t iCount, c8 chByte) {
     iPos = Size();
   }
 
-  // Allocate new buffer
-  size_t iNewSize = Size() + iCount;
-  c8 *pNewData = new c8[iNewSize + 1]; // Size + terminator
-  pNewData[iNewSize] = '\0';
-
-  // Copy first part of source array
-  if (iPos != 0) {
-    memcpy(&pNewData[0], Data(), iPos);
-  }
-
-  memset(&pNewData[iPos], chByte, iCount); // Fill with bytes
-  memcpy(&pNewData[iPos + iCount], &Data()[iPos], Size() - iPos); // Copy second part of the source array
-
-  // Delete old buffer
-  Clear();
-
-  _pBuffer = pNewData;
-  _iSize = iNewSize;
-
+  memset(Splice(iPos, 0, iCount), chByte, iCount); // Fill with bytes
   return *this;
 };
 
@@ -131,46 +225,19 @@ CByteArray &CByteArray::Remove(size_t iPos, size_t iSize) {
     iSize = iMaxRemoval;
   }
 
-  size_t iNewSize = Size() - iSize;
-  size_t iRightSize = Size() - iSize - iPos;
-
-  if (iRightSize != 0) {
-    memcpy(&Data()[iPos], &Data()[iPos + iSize], iRightSize);
-  }
-
-  Resize(iNewSize);
+  Splice(iPos, iSize, 0);
   return *this;
 };
 
 void CByteArray::Resize(size_t iNewSize) {
-  if (iNewSize == 0) {
-    Clear();
-    return;
-  }
-
-  c8 *pNewData = new c8[iNewSize + 1]; // Size + terminator
-  pNewData[iNewSize] = '\0';
-
-  if (Data()) {
-    // Copy old data if enough space
-    if (iNewSize > Size()) {
-      if (_iSize != 0) {
-        memcpy(&pNewData[0], _pBuffer, _iSize);
-      }
-
-    // Copy reduced data
-    } else {
-      if (iNewSize != 0) {
-        memcpy(&pNewData[0], _pBuffer, iNewSize);
-      }
-    }
+  // Copy old data if enough space
+  if (iNewSize > Size()) {
+    Splice(Size(), 0, iNewSize - Size());
 
-    Clear(); // Delete old data
+  // Copy reduced data
+  } else {
+    Splice(iNewSize, Size() - iNewSize, 0);
   }
-
-  // Set new buffer
-  _pBuffer = pNewData;
-  _iSize = iNewSize;
 };
 
 void CByteArray::Chop(size_t iSize) {
@@ -182,12 +249,7 @@ void CByteArray::Chop(size_t iSize) {
 };
 
 void CByteArray::Clear(void) {
-  if (_pBuffer != nullptr) {
-    delete[] _pBuffer;
-
-    _pBuffer = nullptr;
-    _iSize = 0;
-  }
+  ReleaseBuffer();
 };
 
 c8 CByteArray::At(size_t i) const {
@@ -206,19 +268,13 @@ CByteArray &CByteArray::Fill(const c8 chByte, size_t iSize) {
     iSize = Size();
   }
 
-  memset(_pBuffer, chByte, iSize);
+  memset(Data(), chByte, iSize);
 
   return *this;
 };
 
 CByteArray &CByteArray::operator=(const CByteArray &baOther) {
-  Clear();
-
-  if (baOther.Size() != 0) {
-    Resize(baOther.Size());
-    memcpy(Data(), baOther.ConstData(), baOther.Size());
-  }
-
+  Copy(baOther);
   return *this;
 };
 
@@ -228,8 +284,8 @@ bool CByteArray::operator==(const CByteArray &baOther) const {
     return false;
   }
 
-  // Both are empty
-  if (IsNull() && baOther.IsNull()) {
+  // Both are empty or share the same data
+  if (ConstData() == baOther.ConstData()) {
     return true;
   }
 
@@ -257,15 +313,30 @@ bool CByteArray::operator==(const c8 *strOther) const {
   return memcmp(ConstData(), strOther, Size()) == 0;
 };
 
-void CByteArray::Swap(CByteArray &baOther) {
-  size_t iTempSize = Size();
-  c8 *pTempData = Data();
+void CByteArray::Swap(CByteArray &baOther) DREAMY_NOEXCEPT {
+  if (&baOther == this) return;
 
-  _iSize = baOther.Size();
-  _pBuffer = baOther.Data();
+  size_t iTempSize = _iSize;
+  c8 *pTempData = _pBuffer;
+
+  _iSize = baOther._iSize;
+  _pBuffer = baOther._pBuffer;
 
   baOther._iSize = iTempSize;
   baOther._pBuffer = pTempData;
+
+  IAllocator *pTempAllocator = _pAllocator;
+  _pAllocator = baOther._pAllocator;
+  baOther._pAllocator = pTempAllocator;
+
+  // Exchange inline storages and point at own ones
+  c8 aTempInline[_DREAMY_BYTEARRAY_INLINE + 1];
+  memcpy(aTempInline, _aInline, sizeof(aTempInline));
+  memcpy(_aInline, baOther._aInline, sizeof(aTempInline));
+  memcpy(baOther._aInline, aTempInline, sizeof(aTempInline));
+
+  if (_pBuffer == baOther._aInline) _pBuffer = _aInline;
+  if (baOther._pBuffer == _aInline) baOther._pBuffer = baOther._aInline;
 };
 
 bool CByteArray::StartsWith(const CByteArray &baOther) const {
@@ -330,85 +401,241 @@ bool CByteArray::EndsWith(const c8 *str) const {
   return memcmp(&ConstData()[iPos], str, iSize) == 0;
 };
 
-size_t CByteArray::IndexOf(const CByteArray &baOther, size_t iFrom) {
-  if (IsNull() || baOther.IsNull() || iFrom >= Size() || baOther.Size() > Size()) {
+size_t CByteArray::IndexOf(const CByteArray &baOther, size_t iFrom) const {
+  if (baOther.IsNull()) return NULL_POS;
+
+  return IndexOf(baOther.ConstData(), baOther.Size(), iFrom);
+};
+
+size_t CByteArray::IndexOf(c8 chByte, size_t iFrom) const {
+  if (IsNull() || iFrom >= Size()) {
     return NULL_POS;
   }
 
-  for (size_t i = 0; i < Size(); ++i) {
-    size_t iLeft = Size() - i;
+  const size_t iPos = FindByte(ConstData() + iFrom, Size() - iFrom, chByte);
+  return (iPos != NULL_POS) ? iFrom + iPos : NULL_POS;
+};
 
-    if (iLeft < baOther.Size()) {
-      return NULL_POS;
-    }
+size_t CByteArray::IndexOf(const c8 *str, size_t iFrom) const {
+  if (str == nullptr) return NULL_POS;
 
-    if (memcmp(&ConstData()[i], baOther.ConstData(), baOther.Size()) == 0) {
-      return i;
-    }
-  }
-
-  return NULL_POS;
+  return IndexOf(str, strlen(str), iFrom);
 };
 
-size_t CByteArray::IndexOf(c8 chByte, size_t iFrom) {
+size_t CByteArray::IndexOf(const c8 *pData, size_t iSize, size_t iFrom) const {
   if (IsNull() || iFrom >= Size()) {
     return NULL_POS;
   }
 
-  for (size_t i = iFrom; i < Size(); ++i) {
-    if (ConstData()[i] == chByte) {
-      return i;
-    }
-  }
+  const size_t iPos = FindBytes(ConstData() + iFrom, Size() - iFrom, pData, iSize);
+  return (iPos != NULL_POS) ? iFrom + iPos : NULL_POS;
+};
+
+size_t CByteArray::LastIndexOf(const CByteArray &baOther, size_t iFrom) const {
+  if (baOther.IsNull()) return NULL_POS;
+
+  return LastIndexOf(baOther.ConstData(), baOther.Size(), iFrom);
+};
+
+size_t CByteArray::LastIndexOf(c8 chByte, size_t iFrom) const {
+  if (IsNull()) return NULL_POS;
+
+  // Search up to and including the starting position
+  const size_t iEnd = (iFrom < Size()) ? iFrom + 1 : Size();
+  return FindLastByte(ConstData(), iEnd, chByte);
+};
+
+size_t CByteArray::LastIndexOf(const c8 *str, size_t iFrom) const {
+  if (str == nullptr) return NULL_POS;
 
-  return NULL_POS;
+  return LastIndexOf(str, strlen(str), iFrom);
 };
 
-size_t CByteArray::IndexOf(const c8 *str, size_t iFrom) {
-  if (IsNull() || str == nullptr || iFrom >= Size()) {
+size_t CByteArray::LastIndexOf(const c8 *pData, size_t iSize, size_t iFrom) const {
+  if (IsNull() || iSize > Size()) {
     return NULL_POS;
   }
 
-  size_t iSize = strlen(str);
+  // Occurence may begin at the starting position
+  const size_t iEnd = (iFrom < Size() - iSize) ? iFrom + iSize : Size();
+  return FindLastBytes(ConstData(), iEnd, pData, iSize);
+};
 
-  if (iSize > Size()) {
-    return NULL_POS;
+size_t CByteArray::Count(const CByteArray &baOther) const {
+  if (IsNull() || baOther.IsNull()) return 0;
+
+  return CountBytes(ConstData(), Size(), baOther.ConstData(), baOther.Size());
+};
+
+size_t CByteArray::Count(c8 chByte) const {
+  if (IsNull()) return 0;
+
+  return CountByte(ConstData(), Size(), chByte);
+};
+
+size_t CByteArray::Count(const c8 *str) const {
+  if (IsNull() || str == nullptr) return 0;
+
+  return CountBytes(ConstData(), Size(), str, strlen(str));
+};
+
+CByteArray CByteArray::ToHex(const c8 chDelimiter) const {
+  CByteArray baResult;
+  if (IsNull()) return baResult;
+
+  // Encode all bytes at once
+  if (chDelimiter == '\0') {
+    baResult.Resize(HexEncodedLength(Size()));
+    EncodeHex(baResult.Data(), ConstData(), Size());
+    return baResult;
   }
 
-  for (size_t i = iFrom; i < Size(); ++i) {
-    size_t iLeft = Size() - i;
+  static const c8 *strDigits = "0123456789ABCDEF";
+
+  size_t iLength = Size() * 3 - 1;
+  baResult.Resize(iLength);
+
+  c8 *pResult = baResult.Data();
+  size_t iElement = 0;
+
+  for (size_t i = 0; i < Size(); ++i) {
+    pResult[iElement++] = strDigits[(ConstData()[i] & 0xF0) >> 4];
+    pResult[iElement++] = strDigits[ConstData()[i] & 0x0F];
 
-    if (iLeft < iSize) {
-      return NULL_POS;
+    if ((i + 1) < Size()) {
+      pResult[iElement++] = chDelimiter;
     }
+  }
+
+  return baResult;
+};
 
-    if (memcmp(&ConstData()[i], str, iSize) == 0) {
-      return i;
+bool CByteArray::FromHex(const c8 *pch, size_t iLength, const c8 chDelimiter) {
+  // Decode into a separate array, since the source may be a part of this one
+  CByteArray baResult;
+
+  if (pch == nullptr) {
+    Clear();
+    return false;
+  }
+
+  if (iLength == NULL_POS) {
+    iLength = strlen(pch);
+  }
+
+  if (iLength != 0) {
+    // Decode all digits at once
+    if (chDelimiter == '\0') {
+      baResult.Resize(HexDecodedLength(iLength));
+
+      if (DecodeHex(baResult.Data(), pch, iLength) == NULL_POS) {
+        Clear();
+        return false;
+      }
+
+    // Pairs of digits between delimiters
+    } else {
+      if ((iLength + 1) % 3 != 0) {
+        Clear();
+        return false;
+      }
+
+      baResult.Resize((iLength + 1) / 3);
+      c8 *pResult = baResult.Data();
+
+      for (size_t i = 0; i < iLength; i += 3) {
+        if ((i + 2 < iLength && pch[i + 2] != chDelimiter) || DecodeHex(pResult++, pch + i, 2) == NULL_POS) {
+          Clear();
+          return false;
+        }
+      }
     }
   }
 
-  return NULL_POS;
+  Swap(baResult);
+  return true;
 };
 
-CByteArray CByteArray::ToHex(const c8 chDelimiter) const {
-  static const c8 *strDigits = "0123456789ABCDEF";
+CByteArray CByteArray::ToBase64(void) const {
+  CByteArray baResult;
+  if (IsNull()) return baResult;
 
-  size_t iLength = chDelimiter == '\0' ? Size() * 2 : (Size() * 3 - 1);
+  baResult.Resize(Base64EncodedLength(Size()));
+  EncodeBase64(baResult.Data(), ConstData(), Size());
 
-  CByteArray baResult('0', iLength);
+  return baResult;
+};
 
-  size_t iElement = 0;
+bool CByteArray::FromBase64(const c8 *pch, size_t iLength) {
+  // Decode into a separate array, since the source may be a part of this one
+  CByteArray baResult;
 
-  for (size_t i = 0; i < Size(); ++i) {
-    baResult.Data()[iElement++] = strDigits[(ConstData()[i] & 0xF0) >> 4];
-    baResult.Data()[iElement++] = strDigits[ConstData()[i] & 0x0F];
+  if (pch == nullptr) {
+    Clear();
+    return false;
+  }
 
-    if (chDelimiter != '\0' && (i + 1) < Size()) {
-      baResult.Data()[iElement++] = chDelimiter;
+  if (iLength == NULL_POS) {
+    iLength = strlen(pch);
+  }
+
+  if (iLength != 0) {
+    baResult.Resize(Base64DecodedLength(iLength));
+    const size_t iDecoded = DecodeBase64(baResult.Data(), pch, iLength);
+
+    if (iDecoded == NULL_POS) {
+      Clear();
+      return false;
     }
+
+    // Drop bytes that were reserved for padding
+    baResult.Resize(iDecoded);
   }
 
+  Swap(baResult);
+  return true;
+};
+
+CByteArray CByteArray::ToBase85(void) const {
+  CByteArray baResult;
+  if (IsNull()) return baResult;
+
+  baResult.Resize(Base85EncodedLength(Size()));
+  EncodeBase85(baResult.Data(), ConstData(), Size());
+
   return baResult;
 };
 
+bool CByteArray::FromBase85(const c8 *pch, size_t iLength) {
+  // Decode into a separate array, since the source may be a part of this one
+  CByteArray baResult;
+
+  if (pch == nullptr) {
+    Clear();
+    return false;
+  }
+
+  if (iLength == NULL_POS) {
+    iLength = strlen(pch);
+  }
+
+  if (iLength != 0) {
+    baResult.Resize(Base85DecodedLength(iLength));
+    const size_t iDecoded = DecodeBase85(baResult.Data(), pch, iLength);
+
+    if (iDecoded == NULL_POS) {
+      Clear();
+      return false;
+    }
+  }
+
+  Swap(baResult);
+  return true;
+};
+
+// Defined here so that string views don't need the full byte array definition
+CStringView::CStringView(const CByteArray &ba) : _pch(ba.IsNull() ? "" : ba.ConstData()), _iLength(ba.Size())
+{
+};
+
 }; // namespace dreamy
@@ -6,14 +6,34 @@
 
 #include "../DreamyUtilitiesBase.hpp"
 
+#include "../Data/Atomic.hpp"
+
+// Maximum amount of bytes that are stored inside the byte array itself without allocating memory
+#if !defined(_DREAMY_BYTEARRAY_INLINE)
+  #define _DREAMY_BYTEARRAY_INLINE 32
+#endif
+
 namespace dreamy {
 
+class IAllocator;
+
 // Class that reperesents array of bytes
+// Small arrays are stored inline and larger ones on the heap
+// Copies share the same heap buffer until one of them is modified (implicit sharing)
 class CByteArray {
 
 private:
-  c8 *_pBuffer;
+  // Header that precedes bytes of a buffer
+  struct SharedHeader {
+    AtomicCounter ctRefs; // Amount of byte arrays that share the buffer
+    IAllocator *pAllocator; // Allocator that the buffer came from
+    size_t iAllocated; // Size of the entire allocation
+  };
+
+  c8 *_pBuffer; // Inline storage or bytes right after the header
   size_t _iSize;
+  IAllocator *_pAllocator; // Allocator for new heap buffers (global heap if none)
+  c8 _aInline[_DREAMY_BYTEARRAY_INLINE + 1]; // Small array + terminator
 
 public:
   // Default constructor
@@ -28,10 +48,31 @@ public:
   // Constructor with a specific size
   CByteArray(c8 chByte, size_t iSize);
 
+  // Constructor with an allocator for heap buffers
+  explicit CByteArray(IAllocator *pAllocator);
+
+#if _DREAMY_CPP11
+  // Move constructor
+  CByteArray(CByteArray &&baOther) DREAMY_NOEXCEPT : _pBuffer(nullptr), _iSize(0), _pAllocator(nullptr)
+  {
+    Swap(baOther);
+  };
+
+  // Take data from another byte array
+  inline CByteArray &operator=(CByteArray &&baOther) DREAMY_NOEXCEPT {
+    if (&baOther != this) {
+      Clear();
+      Swap(baOther);
+    }
+
+    return *this;
+  };
+#endif
+
   // Destructor
   ~CByteArray();
 
-  // Copy data from another byte array
+  // Share data with another byte array
   void Copy(const CByteArray &baOther);
 
   // Return read-only array of data
@@ -39,11 +80,32 @@ public:
     return _pBuffer;
   };
 
-  // Return array of data
+  // Return array of data that can be modified
+  // Makes a unique copy of the data if it's shared with other byte arrays
   c8 *Data(void) {
+    if (IsShared()) Detach();
     return _pBuffer;
   };
 
+  // Check if data is shared with other byte arrays
+  inline bool IsShared(void) const {
+    return (_pBuffer != nullptr && !IsInline() && GetHeader()->ctRefs != 1);
+  };
+
+  // Make a unique copy of the data if it's shared
+  void Detach(void);
+
+  // Set allocator for new heap buffers (global heap if none)
+  // Current buffer stays where it is until it's reallocated
+  inline void SetAllocator(IAllocator *pAllocator) {
+    _pAllocator = pAllocator;
+  };
+
+  // Get allocator for new heap buffers (nullptr for the global heap)
+  inline IAllocator *GetAllocator(void) const {
+    return _pAllocator;
+  };
+
   // Insert another byte array at a specified position
   inline CByteArray &Insert(size_t iPos, const CByteArray &baOther) {
     // Insert as array of specified size
@@ -128,8 +190,8 @@ public:
     return !operator==(strOther);
   };
 
-  // Swap data with another byte array
-  void Swap(CByteArray &baOther);
+  // Swap data and allocators with another byte array
+  void Swap(CByteArray &baOther) DREAMY_NOEXCEPT;
 
   // Check if array starts with another byte array
   bool StartsWith(const CByteArray &baOther) const;
@@ -150,17 +212,59 @@ public:
   bool EndsWith(const c8 *str) const;
 
   // Return position of first occurence of byte array
-  size_t IndexOf(const CByteArray &baOther, size_t iFrom = 0);
+  size_t IndexOf(const CByteArray &baOther, size_t iFrom = 0) const;
 
   // Return position of the first occurence of a byte
-  size_t IndexOf(c8 chByte, size_t iFrom = 0);
+  size_t IndexOf(c8 chByte, size_t iFrom = 0) const;
 
   // Return position of first occurence of string
-  size_t IndexOf(const c8 *str, size_t iFrom = 0);
+  size_t IndexOf(const c8 *str, size_t iFrom = 0) const;
+
+  // Return position of first occurence of a sequence of bytes
+  size_t IndexOf(const c8 *pData, size_t iSize, size_t iFrom) const;
+
+  // Return position of last occurence of byte array that begins at or before a certain position
+  size_t LastIndexOf(const CByteArray &baOther, size_t iFrom = NULL_POS) const;
+
+  // Return position of the last occurence of a byte at or before a certain position
+  size_t LastIndexOf(c8 chByte, size_t iFrom = NULL_POS) const;
+
+  // Return position of last occurence of string that begins at or before a certain position
+  size_t LastIndexOf(const c8 *str, size_t iFrom = NULL_POS) const;
+
+  // Return position of last occurence of a sequence of bytes that begins at or before a certain position
+  size_t LastIndexOf(const c8 *pData, size_t iSize, size_t iFrom) const;
+
+  // Count non-overlapping occurences of byte array
+  size_t Count(const CByteArray &baOther) const;
+
+  // Count occurences of a byte
+  size_t Count(c8 chByte) const;
+
+  // Count non-overlapping occurences of string
+  size_t Count(const c8 *str) const;
 
   // Return HEX-encoded copy of the array
   CByteArray ToHex(const c8 chDelimiter = '\0') const;
 
+  // Replace contents with bytes decoded from HEX digits that may be separated by a delimiter
+  // Returns false and leaves the array empty if the text is invalid
+  bool FromHex(const c8 *pch, size_t iLength = NULL_POS, const c8 chDelimiter = '\0');
+
+  // Return base64-encoded copy of the array
+  CByteArray ToBase64(void) const;
+
+  // Replace contents with bytes decoded from base64 text
+  // Returns false and leaves the array empty if the text is invalid
+  bool FromBase64(const c8 *pch, size_t iLength = NULL_POS);
+
+  // Return base85-encoded copy of the array (RFC 1924 alphabet)
+  CByteArray ToBase85(void) const;
+
+  // Replace contents with bytes decoded from base85 text
+  // Returns false and leaves the array empty if the text is invalid
+  bool FromBase85(const c8 *pch, size_t iLength = NULL_POS);
+
 // Method wrappers
 public:
 
@@ -205,19 +309,39 @@ public:
   };
 
   // Check if array contains a certain byte
-  inline bool Contains(const c8 chByte) {
+  inline bool Contains(const c8 chByte) const {
     return (IndexOf(chByte, 0) != NULL_POS);
   };
 
   // Check if array contains a sequence from another array
-  inline bool Contains(const CByteArray &baOther) {
+  inline bool Contains(const CByteArray &baOther) const {
     return (IndexOf(baOther, 0) != NULL_POS);
   };
 
   // Check if array contains a string
-  inline bool Contains(const c8 *str) {
+  inline bool Contains(const c8 *str) const {
     return (IndexOf(str, 0) != NULL_POS);
   };
+
+private:
+  // Check if bytes are stored inside the byte array
+  inline bool IsInline(void) const {
+    return (_pBuffer == _aInline);
+  };
+
+  // Get header of the current heap buffer
+  inline SharedHeader *GetHeader(void) const {
+    return (SharedHeader *)_pBuffer - 1;
+  };
+
+  // Allocate a new unshared heap buffer with a terminator after the bytes
+  c8 *AllocateBuffer(size_t iSize);
+
+  // Stop using the current buffer and delete it if no one else uses it
+  void ReleaseBuffer(void);
+
+  // Replace some bytes at a position with uninitialized ones in a unique buffer and return where they begin
+  c8 *Splice(size_t iPos, size_t iRemove, size_t iInsert);
 };
 
 }; // namespace dreamy
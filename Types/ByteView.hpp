@@ -0,0 +1,197 @@
+//! This file is a part of Dreamy Utilities.
+//! Licensed under the MIT license (see LICENSE file).
+
+#ifndef _DREAMYUTILITIES_INCL_BYTEVIEW_H
+#define _DREAMYUTILITIES_INCL_BYTEVIEW_H
+
+#include "../DreamyUtilitiesBase.hpp"
+
+#include "ByteArray.hpp"
+#include "StringView.hpp"
+#include "../Data/ByteSearch.hpp"
+
+#include <string>
+
+namespace dreamy {
+
+// Non-owning view of an array of bytes
+// Mirrors read-only methods of CByteArray without copying any data
+class CByteView {
+
+private:
+  const c8 *_pData;
+  size_t _iSize;
+
+public:
+  // Empty view
+  CByteView() : _pData(""), _iSize(0) {};
+
+  // View of a raw array
+  CByteView(const c8 *pData, size_t iSize) : _pData(pData), _iSize(iSize) {};
+
+  // View of a null-terminated string without the terminator
+  CByteView(const c8 *str) : _pData(str), _iSize(strlen(str)) {};
+
+  // View of a byte array
+  CByteView(const CByteArray &ba) : _pData(ba.IsNull() ? "" : ba.ConstData()), _iSize(ba.Size()) {};
+
+  // View of a string
+  CByteView(const std::string &str) : _pData(str.data()), _iSize(str.length()) {};
+
+  // View of a string view
+  CByteView(const CStringView &str) : _pData(str.data()), _iSize(str.length()) {};
+
+  // Get pointer to the first byte
+  inline const c8 *Data(void) const {
+    return _pData;
+  };
+
+  // Get amount of bytes
+  inline size_t Size(void) const {
+    return _iSize;
+  };
+
+  // Check if there are no bytes
+  inline bool IsEmpty(void) const {
+    return _iSize == 0;
+  };
+
+  inline const c8 *begin(void) const {
+    return _pData;
+  };
+
+  inline const c8 *end(void) const {
+    return _pData + _iSize;
+  };
+
+  // Return byte at a position
+  inline c8 operator[](size_t i) const {
+    D_ASSERT(i < _iSize);
+    return _pData[i];
+  };
+
+  // Return first byte
+  inline c8 Front(void) const {
+    return _pData[0];
+  };
+
+  // Return last byte
+  inline c8 Back(void) const {
+    return _pData[_iSize - 1];
+  };
+
+  // Get part of the view starting at some position
+  inline CByteView Sub(size_t iPos, size_t iSize = NULL_POS) const {
+    D_ASSERT(iPos <= _iSize);
+
+    const size_t iRest = _iSize - iPos;
+    return CByteView(_pData + iPos, (iSize < iRest) ? iSize : iRest);
+  };
+
+  // Get the same bytes as characters
+  inline CStringView ToString(void) const {
+    return CStringView(_pData, _iSize);
+  };
+
+  // Make a copy of the bytes
+  inline CByteArray ToArray(void) const {
+    return CByteArray(_pData, _iSize);
+  };
+
+  // Check if view starts with a sequence of bytes
+  inline bool StartsWith(const CByteView &other) const {
+    return other._iSize <= _iSize && memcmp(_pData, other._pData, other._iSize) == 0;
+  };
+
+  // Check if view starts with a specified byte
+  inline bool StartsWith(const c8 chByte) const {
+    return _iSize != 0 && Front() == chByte;
+  };
+
+  // Check if view ends with a sequence of bytes
+  inline bool EndsWith(const CByteView &other) const {
+    return other._iSize <= _iSize && memcmp(_pData + _iSize - other._iSize, other._pData, other._iSize) == 0;
+  };
+
+  // Check if view ends with a specified byte
+  inline bool EndsWith(const c8 chByte) const {
+    return _iSize != 0 && Back() == chByte;
+  };
+
+  // Return position of the first occurence of a sequence of bytes
+  inline size_t IndexOf(const CByteView &other, size_t iFrom = 0) const {
+    if (iFrom > _iSize) return NULL_POS;
+
+    const size_t iPos = FindBytes(_pData + iFrom, _iSize - iFrom, other._pData, other._iSize);
+    return (iPos != NULL_POS) ? iFrom + iPos : NULL_POS;
+  };
+
+  // Return position of the first occurence of a byte
+  inline size_t IndexOf(c8 chByte, size_t iFrom = 0) const {
+    if (iFrom >= _iSize) return NULL_POS;
+
+    const size_t iPos = FindByte(_pData + iFrom, _iSize - iFrom, chByte);
+    return (iPos != NULL_POS) ? iFrom + iPos : NULL_POS;
+  };
+
+  // Return position of the last occurence of a sequence of bytes that begins at or before a certain position
+  inline size_t LastIndexOf(const CByteView &other, size_t iFrom = NULL_POS) const {
+    if (other._iSize > _iSize) return NULL_POS;
+
+    const size_t iEnd = (iFrom < _iSize - other._iSize) ? iFrom + other._iSize : _iSize;
+    return FindLastBytes(_pData, iEnd, other._pData, other._iSize);
+  };
+
+  // Return position of the last occurence of a byte at or before a certain position
+  inline size_t LastIndexOf(c8 chByte, size_t iFrom = NULL_POS) const {
+    return FindLastByte(_pData, (iFrom < _iSize) ? iFrom + 1 : _iSize, chByte);
+  };
+
+  // Count non-overlapping occurences of a sequence of bytes
+  inline size_t Count(const CByteView &other) const {
+    return CountBytes(_pData, _iSize, other._pData, other._iSize);
+  };
+
+  // Count occurences of a byte
+  inline size_t Count(c8 chByte) const {
+    return CountByte(_pData, _iSize, chByte);
+  };
+
+  // Check if view contains a sequence of bytes
+  inline bool Contains(const CByteView &other) const {
+    return IndexOf(other) != NULL_POS;
+  };
+
+  // Check if view contains a certain byte
+  inline bool Contains(const c8 chByte) const {
+    return IndexOf(chByte) != NULL_POS;
+  };
+
+  // Compare bytes lexicographically (negative if this view goes first)
+  inline int Compare(const CByteView &other) const {
+    const size_t iMin = (_iSize < other._iSize) ? _iSize : other._iSize;
+    const int iCompare = memcmp(_pData, other._pData, iMin);
+
+    if (iCompare != 0) return iCompare;
+    return (_iSize < other._iSize) ? -1 : (_iSize > other._iSize);
+  };
+
+  // Equality comparison
+  inline bool operator==(const CByteView &other) const {
+    return _iSize == other._iSize && memcmp(_pData, other._pData, _iSize) == 0;
+  };
+
+  // Inequality comparison
+  inline bool operator!=(const CByteView &other) const {
+    return !operator==(other);
+  };
+
+  // Ordering comparison
+  inline bool operator<(const CByteView &other) const {
+    return Compare(other) < 0;
+  };
+};
+
+}; // namespace dreamy
+
+#endif // (Dreamy Utilities Include Guard)
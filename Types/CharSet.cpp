@@ -0,0 +1,61 @@
+//! This file is a part of Dreamy Utilities.
+//! Licensed under the MIT license (see LICENSE file).
+
+#include "CharSet.hpp"
+#include "../Data/SIMD.hpp"
+
+namespace dreamy {
+
+#if _DREAMY_SIMD_DISPATCH
+
+// Find the first character from the set in 16-byte blocks
+// Each byte selects a bit row from the nibble tables using its low nibble and a bit within it using its high nibble
+DREAMY_TARGET_SSSE3
+static size_t FindFirst_SSSE3(const u8 *aLowNibbles, const u8 *aHighNibbles, const c8 *pch, size_t iLength, size_t &iScanned) {
+  const __m128i vLowTable = _mm_loadu_si128((const __m128i *)aLowNibbles);
+  const __m128i vHighTable = _mm_loadu_si128((const __m128i *)aHighNibbles);
+  const __m128i vBits = _mm_setr_epi8(1, 2, 4, 8, 16, 32, 64, -128, 1, 2, 4, 8, 16, 32, 64, -128);
+  const __m128i vNibble = _mm_set1_epi8(0x0F);
+  const __m128i vFlip = _mm_set1_epi8(-128);
+  const __m128i vZero = _mm_setzero_si128();
+
+  const size_t iVecLength = iLength & ~size_t(15);
+
+  for (size_t i = 0; i < iVecLength; i += 16) {
+    const __m128i v = _mm_loadu_si128((const __m128i *)(pch + i));
+
+    // Values with the top bit set produce zero in a shuffle, so each table only matches its own half
+    const __m128i vRows = _mm_or_si128(_mm_shuffle_epi8(vLowTable, v), _mm_shuffle_epi8(vHighTable, _mm_xor_si128(v, vFlip)));
+    const __m128i vColumns = _mm_shuffle_epi8(vBits, _mm_and_si128(_mm_srli_epi16(v, 4), vNibble));
+
+    const u32 iMask = ~u32(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_and_si128(vRows, vColumns), vZero))) & 0xFFFF;
+    if (iMask != 0) return i + LowestSetBit(iMask);
+  }
+
+  iScanned = iVecLength;
+  return NULL_POS;
+};
+
+#endif // _DREAMY_SIMD_DISPATCH
+
+size_t CCharSet::FindFirst(const c8 *pch, size_t iLength) const {
+  size_t i = 0;
+
+  if (_ctChars == 0) return NULL_POS;
+
+#if _DREAMY_SIMD_DISPATCH
+  if (iLength >= 16 && cpu::HasSSSE3()) {
+    const size_t iFound = FindFirst_SSSE3(_aLowNibbles, _aHighNibbles, pch, iLength, i);
+    if (iFound != NULL_POS) return iFound;
+  }
+#endif
+
+  // Remaining characters
+  for (; i < iLength; ++i) {
+    if (Contains(pch[i])) return i;
+  }
+
+  return NULL_POS;
+};
+
+}; // namespace dreamy
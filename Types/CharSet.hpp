@@ -0,0 +1,78 @@
+//! This file is a part of Dreamy Utilities.
+//! Licensed under the MIT license (see LICENSE file).
+
+#ifndef _DREAMYUTILITIES_INCL_CHARSET_H
+#define _DREAMYUTILITIES_INCL_CHARSET_H
+
+#include "../DreamyUtilitiesBase.hpp"
+
+namespace dreamy {
+
+// Set of byte values that can be searched for in character sequences
+class CCharSet {
+
+private:
+  // One bit per byte value, grouped by the low nibble of the value:
+  // bits of _aLowNibbles[i] are set for values 0x(0-7)i, bits of _aHighNibbles[i] for values 0x(8-F)i
+  u8 _aLowNibbles[16];
+  u8 _aHighNibbles[16];
+  u32 _ctChars;
+
+public:
+  // Empty set
+  CCharSet() : _ctChars(0) {
+    Clear();
+  };
+
+  // Set of characters from a null-terminated string
+  explicit CCharSet(const c8 *strChars) : _ctChars(0) {
+    Clear();
+    Add(strChars);
+  };
+
+  // Remove all characters
+  inline void Clear(void) {
+    memset(_aLowNibbles, 0, sizeof(_aLowNibbles));
+    memset(_aHighNibbles, 0, sizeof(_aHighNibbles));
+    _ctChars = 0;
+  };
+
+  // Add one character
+  inline void Add(c8 ch) {
+    if (Contains(ch)) return;
+
+    const u8 i = u8(ch);
+    u8 *aTable = (i & 0x80) ? _aHighNibbles : _aLowNibbles;
+    aTable[i & 0xF] |= u8(1 << ((i >> 4) & 7));
+    ++_ctChars;
+  };
+
+  // Add characters from a null-terminated string
+  inline void Add(const c8 *strChars) {
+    while (*strChars != '\0') Add(*strChars++);
+  };
+
+  // Add an inclusive range of characters
+  inline void AddRange(c8 chFirst, c8 chLast) {
+    for (u32 i = u8(chFirst); i <= u32(u8(chLast)); ++i) Add(c8(i));
+  };
+
+  // Check if the set has some character
+  inline bool Contains(c8 ch) const {
+    const u8 i = u8(ch);
+    const u8 *aTable = (i & 0x80) ? _aHighNibbles : _aLowNibbles;
+    return (aTable[i & 0xF] & (1 << ((i >> 4) & 7))) != 0;
+  };
+
+  // Get amount of characters in the set
+  inline size_t Count(void) const {
+    return _ctChars;
+  };
+
+  // Find position of the first character from the set or return NULL_POS
+  size_t FindFirst(const c8 *pch, size_t iLength) const;
+};
+
+}; // namespace dreamy
+
+#endif // (Dreamy Utilities Include Guard)
@@ -92,7 +92,7 @@ public:
   // Default constructor
   CFormattingException(size_t iSetChar) : _char(iSetChar)
   {
-    PrintF("Formatting exception at %ull", _char);
+    PrintF("Formatting exception at %u", (u32)_char);
   };
 
   // Get character position
@@ -0,0 +1,664 @@
+//! This file is a part of Dreamy Utilities.
+//! Licensed under the MIT license (see LICENSE file).
+
+#include "Format.hpp"
+#include "Exception.hpp"
+#include "../Math/BigUInt.hpp"
+
+namespace dreamy {
+
+// Pairs of decimal digits from 00 to 99
+static const c8 _aDigitPairs[201] =
+  "00010203040506070809"
+  "10111213141516171819"
+  "20212223242526272829"
+  "30313233343536373839"
+  "40414243444546474849"
+  "50515253545556575859"
+  "60616263646566676869"
+  "70717273747576777879"
+  "80818283848586878889"
+  "90919293949596979899";
+
+size_t FormatUInt(c8 *pBuffer, u64 i) {
+  // Print digits backwards into a temporary buffer, two at a time
+  c8 aDigits[20];
+  c8 *pch = aDigits + 20;
+
+  while (i >= 100) {
+    const u32 iPair = u32(i % 100) * 2;
+    i /= 100;
+
+    *--pch = _aDigitPairs[iPair + 1];
+    *--pch = _aDigitPairs[iPair];
+  }
+
+  if (i >= 10) {
+    const u32 iPair = u32(i) * 2;
+    *--pch = _aDigitPairs[iPair + 1];
+    *--pch = _aDigitPairs[iPair];
+
+  } else {
+    *--pch = c8('0' + i);
+  }
+
+  const size_t iLength = (aDigits + 20) - pch;
+  memcpy(pBuffer, pch, iLength);
+
+  return iLength;
+};
+
+size_t FormatInt(c8 *pBuffer, s64 i) {
+  if (i >= 0) return FormatUInt(pBuffer, u64(i));
+
+  // Negate as unsigned to handle the smallest value
+  *pBuffer = '-';
+  return FormatUInt(pBuffer + 1, u64(0) - u64(i)) + 1;
+};
+
+size_t FormatHex(c8 *pBuffer, u64 i, bool bUppercase) {
+  const c8 *strDigits = (bUppercase ? "0123456789ABCDEF" : "0123456789abcdef");
+
+  // Count digits
+  size_t iLength = 1;
+  for (u64 iRest = i >> 4; iRest != 0; iRest >>= 4) ++iLength;
+
+  for (size_t iDigit = iLength; iDigit > 0; --iDigit) {
+    pBuffer[iDigit - 1] = strDigits[i & 0xF];
+    i >>= 4;
+  }
+
+  return iLength;
+};
+
+// Output of a real number that stops writing at the end of the buffer but keeps counting characters
+struct SRealOutput {
+  c8 *pBuffer;
+  size_t iSize;
+  size_t iLength;
+
+  inline void Put(c8 ch) {
+    if (iLength + 1 < iSize) pBuffer[iLength] = ch;
+    ++iLength;
+  };
+
+  // Terminate written characters
+  inline void End(void) {
+    if (iSize != 0) pBuffer[(iLength < iSize) ? iLength : iSize - 1] = '\0';
+  };
+
+  inline void Put(const c8 *str) {
+    while (*str != '\0') Put(*str++);
+  };
+};
+
+// Source of exact decimal digits of a positive double
+class CRealDigits {
+
+private:
+  c8 _aInteger[320]; // Digits of the integer part
+  size_t _ctInteger;
+  size_t _iNextInteger;
+
+  CBigUInt _fraction; // Numerator of the fractional part
+  u32 _iFractionBits; // Power of two in the denominator
+
+public:
+  // Constructor from a mantissa and a power of two
+  CRealDigits(u64 iMantissa, s32 iPower2) : _ctInteger(0), _iNextInteger(0), _iFractionBits(0)
+  {
+    CBigUInt integer;
+
+    if (iPower2 >= 0) {
+      integer.Set(iMantissa);
+      integer.ShiftLeft(iPower2);
+
+    } else if (iPower2 > -64) {
+      _iFractionBits = -iPower2;
+      integer.Set(iMantissa >> _iFractionBits);
+      _fraction.Set(iMantissa & ((u64(1) << _iFractionBits) - 1));
+
+    } else {
+      _iFractionBits = -iPower2;
+      _fraction.Set(iMantissa);
+    }
+
+    // Print integer part in chunks of 9 digits starting from the lowest one
+    u32 aChunks[40];
+    size_t ctChunks = 0;
+
+    while (!integer.IsZero()) {
+      aChunks[ctChunks++] = integer.Div(1000000000);
+    }
+
+    if (ctChunks == 0) return;
+
+    _ctInteger = FormatUInt(_aInteger, aChunks[--ctChunks]);
+
+    while (ctChunks != 0) {
+      u32 iChunk = aChunks[--ctChunks];
+
+      for (size_t i = 9; i-- != 0;) {
+        _aInteger[_ctInteger + i] = c8('0' + iChunk % 10);
+        iChunk /= 10;
+      }
+
+      _ctInteger += 9;
+    }
+  };
+
+  // Get amount of digits in the integer part
+  inline size_t IntegerDigits(void) const {
+    return _ctInteger;
+  };
+
+  // Get the next digit
+  inline c8 Next(void) {
+    if (_iNextInteger < _ctInteger) return _aInteger[_iNextInteger++];
+    if (_fraction.IsZero()) return '0';
+
+    _fraction.Mul(10);
+    return c8('0' + _fraction.SplitAt(_iFractionBits));
+  };
+
+  // Check if there are any non-zero digits left
+  bool HasMore(void) const {
+    for (size_t i = _iNextInteger; i < _ctInteger; ++i) {
+      if (_aInteger[i] != '0') return true;
+    }
+
+    return !_fraction.IsZero();
+  };
+};
+
+// Maximum amount of stored digits (further digits of a double are always zeros)
+static const s32 _iMaxRealDigits = 800;
+
+// Get digits of a positive double rounded to a specific amount of significant digits or decimal places
+// Digits beyond the returned amount are zeros and the value equals 0.[digits] * 10^iPoint
+static s32 RoundRealDigits(c8 *aDigits, u64 iMantissa, s32 iPower2, bool bFixed, s32 iPlaces, s32 &iPoint) {
+  CRealDigits digits(iMantissa, iPower2);
+  c8 chFirst;
+
+  // Find the first significant digit
+  if (digits.IntegerDigits() != 0) {
+    iPoint = s32(digits.IntegerDigits());
+    chFirst = digits.Next();
+
+  } else {
+    iPoint = 0;
+
+    while ((chFirst = digits.Next()) == '0') --iPoint;
+  }
+
+  // Amount of digits up to the rounding position
+  const s32 ctDigits = bFixed ? iPoint + iPlaces : iPlaces;
+
+  // Rounds to either zero or the first digit at the rounding position
+  if (ctDigits <= 0) {
+    const bool bUp = (ctDigits == 0 && (chFirst > '5' || (chFirst == '5' && digits.HasMore())));
+    if (!bUp) return 0;
+
+    aDigits[0] = '1';
+    iPoint += 1 - ctDigits;
+    return 1;
+  }
+
+  const s32 ctStored = (ctDigits < _iMaxRealDigits) ? ctDigits : _iMaxRealDigits;
+  aDigits[0] = chFirst;
+
+  for (s32 i = 1; i < ctStored; ++i) {
+    aDigits[i] = digits.Next();
+  }
+
+  // Round half to even
+  const c8 chRound = (ctStored == ctDigits) ? digits.Next() : '0';
+  bool bUp = (chRound > '5' || (chRound == '5' && (digits.HasMore() || ((aDigits[ctStored - 1] - '0') & 1))));
+
+  for (s32 i = ctStored - 1; bUp && i >= 0; --i) {
+    if (aDigits[i] == '9') {
+      aDigits[i] = '0';
+    } else {
+      ++aDigits[i];
+      bUp = false;
+    }
+  }
+
+  // All digits were nines
+  if (bUp) {
+    aDigits[0] = '1';
+    ++iPoint;
+
+    // One more integer digit
+    if (bFixed && ctStored < _iMaxRealDigits) {
+      aDigits[ctStored] = '0';
+      return ctStored + 1;
+    }
+  }
+
+  return ctStored;
+};
+
+// Print digits in a fixed notation
+static void PutFixed(SRealOutput &out, const c8 *aDigits, s32 ctDigits, s32 iPoint, s32 iPrecision, bool bTrimZeros) {
+  // Integer part
+  if (iPoint <= 0) {
+    out.Put('0');
+
+  } else {
+    for (s32 i = 0; i < iPoint; ++i) {
+      out.Put(i < ctDigits ? aDigits[i] : '0');
+    }
+  }
+
+  // Only print significant fractional digits
+  if (bTrimZeros) {
+    while (iPrecision > 0 && (iPoint + iPrecision > ctDigits || aDigits[iPoint + iPrecision - 1] == '0')) {
+      --iPrecision;
+    }
+  }
+
+  if (iPrecision <= 0) return;
+
+  out.Put('.');
+
+  for (s32 i = 0; i < iPrecision; ++i) {
+    const s32 iDigit = iPoint + i;
+    out.Put((iDigit >= 0 && iDigit < ctDigits) ? aDigits[iDigit] : '0');
+  }
+};
+
+// Print digits in a scientific notation
+static void PutScientific(SRealOutput &out, const c8 *aDigits, s32 ctDigits, s32 iExponent, s32 iPrecision, bool bTrimZeros) {
+  out.Put(ctDigits > 0 ? aDigits[0] : '0');
+
+  if (bTrimZeros) {
+    while (iPrecision > 0 && (iPrecision >= ctDigits || aDigits[iPrecision] == '0')) {
+      --iPrecision;
+    }
+  }
+
+  if (iPrecision > 0) {
+    out.Put('.');
+
+    for (s32 i = 1; i <= iPrecision; ++i) {
+      out.Put(i < ctDigits ? aDigits[i] : '0');
+    }
+  }
+
+  // At least two exponent digits
+  out.Put('e');
+  out.Put(iExponent < 0 ? '-' : '+');
+
+  const u32 iAbsExponent = (iExponent < 0) ? -iExponent : iExponent;
+  if (iAbsExponent < 10) out.Put('0');
+
+  c8 strExponent[8];
+  const size_t iLength = FormatUInt(strExponent, iAbsExponent);
+  strExponent[iLength] = '\0';
+
+  out.Put(strExponent);
+};
+
+size_t FormatReal(c8 *pBuffer, size_t iBufferSize, f64 f, c8 chNotation, s32 iPrecision) {
+  SRealOutput out;
+  out.pBuffer = pBuffer;
+  out.iSize = iBufferSize;
+  out.iLength = 0;
+
+  if (iPrecision < 0) iPrecision = 6;
+
+  u64 iBits;
+  memcpy(&iBits, &f, sizeof(iBits));
+
+  const s32 iBiased = s32(iBits >> 52) & 0x7FF;
+  u64 iMantissa = iBits & ((u64(1) << 52) - 1);
+
+  if (iBits >> 63) out.Put('-');
+
+  if (iBiased == 0x7FF) {
+    out.Put(iMantissa != 0 ? "nan" : "inf");
+    out.End();
+    return out.iLength;
+  }
+
+  // Implicit bit of normal numbers
+  s32 iPower2 = -1074;
+
+  if (iBiased != 0) {
+    iMantissa |= (u64(1) << 52);
+    iPower2 = iBiased - 1075;
+  }
+
+  c8 aDigits[_iMaxRealDigits];
+  s32 ctDigits = 0;
+  s32 iPoint = 1;
+
+  switch (chNotation) {
+    case 'f':
+      if (iMantissa != 0) ctDigits = RoundRealDigits(aDigits, iMantissa, iPower2, true, iPrecision, iPoint);
+      PutFixed(out, aDigits, ctDigits, iPoint, iPrecision, false);
+      break;
+
+    case 'e':
+      if (iMantissa != 0) ctDigits = RoundRealDigits(aDigits, iMantissa, iPower2, false, iPrecision + 1, iPoint);
+      PutScientific(out, aDigits, ctDigits, iPoint - 1, iPrecision, false);
+      break;
+
+    default: {
+      // Significant digits
+      if (iPrecision == 0) iPrecision = 1;
+      if (iMantissa != 0) ctDigits = RoundRealDigits(aDigits, iMantissa, iPower2, false, iPrecision, iPoint);
+
+      // Fixed notation for moderate exponents
+      const s32 iExponent = iPoint - 1;
+
+      if (iExponent >= -4 && iExponent < iPrecision) {
+        PutFixed(out, aDigits, ctDigits, iPoint, iPrecision - 1 - iExponent, true);
+      } else {
+        PutScientific(out, aDigits, ctDigits, iExponent, iPrecision - 1, true);
+      }
+    }
+  }
+
+  out.End();
+  return out.iLength;
+};
+
+// Parse a decimal number within a placeholder that can't exceed some value
+static u32 ParsePlaceholderNumber(const c8 *&pch, u32 iMax, const c8 *strFormat) {
+  const c8 *pchStart = pch;
+  u32 i = 0;
+
+  while (*pch >= '0' && *pch <= '9') {
+    const u32 iDigit = u32(*pch - '0');
+
+    if (i > (iMax - iDigit) / 10) {
+      throw CFormattingException(pchStart - strFormat);
+    }
+
+    i = i * 10 + iDigit;
+    ++pch;
+  }
+
+  return i;
+};
+
+// Maximum values of placeholder numbers
+static const u32 _iMaxPlaceholderArg = 0x7FFFFFFE; // One less so that the amount of arguments fits
+static const u32 _iMaxPlaceholderWidth = 0xFFFF;
+static const u32 _iMaxPlaceholderPrecision = 0x7FFF;
+
+CFormatString::CFormatString(const c8 *strFormat) : _ctArgs(0)
+{
+  const c8 *pch = strFormat;
+  u32 iNextArg = 0;
+
+  Segment seg;
+  seg.iLiteral = 0;
+  seg.iLiteralLength = 0;
+
+  while (true) {
+    // Gather literal text
+    while (*pch != '\0' && *pch != '{' && *pch != '}') {
+      _literals += *pch;
+      ++pch;
+    }
+
+    // Escaped braces
+    if ((pch[0] == '{' && pch[1] == '{') || (pch[0] == '}' && pch[1] == '}')) {
+      _literals += *pch;
+      pch += 2;
+      continue;
+    }
+
+    // Unmatched closing brace
+    if (*pch == '}') {
+      throw CFormattingException(pch - strFormat);
+    }
+
+    seg.iLiteralLength = u32(_literals.length()) - seg.iLiteral;
+    seg.iOffset = 0;
+    seg.iArg = -1;
+    seg.iWidth = 0;
+    seg.iPrecision = -1;
+    seg.chType = '\0';
+    seg.chFlags = 0;
+
+    // End of the format
+    if (*pch == '\0') {
+      if (seg.iLiteralLength != 0) _segments.push_back(seg);
+      break;
+    }
+
+    // Placeholder index
+    seg.iOffset = u32(pch - strFormat);
+    ++pch;
+
+    if (*pch >= '0' && *pch <= '9') {
+      seg.iArg = s32(ParsePlaceholderNumber(pch, _iMaxPlaceholderArg, strFormat));
+
+    } else if (iNextArg <= _iMaxPlaceholderArg) {
+      seg.iArg = s32(iNextArg);
+
+    } else {
+      throw CFormattingException(seg.iOffset);
+    }
+
+    iNextArg = seg.iArg + 1;
+
+    // Placeholder specification
+    if (*pch == ':') {
+      ++pch;
+
+      while (true) {
+        if (*pch == '0') {
+          seg.chFlags |= FLAG_ZEROPAD;
+        } else if (*pch == '-') {
+          seg.chFlags |= FLAG_LEFT;
+        } else if (*pch == '+') {
+          seg.chFlags |= FLAG_SIGN;
+        } else {
+          break;
+        }
+
+        ++pch;
+      }
+
+      seg.iWidth = u16(ParsePlaceholderNumber(pch, _iMaxPlaceholderWidth, strFormat));
+
+      if (*pch == '.') {
+        ++pch;
+        seg.iPrecision = s16(ParsePlaceholderNumber(pch, _iMaxPlaceholderPrecision, strFormat));
+      }
+
+      switch (*pch) {
+        case 'd': case 'x': case 'X': case 'f': case 'e': case 'g': case 's': case 'c':
+          seg.chType = *pch;
+          ++pch;
+          break;
+      }
+    }
+
+    // Unclosed or invalid placeholder
+    if (*pch != '}') {
+      throw CFormattingException(pch - strFormat);
+    }
+
+    ++pch;
+
+    _segments.push_back(seg);
+
+    if (size_t(seg.iArg) + 1 > _ctArgs) {
+      _ctArgs = seg.iArg + 1;
+    }
+
+    // Next literal begins after this placeholder
+    seg.iLiteral = u32(_literals.length());
+  }
+};
+
+// Append a printed value with padding
+static void AppendPadded(CString &strOut, const c8 *pch, size_t iLength, const CFormatString::Segment &seg, bool bNumber) {
+  const size_t iPadding = (seg.iWidth > iLength) ? seg.iWidth - iLength : 0;
+
+  if (iPadding == 0) {
+    strOut.append(pch, iLength);
+
+  } else if (seg.chFlags & CFormatString::FLAG_LEFT) {
+    strOut.append(pch, iLength);
+    strOut.append(iPadding, ' ');
+
+  } else if (bNumber && (seg.chFlags & CFormatString::FLAG_ZEROPAD)) {
+    // Put zeros after the sign
+    if (iLength != 0 && (*pch == '-' || *pch == '+')) {
+      strOut += *pch;
+      ++pch;
+      --iLength;
+    }
+
+    strOut.append(iPadding, '0');
+    strOut.append(pch, iLength);
+
+  } else {
+    strOut.append(iPadding, ' ');
+    strOut.append(pch, iLength);
+  }
+};
+
+// Print a real number with an optional sign into a buffer or into a larger one if it doesn't fit and return the used one
+static const c8 *FormatRealArg(c8 *aBuffer, size_t iBufferSize, std::vector<c8> &aLarge, size_t &iLength,
+                               c8 chSign, f64 f, c8 chNotation, s32 iPrecision)
+{
+  c8 *pch = aBuffer;
+  if (chSign != '\0') *pch++ = chSign;
+
+  const size_t iSign = pch - aBuffer;
+  const size_t iReal = FormatReal(pch, iBufferSize - iSign, f, chNotation, iPrecision);
+  iLength = iSign + iReal;
+
+  if (iLength < iBufferSize) return aBuffer;
+
+  // Print again with enough space
+  aLarge.resize(iLength + 1);
+  if (chSign != '\0') aLarge[0] = chSign;
+
+  FormatReal(&aLarge[iSign], iReal + 1, f, chNotation, iPrecision);
+  return &aLarge[0];
+};
+
+void CFormatString::Append(CString &strOut, const CFormatArg *aArgs, size_t ctArgs) const {
+  const size_t ctSegments = _segments.size();
+  std::vector<c8> aLarge; // Buffer for long real numbers
+
+  // Mismatching amount of arguments
+  if (ctArgs < _ctArgs) {
+    for (size_t iSeg = 0; iSeg < ctSegments; ++iSeg) {
+      if (size_t(_segments[iSeg].iArg + 1) > ctArgs) throw CFormattingException(_segments[iSeg].iOffset);
+    }
+  }
+
+  for (size_t iSeg = 0; iSeg < ctSegments; ++iSeg) {
+    const Segment &seg = _segments[iSeg];
+    strOut.append(_literals, seg.iLiteral, seg.iLiteralLength);
+
+    if (seg.iArg < 0) continue;
+
+    const CFormatArg &arg = aArgs[seg.iArg];
+    c8 strBuffer[128];
+    const c8 *pchOut = strBuffer;
+    size_t iLength = 0;
+    bool bNumber = true;
+
+    switch (arg._type) {
+      case CFormatArg::ARG_INT:
+      case CFormatArg::ARG_UINT: {
+        const bool bSigned = (arg._type == CFormatArg::ARG_INT);
+
+        if (seg.chType == 'x' || seg.chType == 'X') {
+          // Negative numbers only use bits of their type
+          u64 iHex = arg._uint;
+          if (arg._bytes < sizeof(u64)) iHex &= (u64(1) << (arg._bytes * 8)) - 1;
+
+          iLength = FormatHex(strBuffer, iHex, seg.chType == 'X');
+
+        } else if (seg.chType == 'f' || seg.chType == 'e' || seg.chType == 'g') {
+          const f64 f = bSigned ? f64(arg._int) : f64(arg._uint);
+          pchOut = FormatRealArg(strBuffer, sizeof(strBuffer), aLarge, iLength, '\0', f, seg.chType, seg.iPrecision);
+
+        } else if (seg.chType == 'c') {
+          strBuffer[0] = c8(arg._uint);
+          iLength = 1;
+          bNumber = false;
+
+        } else if (bSigned) {
+          c8 *pch = strBuffer;
+          if ((seg.chFlags & FLAG_SIGN) && arg._int >= 0) *pch++ = '+';
+
+          iLength = (pch - strBuffer) + FormatInt(pch, arg._int);
+
+        } else {
+          c8 *pch = strBuffer;
+          if (seg.chFlags & FLAG_SIGN) *pch++ = '+';
+
+          iLength = (pch - strBuffer) + FormatUInt(pch, arg._uint);
+        }
+      } break;
+
+      case CFormatArg::ARG_REAL: {
+        const c8 chNotation = (seg.chType == 'f' || seg.chType == 'e') ? seg.chType : 'g';
+        const c8 chSign = ((seg.chFlags & FLAG_SIGN) && arg._real >= 0.0) ? '+' : '\0';
+
+        pchOut = FormatRealArg(strBuffer, sizeof(strBuffer), aLarge, iLength, chSign, arg._real, chNotation, seg.iPrecision);
+      } break;
+
+      case CFormatArg::ARG_CHAR: {
+        // Print character code when requested
+        if (seg.chType == 'd' || seg.chType == 'x' || seg.chType == 'X') {
+          const u8 iCode = u8(arg._char);
+          iLength = (seg.chType == 'd') ? FormatUInt(strBuffer, iCode) : FormatHex(strBuffer, iCode, seg.chType == 'X');
+
+        } else {
+          strBuffer[0] = arg._char;
+          iLength = 1;
+          bNumber = false;
+        }
+      } break;
+
+      case CFormatArg::ARG_BOOL: {
+        if (seg.chType == 'd') {
+          strBuffer[0] = (arg._bool ? '1' : '0');
+          iLength = 1;
+
+        } else {
+          iLength = (arg._bool ? 4 : 5);
+          memcpy(strBuffer, (arg._bool ? "true" : "false"), iLength);
+          bNumber = false;
+        }
+      } break;
+
+      case CFormatArg::ARG_STRING: {
+        // Precision limits string length
+        size_t iStringLength = arg._length;
+
+        if (seg.iPrecision >= 0 && size_t(seg.iPrecision) < iStringLength) {
+          iStringLength = seg.iPrecision;
+        }
+
+        const c8 *str = (arg._ptr != nullptr) ? (const c8 *)arg._ptr : "";
+        AppendPadded(strOut, str, iStringLength, seg, false);
+      } continue;
+
+      case CFormatArg::ARG_POINTER: {
+        strBuffer[0] = '0';
+        strBuffer[1] = 'x';
+        iLength = 2 + FormatHex(strBuffer + 2, u64(size_t(arg._ptr)), seg.chType == 'X');
+        bNumber = false;
+      } break;
+    }
+
+    AppendPadded(strOut, pchOut, iLength, seg, bNumber);
+  }
+};
+
+}; // namespace dreamy
@@ -0,0 +1,174 @@
+//! This file is a part of Dreamy Utilities.
+//! Licensed under the MIT license (see LICENSE file).
+
+#ifndef _DREAMYUTILITIES_INCL_FORMAT_H
+#define _DREAMYUTILITIES_INCL_FORMAT_H
+
+#include "../DreamyUtilitiesBase.hpp"
+
+#include "String.hpp"
+
+#include <vector>
+
+namespace dreamy {
+
+// Print an unsigned integer in decimal form (buffer should fit 20 characters) and return its length
+size_t FormatUInt(c8 *pBuffer, u64 i);
+
+// Print a signed integer in decimal form (buffer should fit 20 characters) and return its length
+size_t FormatInt(c8 *pBuffer, s64 i);
+
+// Print an unsigned integer in hexadecimal form (buffer should fit 16 characters) and return its length
+size_t FormatHex(c8 *pBuffer, u64 i, bool bUppercase = false);
+
+// Print an exactly rounded real number using printf-styled notation ('f', 'e' or 'g') with optional precision
+// Like snprintf, returns the full length even if only a part of it fits in the buffer
+// Doesn't depend on the current locale and always uses '.' as the decimal point
+size_t FormatReal(c8 *pBuffer, size_t iBufferSize, f64 f, c8 chNotation = 'g', s32 iPrecision = -1);
+
+// Type-safe argument for compiled format strings
+class CFormatArg {
+
+public:
+  // Argument types
+  enum EType {
+    ARG_INT,
+    ARG_UINT,
+    ARG_REAL,
+    ARG_CHAR,
+    ARG_BOOL,
+    ARG_STRING,
+    ARG_POINTER,
+  };
+
+public:
+  EType _type;
+
+  union {
+    s64 _int;
+    u64 _uint;
+    f64 _real;
+    c8 _char;
+    bool _bool;
+    const void *_ptr;
+  };
+
+  size_t _length; // String length
+  u8 _bytes; // Size of an integer type
+
+public:
+  CFormatArg(c8  ch) : _type(ARG_CHAR), _length(0), _bytes(1) { _char = ch; };
+  CFormatArg(bool b) : _type(ARG_BOOL), _length(0), _bytes(1) { _bool = b; };
+
+  CFormatArg(s8  i) : _type(ARG_INT), _length(0), _bytes(sizeof(i)) { _int = i; };
+  CFormatArg(s16 i) : _type(ARG_INT), _length(0), _bytes(sizeof(i)) { _int = i; };
+  CFormatArg(s32 i) : _type(ARG_INT), _length(0), _bytes(sizeof(i)) { _int = i; };
+  CFormatArg(s64 i) : _type(ARG_INT), _length(0), _bytes(sizeof(i)) { _int = i; };
+  CFormatArg(long i) : _type(ARG_INT), _length(0), _bytes(sizeof(i)) { _int = i; };
+
+  CFormatArg(u8  i) : _type(ARG_UINT), _length(0), _bytes(sizeof(i)) { _uint = i; };
+  CFormatArg(u16 i) : _type(ARG_UINT), _length(0), _bytes(sizeof(i)) { _uint = i; };
+  CFormatArg(u32 i) : _type(ARG_UINT), _length(0), _bytes(sizeof(i)) { _uint = i; };
+  CFormatArg(u64 i) : _type(ARG_UINT), _length(0), _bytes(sizeof(i)) { _uint = i; };
+  CFormatArg(unsigned long i) : _type(ARG_UINT), _length(0), _bytes(sizeof(i)) { _uint = i; };
+
+  CFormatArg(f32 f) : _type(ARG_REAL), _length(0), _bytes(sizeof(f)) { _real = f; };
+  CFormatArg(f64 f) : _type(ARG_REAL), _length(0), _bytes(sizeof(f)) { _real = f; };
+
+  CFormatArg(const c8 *str) : _type(ARG_STRING), _length(str != nullptr ? strlen(str) : 0), _bytes(0) { _ptr = str; };
+  CFormatArg(const CStringBase &str) : _type(ARG_STRING), _length(str.length()), _bytes(0) { _ptr = str.c_str(); };
+
+  CFormatArg(const void *p) : _type(ARG_POINTER), _length(0), _bytes(sizeof(p)) { _ptr = p; };
+};
+
+// Format string that's parsed once and then reused for printing
+// Placeholders are written as "{}" or "{index}" with optional specification after a colon:
+// "{:[flags][width][.precision][type]}"
+// - Flags: '0' - pad with zeros, '-' - align to the left, '+' - always print a sign
+// - Types: 'd' - decimal, 'x'/'X' - hexadecimal, 'f'/'e'/'g' - real number notation, 's' - string, 'c' - character
+// Braces themselves are written as "{{" and "}}"
+class CFormatString {
+
+public:
+  // One piece of the format string
+  struct Segment {
+    u32 iOffset; // Placeholder position in the format string
+    u32 iLiteral; // Literal text before the placeholder
+    u32 iLiteralLength;
+    s32 iArg; // Argument index (-1 if there's no placeholder)
+    u16 iWidth;
+    s16 iPrecision; // -1 if unspecified
+    c8 chType; // Conversion type ('\0' if unspecified)
+    c8 chFlags; // Combination of flag bits
+  };
+
+  // Flag bits of a placeholder
+  enum EFlags {
+    FLAG_ZEROPAD = (1 << 0),
+    FLAG_LEFT    = (1 << 1),
+    FLAG_SIGN    = (1 << 2),
+  };
+
+private:
+  CString _literals; // All literal text without escaped braces
+  std::vector<Segment> _segments;
+  size_t _ctArgs; // Expected amount of arguments
+
+public:
+  // Parse a format string (throws CFormattingException on invalid placeholders)
+  CFormatString(const c8 *strFormat);
+
+  // Get amount of arguments that the format expects
+  inline size_t ArgCount(void) const {
+    return _ctArgs;
+  };
+
+  // Append formatted text to a string (throws CFormattingException on a mismatching amount of arguments)
+  void Append(CString &strOut, const CFormatArg *aArgs, size_t ctArgs) const;
+};
+
+#if _DREAMY_CPP11
+
+// Append formatted text to a string
+template<typename... Args> inline
+void FormatAppend(CString &strOut, const CFormatString &fmt, const Args &... args) {
+  const CFormatArg aArgs[sizeof...(Args) + 1] = { CFormatArg(args)..., CFormatArg(0) };
+  fmt.Append(strOut, aArgs, sizeof...(Args));
+};
+
+// Replace string contents with formatted text
+template<typename... Args> inline
+void Format(CString &strOut, const CFormatString &fmt, const Args &... args) {
+  strOut.clear();
+  FormatAppend(strOut, fmt, args...);
+};
+
+// Format text into a new string
+template<typename... Args> inline
+CString Format(const CFormatString &fmt, const Args &... args) {
+  CString strOut;
+  FormatAppend(strOut, fmt, args...);
+  return strOut;
+};
+
+// Replace string contents with formatted text using a parsed format instead of its literal
+template<typename... Args> inline
+void FormatCached(CString &strOut, const CFormatString &fmt, const c8 *, const Args &... args) {
+  Format(strOut, fmt, args...);
+};
+
+// Format a string using a format literal that's parsed only once per call site
+// The literal is a part of variadic arguments, so it may be the only one
+#define DREAMY_FORMAT(_StringOut, ...) do { \
+  static const dreamy::CFormatString _fmtCached(DREAMY_FORMAT_LITERAL(__VA_ARGS__, 0)); \
+  dreamy::FormatCached(_StringOut, _fmtCached, __VA_ARGS__); \
+} while (0)
+
+// Get format literal out of DREAMY_FORMAT() arguments
+#define DREAMY_FORMAT_LITERAL(_Format, ...) _Format
+
+#endif // _DREAMY_CPP11
+
+}; // namespace dreamy
+
+#endif // (Dreamy Utilities Include Guard)
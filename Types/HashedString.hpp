@@ -7,6 +7,7 @@
 #include "../DreamyUtilitiesBase.hpp"
 
 #include "../Hashing/SimpleHasher.hpp"
+#include "UnorderedMap.hpp"
 
 namespace dreamy {
 
@@ -24,19 +25,15 @@ public:
   };
 
   // Generate a hash value from a string
-  __forceinline CHashedString(const CString &str) {
-    _string = str;
-
+  __forceinline CHashedString(const CString &str) : _string(str) {
     CSimpleHasher hasher;
     _hash = hasher(str.c_str(), str.length());
   };
 
   // Generate a hash value from an array of characters
-  __forceinline CHashedString(const c8 *str) {
-    _string = str;
-
+  __forceinline CHashedString(const c8 *str) : _string(str) {
     CSimpleHasher hasher;
-    _hash = hasher(str, strlen(str));
+    _hash = hasher(_string.c_str(), _string.length());
   };
 
   // Copy constuctor
@@ -45,6 +42,20 @@ public:
   {
   };
 
+#if _DREAMY_CPP11
+  // Generate a hash value from a string that's taken over
+  __forceinline CHashedString(CString &&str) : _string(std::move(str)) {
+    CSimpleHasher hasher;
+    _hash = hasher(_string.c_str(), _string.length());
+  };
+
+  // Move constructor
+  __forceinline CHashedString(CHashedString &&hsOther) DREAMY_NOEXCEPT :
+    _hash(hsOther._hash), _string(std::move(hsOther._string))
+  {
+  };
+#endif
+
   // Get pure string
   inline const CString &GetString(void) const {
     return _string;
@@ -74,6 +85,30 @@ public:
 
     return *this;
   };
+
+#if _DREAMY_CPP11
+  // Move assignment operator
+  inline CHashedString &operator=(CHashedString &&hsOther) DREAMY_NOEXCEPT {
+    _hash = hsOther._hash;
+    _string = std::move(hsOther._string);
+
+    return *this;
+  };
+#endif
+
+  // Swap strings
+  inline void Swap(CHashedString &hsOther) DREAMY_NOEXCEPT {
+    std::swap(_hash, hsOther._hash);
+    _string.swap(hsOther._string);
+  };
+};
+
+// Hashed strings already have their hash values
+template<>
+struct MapHash<CHashedString> {
+  inline size_t operator()(const CHashedString &str) const {
+    return (size_t)str.GetHash();
+  };
 };
 
 }; // namespace dreamy
@@ -0,0 +1,118 @@
+//! This file is a part of Dreamy Utilities.
+//! Licensed under the MIT license (see LICENSE file).
+
+#include "ObjectShape.hpp"
+
+namespace dreamy {
+
+// Constructor without keys
+CObjectShape::CObjectShape() : _ctRefs(1)
+{
+};
+
+// Constructor from unique keys
+CObjectShape::CObjectShape(const CHashedString *aKeys, size_t ctKeys) :
+  _ctRefs(1), _aKeys(aKeys, aKeys + ctKeys), _mapIndices(ctKeys)
+{
+  for (size_t i = 0; i < ctKeys; ++i) {
+    const bool bAdded = _mapIndices.insert(std::make_pair(aKeys[i].GetHash(), (u32)i)).second;
+    D_ASSERT(bAdded);
+    (void)bAdded;
+  }
+};
+
+// Copy constructor (the copy isn't shared)
+CObjectShape::CObjectShape(const CObjectShape &shapeOther) :
+  _ctRefs(1), _aKeys(shapeOther._aKeys), _mapIndices(shapeOther._mapIndices)
+{
+};
+
+// Check if the shape consists of specific keys in the same order
+bool CObjectShape::HasKeys(const CHashedString *aKeys, size_t ctKeys) const {
+  if (_aKeys.size() != ctKeys) return false;
+
+  for (size_t i = 0; i < ctKeys; ++i) {
+    if (!(_aKeys[i] == aKeys[i])) return false;
+  }
+
+  return true;
+};
+
+// Add a new key at the end and return its index
+size_t CObjectShape::AddKey(const CHashedString &key) {
+  D_ASSERT(!IsShared());
+
+  const u32 iKey = (u32)_aKeys.size();
+  _aKeys.push_back(key);
+
+  try {
+    _mapIndices[key.GetHash()] = iKey;
+
+  } catch (...) {
+    _aKeys.pop_back();
+    throw;
+  }
+
+  return iKey;
+};
+
+// Remove key at some index and shift the following ones
+void CObjectShape::RemoveKey(size_t iKey) {
+  D_ASSERT(!IsShared());
+
+  _mapIndices.erase(_aKeys[iKey].GetHash());
+  _aKeys.erase(_aKeys.begin() + iKey);
+
+  const size_t ctKeys = _aKeys.size();
+
+  for (size_t i = iKey; i < ctKeys; ++i) {
+    _mapIndices[_aKeys[i].GetHash()] = (u32)i;
+  }
+};
+
+// Get shape with a specific sequence of unique keys that the caller is responsible for releasing
+CObjectShape *CObjectShapeCache::Intern(const CHashedString *aKeys, size_t ctKeys) {
+  // Combine key hashes in order
+  u64 iSequence = ctKeys;
+
+  for (size_t i = 0; i < ctKeys; ++i) {
+    iSequence = iSequence * 31 + aKeys[i].GetHash();
+  }
+
+  std::vector<CObjectShape *> &aShapes = _mapShapes[iSequence];
+  const size_t ctShapes = aShapes.size();
+
+  for (size_t iShape = 0; iShape < ctShapes; ++iShape) {
+    CObjectShape *pShape = aShapes[iShape];
+
+    if (pShape->HasKeys(aKeys, ctKeys)) {
+      pShape->AddRef();
+      return pShape;
+    }
+  }
+
+  // Keep one reference in the cache
+  CObjectShape *pShape = new CObjectShape(aKeys, ctKeys);
+  aShapes.push_back(pShape);
+
+  pShape->AddRef();
+  return pShape;
+};
+
+// Forget all shapes (objects that use them keep them)
+void CObjectShapeCache::Clear(void) {
+  unordered_map<u64, std::vector<CObjectShape *> >::iterator it;
+
+  for (it = _mapShapes.begin(); it != _mapShapes.end(); ++it) {
+    std::vector<CObjectShape *> &aShapes = it->second;
+    const size_t ctShapes = aShapes.size();
+
+    for (size_t iShape = 0; iShape < ctShapes; ++iShape) {
+      aShapes[iShape]->Release();
+    }
+  }
+
+  _mapShapes.clear();
+};
+
+}; // namespace dreamy
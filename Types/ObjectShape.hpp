@@ -0,0 +1,564 @@
+//! This file is a part of Dreamy Utilities.
+//! Licensed under the MIT license (see LICENSE file).
+
+#ifndef _DREAMYUTILITIES_INCL_OBJECTSHAPE_H
+#define _DREAMYUTILITIES_INCL_OBJECTSHAPE_H
+
+#include "../DreamyUtilitiesBase.hpp"
+
+#include "HashedString.hpp"
+#include "UnorderedMap.hpp"
+#include "../Data/Atomic.hpp"
+
+#include <deque>
+#include <stdexcept>
+#include <vector>
+
+namespace dreamy {
+
+// Ordered set of object keys that can be shared between objects with the same keys
+// Keys are identified by their hashes, just like CHashedString compares them
+class CObjectShape {
+
+private:
+  AtomicCounter _ctRefs; // Amount of objects that use the shape
+  std::vector<CHashedString> _aKeys; // Keys in insertion order
+  unordered_map<u64, u32> _mapIndices; // Key indices under key hashes
+
+public:
+  // Constructor without keys
+  CObjectShape();
+
+  // Constructor from unique keys
+  CObjectShape(const CHashedString *aKeys, size_t ctKeys);
+
+  // Copy constructor (the copy isn't shared)
+  CObjectShape(const CObjectShape &shapeOther);
+
+  // Use the shape in one more object
+  inline void AddRef(void) {
+    AtomicIncrement(_ctRefs);
+  };
+
+  // Stop using the shape in an object and delete it if it's not used anymore
+  inline void Release(void) {
+    if (AtomicDecrement(_ctRefs) == 0) delete this;
+  };
+
+  // Check if more than one object uses the shape
+  inline bool IsShared(void) const {
+    return _ctRefs > 1;
+  };
+
+  // Amount of keys
+  inline size_t Size(void) const {
+    return _aKeys.size();
+  };
+
+  // Get key at some index
+  inline const CHashedString &GetKey(size_t i) const {
+    return _aKeys[i];
+  };
+
+  // Get index of a key or NULL_POS if there's none
+  inline size_t IndexOf(const CHashedString &key) const {
+    unordered_map<u64, u32>::const_iterator it = _mapIndices.find(key.GetHash());
+    return (it != _mapIndices.end()) ? it->second : NULL_POS;
+  };
+
+  // Check if the shape consists of specific keys in the same order
+  bool HasKeys(const CHashedString *aKeys, size_t ctKeys) const;
+
+  // Add a new key at the end and return its index
+  size_t AddKey(const CHashedString &key);
+
+  // Remove key at some index and shift the following ones
+  void RemoveKey(size_t iKey);
+
+private:
+  // Assignment is not allowed
+  CObjectShape &operator=(const CObjectShape &);
+};
+
+// Set of object shapes that lets objects with the same key sequence share one shape
+// Not thread-safe but shapes that it returns may be used anywhere
+class CObjectShapeCache {
+
+private:
+  unordered_map<u64, std::vector<CObjectShape *> > _mapShapes; // Shapes under hashes of their key sequences
+
+public:
+  // Default constructor
+  CObjectShapeCache() {};
+
+  // Destructor
+  ~CObjectShapeCache() {
+    Clear();
+  };
+
+  // Get shape with a specific sequence of unique keys that the caller is responsible for releasing
+  CObjectShape *Intern(const CHashedString *aKeys, size_t ctKeys);
+
+  // Forget all shapes (objects that use them keep them)
+  void Clear(void);
+
+private:
+  // Copying is not allowed
+  CObjectShapeCache(const CObjectShapeCache &);
+  CObjectShapeCache &operator=(const CObjectShapeCache &);
+};
+
+// Map of hashed strings that stores its keys in a shape that can be shared with other maps
+// Values are stored in the same order as keys and references to them stay valid while adding pairs (but not after erasing)
+// Adding or removing keys in a map with a shared shape makes a copy of the shape first
+// Keys and values are stored separately, so iterators yield proxy pairs of references instead of value_type references
+template<typename Type>
+class CShapedMap {
+
+public:
+  // Dreamy Utilities styled typedefs
+  typedef CHashedString K;
+  typedef Type T;
+
+  // STL styled typedefs
+  typedef CHashedString key_type;
+  typedef Type mapped_type;
+  typedef std::pair<const CHashedString, Type> value_type;
+
+  // Container of values in key order
+  typedef std::deque<Type> Values_t;
+
+  // Pair of references to a key and its value (not a value_type reference)
+  struct reference {
+    const CHashedString &first;
+    Type &second;
+  };
+
+  // Pair of references to a key and its constant value
+  struct const_reference {
+    const CHashedString &first;
+    const Type &second;
+  };
+
+  class const_iterator;
+
+  // Iterator over pairs in key order
+  class iterator {
+    friend class CShapedMap;
+    friend class const_iterator;
+
+  public:
+    typedef std::bidirectional_iterator_tag iterator_category;
+    typedef std::pair<const CHashedString, Type> value_type;
+    typedef ptrdiff_t difference_type;
+    typedef typename CShapedMap::reference reference;
+
+    // Holder of a pair of references that acts like a pointer to it
+    struct pointer {
+      reference ref;
+
+      inline reference *operator->(void) {
+        return &ref;
+      };
+    };
+
+  private:
+    CShapedMap *_pMap;
+    size_t _iEntry;
+
+  public:
+    iterator() : _pMap(nullptr), _iEntry(0) {};
+    iterator(CShapedMap *pMap, size_t iEntry) : _pMap(pMap), _iEntry(iEntry) {};
+
+    inline reference operator*(void) const {
+      reference ref = { _pMap->_pShape->GetKey(_iEntry), _pMap->_aValues[_iEntry] };
+      return ref;
+    };
+
+    inline pointer operator->(void) const {
+      pointer ptr = { **this };
+      return ptr;
+    };
+
+    inline iterator &operator++(void) {
+      ++_iEntry;
+      return *this;
+    };
+
+    inline iterator operator++(int) {
+      iterator itOld = *this;
+      ++_iEntry;
+      return itOld;
+    };
+
+    inline iterator &operator--(void) {
+      --_iEntry;
+      return *this;
+    };
+
+    inline iterator operator--(int) {
+      iterator itOld = *this;
+      --_iEntry;
+      return itOld;
+    };
+
+    inline bool operator==(const iterator &itOther) const {
+      return _iEntry == itOther._iEntry && _pMap == itOther._pMap;
+    };
+
+    inline bool operator!=(const iterator &itOther) const {
+      return !operator==(itOther);
+    };
+  };
+
+  // Constant iterator over pairs in key order
+  class const_iterator {
+    friend class CShapedMap;
+
+  public:
+    typedef std::bidirectional_iterator_tag iterator_category;
+    typedef std::pair<const CHashedString, Type> value_type;
+    typedef ptrdiff_t difference_type;
+    typedef typename CShapedMap::const_reference reference;
+
+    // Holder of a pair of references that acts like a pointer to it
+    struct pointer {
+      reference ref;
+
+      inline reference *operator->(void) {
+        return &ref;
+      };
+    };
+
+  private:
+    const CShapedMap *_pMap;
+    size_t _iEntry;
+
+  public:
+    const_iterator() : _pMap(nullptr), _iEntry(0) {};
+    const_iterator(const CShapedMap *pMap, size_t iEntry) : _pMap(pMap), _iEntry(iEntry) {};
+    const_iterator(const iterator &it) : _pMap(it._pMap), _iEntry(it._iEntry) {};
+
+    inline reference operator*(void) const {
+      reference ref = { _pMap->_pShape->GetKey(_iEntry), _pMap->_aValues[_iEntry] };
+      return ref;
+    };
+
+    inline pointer operator->(void) const {
+      pointer ptr = { **this };
+      return ptr;
+    };
+
+    inline const_iterator &operator++(void) {
+      ++_iEntry;
+      return *this;
+    };
+
+    inline const_iterator operator++(int) {
+      const_iterator itOld = *this;
+      ++_iEntry;
+      return itOld;
+    };
+
+    inline const_iterator &operator--(void) {
+      --_iEntry;
+      return *this;
+    };
+
+    inline const_iterator operator--(int) {
+      const_iterator itOld = *this;
+      --_iEntry;
+      return itOld;
+    };
+
+    // Comparisons also work between both iterator types
+    friend inline bool operator==(const const_iterator &it1, const const_iterator &it2) {
+      return it1._iEntry == it2._iEntry && it1._pMap == it2._pMap;
+    };
+
+    friend inline bool operator!=(const const_iterator &it1, const const_iterator &it2) {
+      return !(it1 == it2);
+    };
+  };
+
+  typedef std::pair<iterator, bool> _Pairib;
+
+private:
+  CObjectShape *_pShape; // Keys (none if empty)
+  Values_t _aValues; // Value per key
+
+public:
+  // Default constructor
+  CShapedMap() : _pShape(nullptr)
+  {
+  };
+
+  // Copy constructor that shares the shape
+  CShapedMap(const CShapedMap &mapOther) : _pShape(mapOther._pShape), _aValues(mapOther._aValues)
+  {
+    if (_pShape != nullptr) _pShape->AddRef();
+  };
+
+#if _DREAMY_CPP11
+  // Move constructor
+  CShapedMap(CShapedMap &&mapOther) DREAMY_NOEXCEPT : _pShape(mapOther._pShape), _aValues(std::move(mapOther._aValues))
+  {
+    mapOther._pShape = nullptr;
+    mapOther._aValues.clear();
+  };
+#endif
+
+  // Destructor
+  ~CShapedMap() {
+    if (_pShape != nullptr) _pShape->Release();
+  };
+
+  // Assignment operator
+  CShapedMap &operator=(const CShapedMap &mapOther) {
+    if (this != &mapOther) {
+      CShapedMap mapCopy(mapOther);
+      swap(mapCopy);
+    }
+
+    return *this;
+  };
+
+#if _DREAMY_CPP11
+  // Move assignment operator
+  CShapedMap &operator=(CShapedMap &&mapOther) DREAMY_NOEXCEPT {
+    if (this != &mapOther) {
+      CShapedMap mapTemp(std::move(mapOther));
+      swap(mapTemp);
+    }
+
+    return *this;
+  };
+#endif
+
+  // Swap contents with another map
+  void swap(CShapedMap &mapOther) DREAMY_NOEXCEPT {
+    std::swap(_pShape, mapOther._pShape);
+    _aValues.swap(mapOther._aValues);
+  };
+
+  // Replace contents with values for keys of a shape that the map takes a reference to (values are taken over)
+  void Assign(CObjectShape *pShape, Values_t &aValues) {
+    D_ASSERT(pShape != nullptr && pShape->Size() == aValues.size());
+
+    pShape->AddRef();
+    if (_pShape != nullptr) _pShape->Release();
+
+    _pShape = pShape;
+    _aValues.swap(aValues);
+  };
+
+  // Get shape with keys (nullptr if none)
+  inline const CObjectShape *GetShape(void) const {
+    return _pShape;
+  };
+
+public:
+  // Beginning of the map
+  inline iterator begin(void) {
+    return iterator(this, 0);
+  };
+
+  // Constant beginning of the map
+  inline const_iterator begin(void) const {
+    return const_iterator(this, 0);
+  };
+
+  // End of the map
+  inline iterator end(void) {
+    return iterator(this, _aValues.size());
+  };
+
+  // Constant end of the map
+  inline const_iterator end(void) const {
+    return const_iterator(this, _aValues.size());
+  };
+
+  // Amount of pairs
+  inline size_t size(void) const {
+    return _aValues.size();
+  };
+
+  // Check if there are no pairs
+  inline bool empty(void) const {
+    return _aValues.empty();
+  };
+
+  // Remove all pairs
+  void clear(void) {
+    if (_pShape != nullptr) _pShape->Release();
+
+    _pShape = nullptr;
+    _aValues.clear();
+  };
+
+public:
+  // Insert a new pair at the end or find an existing one
+  _Pairib insert(const value_type &pair) {
+    const size_t i = IndexOf(pair.first);
+    if (i != NULL_POS) return std::make_pair(iterator(this, i), false);
+
+    _aValues.push_back(pair.second);
+    AddKey(pair.first);
+
+    return std::make_pair(iterator(this, _aValues.size() - 1), true);
+  };
+
+#if _DREAMY_CPP11
+  // Insert a new pair that's taken over at the end or find an existing one
+  _Pairib insert(value_type &&pair) {
+    const size_t i = IndexOf(pair.first);
+    if (i != NULL_POS) return std::make_pair(iterator(this, i), false);
+
+    _aValues.push_back(std::move(pair.second));
+    AddKey(pair.first);
+
+    return std::make_pair(iterator(this, _aValues.size() - 1), true);
+  };
+#endif
+
+  // Remove a pair and return iterator to the next one
+  iterator erase(const_iterator it) {
+    RemoveEntry(it._iEntry);
+    return iterator(this, it._iEntry);
+  };
+
+  // Remove a pair under some key and return amount of removed pairs
+  size_t erase(const CHashedString &key) {
+    const size_t i = IndexOf(key);
+    if (i == NULL_POS) return 0;
+
+    RemoveEntry(i);
+    return 1;
+  };
+
+  // Get iterator to a desired key
+  inline iterator find(const CHashedString &key) {
+    const size_t i = IndexOf(key);
+    return iterator(this, (i != NULL_POS) ? i : _aValues.size());
+  };
+
+  // Get constant iterator to a desired key
+  inline const_iterator find(const CHashedString &key) const {
+    const size_t i = IndexOf(key);
+    return const_iterator(this, (i != NULL_POS) ? i : _aValues.size());
+  };
+
+  // Get value under some key
+  Type &at(const CHashedString &key) {
+    const size_t i = IndexOf(key);
+    if (i != NULL_POS) return _aValues[i];
+
+    throw std::range_error("dreamy::CShapedMap::at() - key doesn't exist");
+  };
+
+  // Get constant value under some key
+  const Type &at(const CHashedString &key) const {
+    const size_t i = IndexOf(key);
+    if (i != NULL_POS) return _aValues[i];
+
+    throw std::range_error("dreamy::CShapedMap::at() - key doesn't exist");
+  };
+
+  // Get value under some key or create a new pair, if there's none
+  Type &operator[](const CHashedString &key) {
+    const size_t i = IndexOf(key);
+    if (i != NULL_POS) return _aValues[i];
+
+    _aValues.push_back(Type());
+    AddKey(key);
+
+    return _aValues.back();
+  };
+
+  // Get constant value under some key
+  inline const Type &operator[](const CHashedString &key) const {
+    return at(key);
+  };
+
+  // Count elements under a specific key
+  inline size_t count(const CHashedString &key) const {
+    return (IndexOf(key) != NULL_POS) ? 1 : 0;
+  };
+
+  // Check if there are any elements under a specific key
+  inline bool contains(const CHashedString &key) const {
+    return IndexOf(key) != NULL_POS;
+  };
+
+private:
+  // Get index of a key or NULL_POS if there's none
+  inline size_t IndexOf(const CHashedString &key) const {
+    return (_pShape != nullptr) ? _pShape->IndexOf(key) : NULL_POS;
+  };
+
+  // Get shape that can only be changed by this map
+  CObjectShape &MutableShape(void) {
+    if (_pShape == nullptr) {
+      _pShape = new CObjectShape;
+
+    } else if (_pShape->IsShared()) {
+      CObjectShape *pCopy = new CObjectShape(*_pShape);
+      _pShape->Release();
+      _pShape = pCopy;
+    }
+
+    return *_pShape;
+  };
+
+  // Add a key for the last value
+  void AddKey(const CHashedString &key) {
+    try {
+      MutableShape().AddKey(key);
+
+    } catch (...) {
+      _aValues.pop_back();
+      throw;
+    }
+  };
+
+  // Remove key and value at some index
+  void RemoveEntry(size_t i) {
+    MutableShape().RemoveKey(i);
+    _aValues.erase(_aValues.begin() + i);
+  };
+};
+
+// Check if maps have the same pairs regardless of their order
+template<typename Type>
+bool operator==(const CShapedMap<Type> &map1, const CShapedMap<Type> &map2) {
+  if (map1.size() != map2.size()) return false;
+
+  // Values are in the same order
+  if (map1.GetShape() == map2.GetShape()) {
+    typename CShapedMap<Type>::const_iterator it1 = map1.begin(), it2 = map2.begin();
+
+    for (; it1 != map1.end(); ++it1, ++it2) {
+      if (!(it1->second == it2->second)) return false;
+    }
+
+    return true;
+  }
+
+  typename CShapedMap<Type>::const_iterator it, itOther;
+
+  for (it = map1.begin(); it != map1.end(); ++it) {
+    itOther = map2.find(it->first);
+    if (itOther == map2.end() || !(itOther->second == it->second)) return false;
+  }
+
+  return true;
+};
+
+template<typename Type>
+bool operator!=(const CShapedMap<Type> &map1, const CShapedMap<Type> &map2) {
+  return !(map1 == map2);
+};
+
+}; // namespace dreamy
+
+#endif // (Dreamy Utilities Include Guard)
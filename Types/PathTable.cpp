@@ -0,0 +1,192 @@
+//! This file is a part of Dreamy Utilities.
+//! Licensed under the MIT license (see LICENSE file).
+
+#include "PathTable.hpp"
+
+namespace dreamy {
+
+// Hash a component name under a parent
+static u32 HashPathComponent(u32 iParent, const c8 *pchName, size_t iLength) {
+  u32 iHash = 2166136261UL ^ (iParent * 0x9E3779B1UL);
+
+  for (size_t i = 0; i < iLength; ++i) {
+    iHash = (iHash ^ u8(pchName[i])) * 16777619UL;
+  }
+
+  return iHash;
+};
+
+// Check if there's a path separator character
+static inline bool IsPathSeparator(c8 ch) {
+  return ch == '/' || ch == '\\';
+};
+
+void CPathTable::Clear(void) {
+  _aNodes.clear();
+  _strNames.clear();
+  _aSlots.clear();
+};
+
+u32 CPathTable::FindNode(u32 iParent, const c8 *pchName, size_t iLength, u32 iHash) const {
+  if (_aSlots.empty()) return NULL_PATH;
+
+  const size_t iMask = _aSlots.size() - 1;
+
+  for (size_t iSlot = iHash & iMask; _aSlots[iSlot] != 0; iSlot = (iSlot + 1) & iMask) {
+    const Node &node = _aNodes[_aSlots[iSlot] - 1];
+
+    if (node.iParent == iParent && node.iNameLength == iLength
+     && memcmp(_strNames.data() + node.iName, pchName, iLength) == 0)
+    {
+      return _aSlots[iSlot] - 1;
+    }
+  }
+
+  return NULL_PATH;
+};
+
+void CPathTable::Rehash(size_t ctSlots) {
+  _aSlots.assign(ctSlots, 0);
+
+  const size_t iMask = ctSlots - 1;
+  const size_t ctNodes = _aNodes.size();
+
+  for (size_t iNode = 0; iNode < ctNodes; ++iNode) {
+    const Node &node = _aNodes[iNode];
+    const u32 iHash = HashPathComponent(node.iParent, _strNames.data() + node.iName, node.iNameLength);
+
+    size_t iSlot = iHash & iMask;
+    while (_aSlots[iSlot] != 0) iSlot = (iSlot + 1) & iMask;
+
+    _aSlots[iSlot] = u32(iNode + 1);
+  }
+};
+
+u32 CPathTable::AddNode(u32 iParent, const c8 *pchName, size_t iLength, u32 iHash) {
+  // Keep the table at most half full
+  if ((_aNodes.size() + 1) * 2 > _aSlots.size()) {
+    Rehash(_aSlots.empty() ? 64 : _aSlots.size() * 2);
+  }
+
+  Node node;
+  node.iParent = iParent;
+  node.iName = u32(_strNames.length());
+  node.iNameLength = u32(iLength);
+  node.iExt = u32(iLength);
+  node.iPathLength = u32(iLength);
+
+  if (iParent != NULL_PATH) {
+    node.iPathLength += _aNodes[iParent].iPathLength + 1;
+  }
+
+  // Find the last period
+  for (size_t i = iLength; i > 0; --i) {
+    if (pchName[i - 1] == '.') {
+      node.iExt = u32(i - 1);
+      break;
+    }
+  }
+
+  _strNames.append(pchName, iLength);
+
+  const u32 iNode = u32(_aNodes.size());
+  _aNodes.push_back(node);
+
+  const size_t iMask = _aSlots.size() - 1;
+
+  size_t iSlot = iHash & iMask;
+  while (_aSlots[iSlot] != 0) iSlot = (iSlot + 1) & iMask;
+
+  _aSlots[iSlot] = iNode + 1;
+  return iNode;
+};
+
+u32 CPathTable::Add(const CStringView &strPath) {
+  const c8 *pch = strPath.data();
+  const c8 *pchEnd = pch + strPath.length();
+
+  u32 iParent = NULL_PATH;
+
+  while (true) {
+    // Find the end of the component
+    const c8 *pchName = pch;
+    while (pch != pchEnd && !IsPathSeparator(*pch)) ++pch;
+
+    const size_t iLength = pch - pchName;
+    const u32 iHash = HashPathComponent(iParent, pchName, iLength);
+
+    u32 iNode = FindNode(iParent, pchName, iLength, iHash);
+    if (iNode == NULL_PATH) iNode = AddNode(iParent, pchName, iLength, iHash);
+
+    if (pch == pchEnd) return iNode;
+
+    iParent = iNode;
+    ++pch;
+  }
+};
+
+u32 CPathTable::Find(const CStringView &strPath) const {
+  const c8 *pch = strPath.data();
+  const c8 *pchEnd = pch + strPath.length();
+
+  u32 iParent = NULL_PATH;
+
+  while (true) {
+    // Find the end of the component
+    const c8 *pchName = pch;
+    while (pch != pchEnd && !IsPathSeparator(*pch)) ++pch;
+
+    const size_t iLength = pch - pchName;
+    const u32 iNode = FindNode(iParent, pchName, iLength, HashPathComponent(iParent, pchName, iLength));
+
+    if (iNode == NULL_PATH || pch == pchEnd) return iNode;
+
+    iParent = iNode;
+    ++pch;
+  }
+};
+
+void CPathTable::GetPath(u32 iPath, CString &strPath) const {
+  strPath.resize(_aNodes[iPath].iPathLength);
+  if (strPath.empty()) return;
+
+  // Fill the path from the end
+  c8 *pchEnd = &strPath[0] + strPath.length();
+
+  for (u32 iNode = iPath; iNode != NULL_PATH; iNode = _aNodes[iNode].iParent) {
+    const Node &node = _aNodes[iNode];
+
+    pchEnd -= node.iNameLength;
+    memcpy(pchEnd, _strNames.data() + node.iName, node.iNameLength);
+
+    if (node.iParent != NULL_PATH) *--pchEnd = '/';
+  }
+};
+
+void CPathTable::GetFileDir(u32 iPath, CString &strDir) const {
+  const u32 iParent = _aNodes[iPath].iParent;
+
+  if (iParent == NULL_PATH) {
+    strDir.clear();
+    return;
+  }
+
+  GetPath(iParent, strDir);
+  strDir += '/';
+};
+
+u32 CPathTable::GoUpUntilDir(u32 iPath, const CStringView &strDirName) const {
+  const size_t ctName = strDirName.length();
+
+  for (u32 iNode = iPath; iNode != NULL_PATH; iNode = _aNodes[iNode].iParent) {
+    const Node &node = _aNodes[iNode];
+
+    if (node.iNameLength == ctName && CString::CompareChars(_strNames.data() + node.iName, strDirName.data(), ctName)) {
+      return iNode;
+    }
+  }
+
+  return NULL_PATH;
+};
+
+}; // namespace dreamy
@@ -0,0 +1,111 @@
+//! This file is a part of Dreamy Utilities.
+//! Licensed under the MIT license (see LICENSE file).
+
+#ifndef _DREAMYUTILITIES_INCL_PATHTABLE_H
+#define _DREAMYUTILITIES_INCL_PATHTABLE_H
+
+#include "../DreamyUtilitiesBase.hpp"
+
+#include "String.hpp"
+#include "StringView.hpp"
+
+#include <vector>
+
+namespace dreamy {
+
+// Invalid path handle
+static const u32 NULL_PATH = static_cast<u32>(-1);
+
+// Table of interned paths stored as a tree of shared components
+// Each path is represented by a handle of its last component and is reconstructed with forward slashes
+class CPathTable {
+
+private:
+  // One path component
+  struct Node {
+    u32 iParent; // Handle of the containing directory or NULL_PATH
+    u32 iName; // Name position in the name pool
+    u32 iNameLength;
+    u32 iExt; // Position of the extension period within the name (name length if there's none)
+    u32 iPathLength; // Length of the full path up to and including this component
+  };
+
+  std::vector<Node> _aNodes;
+  CString _strNames; // All component names one after another
+  std::vector<u32> _aSlots; // Hash table of node indices + 1 (0 for empty slots)
+
+public:
+  CPathTable() {};
+
+  // Remove all paths
+  void Clear(void);
+
+  // Get amount of interned path components
+  inline size_t Count(void) const {
+    return _aNodes.size();
+  };
+
+  // Add a path and return its handle (the same path always returns the same handle)
+  u32 Add(const CStringView &strPath);
+
+  // Find handle of an existing path or return NULL_PATH
+  u32 Find(const CStringView &strPath) const;
+
+  // Get handle of the containing directory or NULL_PATH
+  inline u32 GetParent(u32 iPath) const {
+    return _aNodes[iPath].iParent;
+  };
+
+  // Get length of the full path
+  inline size_t PathLength(u32 iPath) const {
+    return _aNodes[iPath].iPathLength;
+  };
+
+  // Get file name with extension (CString::RemoveDir)
+  inline CStringView RemoveDir(u32 iPath) const {
+    const Node &node = _aNodes[iPath];
+    return CStringView(_strNames.data() + node.iName, node.iNameLength);
+  };
+
+  // Get name of the file (CString::GetFileName)
+  inline CStringView GetFileName(u32 iPath) const {
+    const Node &node = _aNodes[iPath];
+    return CStringView(_strNames.data() + node.iName, node.iExt);
+  };
+
+  // Get file extension with the period (CString::GetFileExt)
+  inline CStringView GetFileExt(u32 iPath) const {
+    const Node &node = _aNodes[iPath];
+    return CStringView(_strNames.data() + node.iName + node.iExt, node.iNameLength - node.iExt);
+  };
+
+  // Reconstruct the full path
+  void GetPath(u32 iPath, CString &strPath) const;
+
+  // Reconstruct the full path
+  inline CString GetPath(u32 iPath) const {
+    CString strPath;
+    GetPath(iPath, strPath);
+    return strPath;
+  };
+
+  // Reconstruct path to the file with a trailing separator (CString::GetFileDir)
+  void GetFileDir(u32 iPath, CString &strDir) const;
+
+  // Go up the path until a certain directory (case-insensitive) and return its handle or NULL_PATH
+  u32 GoUpUntilDir(u32 iPath, const CStringView &strDirName) const;
+
+private:
+  // Find a component under a parent or return NULL_PATH
+  u32 FindNode(u32 iParent, const c8 *pchName, size_t iLength, u32 iHash) const;
+
+  // Insert a new component and return its handle
+  u32 AddNode(u32 iParent, const c8 *pchName, size_t iLength, u32 iHash);
+
+  // Resize the hash table and reinsert all components
+  void Rehash(size_t ctSlots);
+};
+
+}; // namespace dreamy
+
+#endif // (Dreamy Utilities Include Guard)
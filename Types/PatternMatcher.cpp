@@ -0,0 +1,223 @@
+//! This file is a part of Dreamy Utilities.
+//! Licensed under the MIT license (see LICENSE file).
+
+#include "PatternMatcher.hpp"
+
+namespace dreamy {
+
+// Convert ASCII uppercase letters into lowercase and keep all other bytes
+static inline u8 FoldAsciiCase(u8 ch) {
+  return (ch >= 'A' && ch <= 'Z') ? u8(ch + ('a' - 'A')) : ch;
+};
+
+void CPatternMatcher::Clear(void) {
+  _strPatterns.clear();
+  _aStarts.clear();
+  Compile(_bCaseSensitive);
+};
+
+size_t CPatternMatcher::Add(const c8 *pch, size_t iLength) {
+  if (iLength == 0) return NULL_POS;
+
+  _aStarts.push_back(_strPatterns.length());
+  _strPatterns.append(pch, iLength);
+
+  _bCompiled = false;
+  return _aStarts.size() - 1;
+};
+
+void CPatternMatcher::Compile(bool bCaseSensitive) {
+  _bCaseSensitive = bCaseSensitive;
+
+  // Assign columns to bytes that appear in patterns
+  memset(_aClass, 0, sizeof(_aClass));
+  _ctClasses = 1;
+
+  const u8 *pchPatterns = (const u8 *)_strPatterns.data();
+  const size_t ctBytes = _strPatterns.length();
+
+  for (size_t i = 0; i < ctBytes; ++i) {
+    const u8 iByte = (bCaseSensitive ? pchPatterns[i] : FoldAsciiCase(pchPatterns[i]));
+    if (_aClass[iByte] == 0) _aClass[iByte] = u16(_ctClasses++);
+  }
+
+  // Letters of both cases share the same column
+  if (!bCaseSensitive) {
+    for (u32 i = 0; i < 256; ++i) {
+      _aClass[i] = _aClass[FoldAsciiCase(u8(i))];
+    }
+  }
+
+  // Build a trie of all patterns (0 is used for missing transitions, since the root isn't anyone's child)
+  _aTrans.assign(_ctClasses, 0);
+  _aOutput.assign(1, NULL_PATTERN);
+  _aSamePattern.assign(_aStarts.size(), NULL_PATTERN);
+
+  // Insert in reverse so that identical patterns are chained in order of addition
+  for (size_t iPattern = _aStarts.size(); iPattern-- > 0;) {
+    const u8 *pch = pchPatterns + _aStarts[iPattern];
+    const size_t iLength = PatternLength(iPattern);
+
+    u32 iState = 0;
+
+    for (size_t i = 0; i < iLength; ++i) {
+      u32 &iNext = _aTrans[iState * _ctClasses + _aClass[pch[i]]];
+
+      if (iNext == 0) {
+        iNext = u32(_aOutput.size());
+        _aOutput.push_back(NULL_PATTERN);
+        _aTrans.resize(_aTrans.size() + _ctClasses, 0);
+      }
+
+      // Table could've been reallocated
+      iState = _aTrans[iState * _ctClasses + _aClass[pch[i]]];
+    }
+
+    // Chain patterns with identical bytes
+    _aSamePattern[iPattern] = _aOutput[iState];
+    _aOutput[iState] = u32(iPattern);
+  }
+
+  // Fill missing transitions with failure transitions breadth-first
+  const u32 ctStates = u32(_aOutput.size());
+
+  std::vector<u32> aFail(ctStates, 0);
+  std::vector<u32> aQueue;
+  aQueue.reserve(ctStates);
+  aQueue.push_back(0);
+
+  _aDictLink.assign(ctStates, 0);
+  _aHasOutput.assign(ctStates, 0);
+
+  for (size_t iQueue = 0; iQueue < aQueue.size(); ++iQueue) {
+    const u32 iState = aQueue[iQueue];
+    u32 *aRow = &_aTrans[iState * _ctClasses];
+    const u32 *aFailRow = &_aTrans[aFail[iState] * _ctClasses];
+
+    for (u32 iClass = 0; iClass < _ctClasses; ++iClass) {
+      const u32 iChild = aRow[iClass];
+
+      // Continue from the longest suffix that has this transition
+      if (iChild == 0) {
+        aRow[iClass] = (iState == 0) ? 0 : aFailRow[iClass];
+        continue;
+      }
+
+      const u32 iFail = (iState == 0) ? 0 : aFailRow[iClass];
+      aFail[iChild] = iFail;
+
+      // Link to the closest suffix where some pattern ends
+      _aDictLink[iChild] = (_aOutput[iFail] != NULL_PATTERN) ? iFail : _aDictLink[iFail];
+      _aHasOutput[iChild] = (_aOutput[iChild] != NULL_PATTERN || _aDictLink[iChild] != 0);
+
+      aQueue.push_back(iChild);
+    }
+  }
+
+  // Remember bytes that leave the root state
+  _csFirst.Clear();
+
+  for (u32 i = 0; i < 256; ++i) {
+    if (_aTrans[_aClass[i]] != 0) _csFirst.Add(c8(i));
+  }
+
+  _bCompiled = true;
+};
+
+void CPatternMatcher::AddMatches(u32 iState, size_t iEnd, std::vector<Match> &aMatches) const {
+  u32 iOutState = (_aOutput[iState] != NULL_PATTERN) ? iState : _aDictLink[iState];
+
+  while (iOutState != 0) {
+    for (u32 iPattern = _aOutput[iOutState]; iPattern != NULL_PATTERN; iPattern = _aSamePattern[iPattern]) {
+      Match match;
+      match.iPattern = iPattern;
+      match.iPos = iEnd - PatternLength(iPattern);
+      aMatches.push_back(match);
+    }
+
+    iOutState = _aDictLink[iOutState];
+  }
+};
+
+u32 CPatternMatcher::Feed(u32 iState, const c8 *pch, size_t iLength, size_t iOffset, std::vector<Match> &aMatches) const {
+  D_ASSERT(_bCompiled);
+
+  const u32 *aTrans = &_aTrans[0];
+  const u32 ctClasses = _ctClasses;
+  size_t i = 0;
+
+  while (i < iLength) {
+    // Skip bytes that cannot begin any pattern
+    if (iState == 0 && !_csFirst.Contains(pch[i])) {
+      const size_t iSkip = _csFirst.FindFirst(pch + i, iLength - i);
+      if (iSkip == NULL_POS) break;
+
+      i += iSkip;
+    }
+
+    iState = aTrans[iState * ctClasses + _aClass[u8(pch[i])]];
+    ++i;
+
+    if (_aHasOutput[iState]) AddMatches(iState, iOffset + i, aMatches);
+  }
+
+  return iState;
+};
+
+size_t CPatternMatcher::FindAll(const c8 *pch, size_t iLength, std::vector<Match> &aMatches) const {
+  const size_t ctBefore = aMatches.size();
+  Feed(0, pch, iLength, 0, aMatches);
+
+  return aMatches.size() - ctBefore;
+};
+
+size_t CPatternMatcher::FindAll(IReadWriteDevice &d, std::vector<Match> &aMatches) const {
+  const size_t ctBefore = aMatches.size();
+
+  // Read the device in pieces and carry the state between them
+  std::vector<c8> aBuffer(1 << 16);
+  u32 iState = 0;
+  size_t iOffset = 0;
+
+  while (true) {
+    const size_t iRead = d.Read(&aBuffer[0], aBuffer.size());
+    if (iRead == 0 || iRead == NULL_POS) break;
+
+    iState = Feed(iState, &aBuffer[0], iRead, iOffset, aMatches);
+    iOffset += iRead;
+  }
+
+  return aMatches.size() - ctBefore;
+};
+
+bool CPatternMatcher::FindFirst(const c8 *pch, size_t iLength, Match &match) const {
+  D_ASSERT(_bCompiled);
+
+  u32 iState = 0;
+  size_t i = 0;
+
+  while (i < iLength) {
+    if (iState == 0 && !_csFirst.Contains(pch[i])) {
+      const size_t iSkip = _csFirst.FindFirst(pch + i, iLength - i);
+      if (iSkip == NULL_POS) return false;
+
+      i += iSkip;
+    }
+
+    iState = _aTrans[iState * _ctClasses + _aClass[u8(pch[i])]];
+    ++i;
+
+    if (!_aHasOutput[iState]) continue;
+
+    // State itself is the longest match that ends here
+    const u32 iOutState = (_aOutput[iState] != NULL_PATTERN) ? iState : _aDictLink[iState];
+
+    match.iPattern = _aOutput[iOutState];
+    match.iPos = i - PatternLength(match.iPattern);
+    return true;
+  }
+
+  return false;
+};
+
+}; // namespace dreamy
@@ -0,0 +1,133 @@
+//! This file is a part of Dreamy Utilities.
+//! Licensed under the MIT license (see LICENSE file).
+
+#ifndef _DREAMYUTILITIES_INCL_PATTERNMATCHER_H
+#define _DREAMYUTILITIES_INCL_PATTERNMATCHER_H
+
+#include "../DreamyUtilitiesBase.hpp"
+
+#include "ByteArray.hpp"
+#include "CharSet.hpp"
+#include "String.hpp"
+#include "StringView.hpp"
+#include "../IO/ReadWriteDevice.hpp"
+
+#include <vector>
+
+namespace dreamy {
+
+// Set of byte patterns that are searched for all at once in a single pass (Aho-Corasick automaton)
+// Patterns are added first and then compiled into a dense table of transitions between states
+class CPatternMatcher {
+
+public:
+  // One found pattern
+  struct Match {
+    size_t iPattern; // Index of the pattern
+    size_t iPos; // Position of the first matched byte
+  };
+
+private:
+  CString _strPatterns; // Bytes of all patterns one after another
+  std::vector<size_t> _aStarts; // Position of each pattern in the pool
+  bool _bCaseSensitive;
+  bool _bCompiled;
+
+  u16 _aClass[256]; // Byte value -> column in the transition table (0 for bytes that aren't in any pattern)
+  u32 _ctClasses;
+  std::vector<u32> _aTrans; // Next state for each state and byte class
+  std::vector<u32> _aOutput; // First pattern that ends in each state or NULL_PATTERN
+  std::vector<u32> _aDictLink; // Closest suffix state that has an output (0 if none)
+  std::vector<u32> _aSamePattern; // Next pattern with identical bytes or NULL_PATTERN
+  std::vector<u8> _aHasOutput; // Whether any pattern ends in each state
+  CCharSet _csFirst; // Bytes that can begin a pattern
+
+  // No pattern ends in a state
+  enum { NULL_PATTERN = 0xFFFFFFFF };
+
+public:
+  // Empty matcher
+  CPatternMatcher() : _bCaseSensitive(true), _bCompiled(false) {
+    Compile();
+  };
+
+  // Remove all patterns
+  void Clear(void);
+
+  // Add a pattern and return its index (empty patterns are ignored and return NULL_POS)
+  // Requires recompilation before searching
+  size_t Add(const c8 *pch, size_t iLength);
+
+  // Add a pattern and return its index
+  inline size_t Add(const CStringView &strPattern) {
+    return Add(strPattern.data(), strPattern.length());
+  };
+
+  // Add a pattern and return its index
+  inline size_t Add(const CByteArray &baPattern) {
+    return Add(baPattern.ConstData(), baPattern.Size());
+  };
+
+  // Get amount of patterns
+  inline size_t Count(void) const {
+    return _aStarts.size();
+  };
+
+  // Get length of a pattern
+  inline size_t PatternLength(size_t iPattern) const {
+    const size_t iEnd = (iPattern + 1 < _aStarts.size()) ? _aStarts[iPattern + 1] : _strPatterns.length();
+    return iEnd - _aStarts[iPattern];
+  };
+
+  // Get bytes of a pattern
+  inline CStringView GetPattern(size_t iPattern) const {
+    return CStringView(_strPatterns.data() + _aStarts[iPattern], PatternLength(iPattern));
+  };
+
+  // Build the automaton from all added patterns
+  // Case-insensitive matching only folds ASCII letters regardless of the current locale
+  void Compile(bool bCaseSensitive = true);
+
+  // Check if the automaton is up to date with the patterns
+  inline bool IsCompiled(void) const {
+    return _bCompiled;
+  };
+
+  // Gather all occurrences of all patterns (including overlapping ones) in order of their ends and return their amount
+  size_t FindAll(const c8 *pch, size_t iLength, std::vector<Match> &aMatches) const;
+
+  // Gather all occurrences of all patterns in a string
+  inline size_t FindAll(const CStringView &str, std::vector<Match> &aMatches) const {
+    return FindAll(str.data(), str.length(), aMatches);
+  };
+
+  // Gather all occurrences of all patterns in a byte array
+  inline size_t FindAll(const CByteArray &ba, std::vector<Match> &aMatches) const {
+    return FindAll(ba.ConstData(), ba.Size(), aMatches);
+  };
+
+  // Gather all occurrences of all patterns in the rest of a readable device (positions are relative to the current one)
+  size_t FindAll(IReadWriteDevice &d, std::vector<Match> &aMatches) const;
+
+  // Find an occurrence that ends the earliest (the longest one if multiple patterns end there)
+  bool FindFirst(const c8 *pch, size_t iLength, Match &match) const;
+
+  // Check if a string contains any of the patterns
+  inline bool ContainsAny(const CStringView &str) const {
+    Match match;
+    return FindFirst(str.data(), str.length(), match);
+  };
+
+  // Continue searching from a state that's returned by the previous call and return the new state
+  // Allows searching through data that's split into multiple pieces (the first state is 0)
+  // iOffset is the position of the first byte in the entire data for reporting matches
+  u32 Feed(u32 iState, const c8 *pch, size_t iLength, size_t iOffset, std::vector<Match> &aMatches) const;
+
+private:
+  // Report all patterns that end in a state
+  void AddMatches(u32 iState, size_t iEnd, std::vector<Match> &aMatches) const;
+};
+
+}; // namespace dreamy
+
+#endif // (Dreamy Utilities Include Guard)
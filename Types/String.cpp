@@ -4,94 +4,372 @@
 #include "String.hpp"
 #include "Exception.hpp"
 #include "../Data/Memory.hpp"
+#include "../Data/SIMD.hpp"
+#include "../Parser/NumberParser.hpp"
 
-#include <list>
 #include <algorithm>
+#include <vector>
 
 namespace dreamy {
 
-void CString::VPrintF(const c8 *strFormat, va_list arg) {
-  // Allocate new buffer
-  size_t iBufferSize = 256;
-  c8 *pchBuffer = new c8[iBufferSize];
-
-  // Repeat
-  s32 iLength;
+// Format a string into a stack buffer or into a heap buffer if it doesn't fit and return the result
+// Arguments may point into the string that's being formatted, so it can't be touched until the end
+static const c8 *FormatIntoBuffer(c8 *aStack, size_t iStack, std::vector<c8> &aHeap, s32 &iLength,
+  const c8 *strFormat, va_list arg)
+{
+  c8 *pBuffer = aStack;
+  size_t iSpace = iStack;
 
   while (true) {
-    // Print to the buffer
-    iLength = vsnprintf(pchBuffer, iBufferSize, strFormat, arg);
+    va_list argCopy;
+    va_copy(argCopy, arg);
+    iLength = vsnprintf(pBuffer, iSpace, strFormat, argCopy);
+    va_end(argCopy);
+
+    // Fits the space
+    if (iLength >= 0 && size_t(iLength) < iSpace) return pBuffer;
 
-    // Stop if printed ok
-    if (iLength != -1) break;
+    // Exact size is known, so the next pass will fit
+    if (iLength >= 0) {
+      iSpace = iLength + 1;
+
+    } else {
+    #if !_DREAMY_UNIX && !_DREAMY_CPP11
+      // Old printing functions don't report the required size
+      iSpace *= 2;
+    #else
+      // Formatting error
+      return nullptr;
+    #endif
+    }
 
-    // Increase the buffer size
-    ResizeBuffer_memcpy<c8>(&pchBuffer, iBufferSize, iBufferSize + 256);
-    iBufferSize += 256;
+    aHeap.resize(iSpace);
+    pBuffer = &aHeap[0];
   }
+};
+
+void CString::VPrintF(const c8 *strFormat, va_list arg) {
+  c8 aStack[256];
+  std::vector<c8> aHeap;
+  s32 iLength;
 
-  *this = pchBuffer;
-  delete[] pchBuffer;
+  const c8 *pResult = FormatIntoBuffer(aStack, sizeof(aStack), aHeap, iLength, strFormat, arg);
+
+  // Reuse the existing storage
+  if (pResult != nullptr) {
+    assign(pResult, iLength);
+  } else {
+    clear();
+  }
 };
 
 void CString::PrintF(const c8 *strFormat, ...) {
   DREAMY_PRINTF_INLINE(*this, strFormat);
 };
 
+void CString::VAppendF(const c8 *strFormat, va_list arg) {
+  c8 aStack[256];
+  std::vector<c8> aHeap;
+  s32 iLength;
+
+  const c8 *pResult = FormatIntoBuffer(aStack, sizeof(aStack), aHeap, iLength, strFormat, arg);
+  if (pResult != nullptr) append(pResult, iLength);
+};
+
+void CString::AppendF(const c8 *strFormat, ...) {
+  va_list arg;
+  va_start(arg, strFormat);
+  VAppendF(strFormat, arg);
+  va_end(arg);
+};
+
+// Get value of a hexadecimal digit or -1 if it's not one
+static inline s32 HexDigitValue(c8 ch) {
+  if (ch >= '0' && ch <= '9') return ch - '0';
+  if (ch >= 'a' && ch <= 'f') return ch - 'a' + 10;
+  if (ch >= 'A' && ch <= 'F') return ch - 'A' + 10;
+  return -1;
+};
+
+// Parse exactly 4 hexadecimal digits or return -1
+static inline s32 ParseHex4(const c8 *pch, const c8 *pchEnd) {
+  if (pchEnd - pch < 4) return -1;
+
+  s32 iValue = 0;
+
+  for (s32 i = 0; i < 4; ++i) {
+    const s32 iDigit = HexDigitValue(pch[i]);
+    if (iDigit < 0) return -1;
+
+    iValue = (iValue << 4) | iDigit;
+  }
+
+  return iValue;
+};
+
+// Encode a code point in UTF-8 and return amount of written characters
+static size_t EncodeUTF8(u32 iCodePoint, c8 *pch) {
+  if (iCodePoint < 0x80) {
+    pch[0] = c8(iCodePoint);
+    return 1;
+  }
+
+  if (iCodePoint < 0x800) {
+    pch[0] = c8(0xC0 | (iCodePoint >> 6));
+    pch[1] = c8(0x80 | (iCodePoint & 0x3F));
+    return 2;
+  }
+
+  if (iCodePoint < 0x10000) {
+    pch[0] = c8(0xE0 | (iCodePoint >> 12));
+    pch[1] = c8(0x80 | ((iCodePoint >> 6) & 0x3F));
+    pch[2] = c8(0x80 | (iCodePoint & 0x3F));
+    return 3;
+  }
+
+  pch[0] = c8(0xF0 | (iCodePoint >> 18));
+  pch[1] = c8(0x80 | ((iCodePoint >> 12) & 0x3F));
+  pch[2] = c8(0x80 | ((iCodePoint >> 6) & 0x3F));
+  pch[3] = c8(0x80 | (iCodePoint & 0x3F));
+  return 4;
+};
+
+// Decode an escape sequence after the backslash and move past it
+// Writes up to 4 characters and returns their amount or NULL_POS if the sequence is invalid
+static size_t DecodeEscapeSequence(const c8 *&pch, const c8 *pchEnd, c8 *aOut) {
+  if (pch == pchEnd) return NULL_POS;
+
+  const c8 ch = *pch++;
+
+  switch (ch) {
+    // Print the characters themselves
+    case '"': case '\'': case '\\': case '/': case '?':
+      aOut[0] = ch;
+      return 1;
+
+    // Replace special characters with escape characters
+    case 'a': aOut[0] = '\a'; return 1;
+    case 'b': aOut[0] = '\b'; return 1;
+    case 'f': aOut[0] = '\f'; return 1;
+    case 'n': aOut[0] = '\n'; return 1;
+    case 'r': aOut[0] = '\r'; return 1;
+    case 't': aOut[0] = '\t'; return 1;
+    case 'v': aOut[0] = '\v'; return 1;
+
+    // One or two hexadecimal digits
+    case 'x': {
+      s32 iValue = (pch != pchEnd) ? HexDigitValue(*pch) : -1;
+      if (iValue < 0) return NULL_POS;
+
+      ++pch;
+
+      const s32 iDigit = (pch != pchEnd) ? HexDigitValue(*pch) : -1;
+
+      if (iDigit >= 0) {
+        iValue = (iValue << 4) | iDigit;
+        ++pch;
+      }
+
+      aOut[0] = c8(iValue);
+    } return 1;
+
+    // Unicode character in UTF-8
+    case 'u': {
+      s32 iCodePoint = ParseHex4(pch, pchEnd);
+      if (iCodePoint < 0) return NULL_POS;
+
+      pch += 4;
+
+      // Combine a surrogate pair
+      if (iCodePoint >= 0xD800 && iCodePoint <= 0xDBFF && pchEnd - pch >= 6 && pch[0] == '\\' && pch[1] == 'u') {
+        const s32 iLow = ParseHex4(pch + 2, pchEnd);
+
+        if (iLow >= 0xDC00 && iLow <= 0xDFFF) {
+          iCodePoint = 0x10000 + ((iCodePoint - 0xD800) << 10) + (iLow - 0xDC00);
+          pch += 6;
+        }
+      }
+
+      // Lone surrogates can't be encoded, so use the replacement character instead
+      if (iCodePoint >= 0xD800 && iCodePoint <= 0xDFFF) iCodePoint = 0xFFFD;
+
+      return EncodeUTF8(iCodePoint, aOut);
+    }
+
+    // Up to three octal digits
+    default: {
+      if (ch < '0' || ch > '7') return NULL_POS;
+
+      s32 iValue = ch - '0';
+
+      for (s32 i = 0; i < 2 && pch != pchEnd && *pch >= '0' && *pch <= '7'; ++i) {
+        iValue = (iValue << 3) | (*pch - '0');
+        ++pch;
+      }
+
+      // Doesn't fit into a character
+      if (iValue > 0xFF) return NULL_POS;
+
+      aOut[0] = c8(iValue);
+    } return 1;
+  }
+};
+
 void CString::ConvertEscapeChars(void) {
-  CString strOriginal = *this; // Copy of the string for restoration
-  size_t iReplaced = 0; // Amount of replaced characters for offsetting
-
-  // Parse escape characters
-  size_t iEscapeSeq = find('\\', 0);
-
-  while (iEscapeSeq != NULL_POS) {
-    // Erase the escape character
-    CStringBase &str = erase(iEscapeSeq, 1);
-
-    // Character after the escape character
-    c8 &ch = str[iEscapeSeq];
-
-    switch (ch) {
-      // Print the characters themselves
-      case '"':
-      case '\'':
-      case '\\':
-        break;
-
-      // Replace special characters with escape characters
-      case 'a': ch = '\a'; break;
-      case 'b': ch = '\b'; break;
-      case 'f': ch = '\f'; break;
-      case 'n': ch = '\n'; break;
-      case 'r': ch = '\r'; break;
-      case 't': ch = '\t'; break;
-      case 'v': ch = '\v'; break;
-
-      // Other characters
-      default:
-        *this = strOriginal;
-        throw CFormattingException(iEscapeSeq + iReplaced);
+  if (empty()) return;
+
+  c8 *pchBegin = &(*this)[0];
+  const c8 *pchEnd = pchBegin + length();
+
+  c8 *pchWrite = (c8 *)memchr(pchBegin, '\\', length());
+  if (pchWrite == nullptr) return;
+
+  const c8 *pchRead = pchWrite;
+  c8 aDecoded[4];
+
+  // Convert in one pass, moving runs of regular characters between sequences
+  // Decoded characters never take more space than their sequences, so writing never overtakes reading
+  while (pchRead != pchEnd) {
+    const c8 *pchSequence = pchRead++;
+    const size_t ctDecoded = DecodeEscapeSequence(pchRead, pchEnd, aDecoded);
+
+    // Leave the invalid sequence and everything after it unconverted
+    if (ctDecoded == NULL_POS) {
+      const size_t ctRest = pchEnd - pchSequence;
+      memmove(pchWrite, pchSequence, ctRest);
+      resize((pchWrite - pchBegin) + ctRest);
+
+      throw CFormattingException(pchSequence - pchBegin);
+    }
+
+    memcpy(pchWrite, aDecoded, ctDecoded);
+    pchWrite += ctDecoded;
+
+    const c8 *pchNext = (const c8 *)memchr(pchRead, '\\', pchEnd - pchRead);
+    if (pchNext == nullptr) pchNext = pchEnd;
+
+    memmove(pchWrite, pchRead, pchNext - pchRead);
+    pchWrite += pchNext - pchRead;
+    pchRead = pchNext;
+  }
+
+  resize(pchWrite - pchBegin);
+};
+
+// Escape sequence letters for characters in JSON and C strings ('\0' if none, 'u' for numeric ones)
+static c8 EscapeLetter(u8 ch, bool bJSON) {
+  switch (ch) {
+    case '"':  return '"';
+    case '\\': return '\\';
+    case '\b': return 'b';
+    case '\f': return 'f';
+    case '\n': return 'n';
+    case '\r': return 'r';
+    case '\t': return 't';
+  }
+
+  // Extra letters in C strings
+  if (!bJSON) {
+    if (ch == '\a') return 'a';
+    if (ch == '\v') return 'v';
+    if (ch == 0x7F) return 'u';
+  }
+
+  return (ch < 0x20) ? 'u' : '\0';
+};
+
+// Find the first character that needs to be escaped
+static size_t FindCharToEscape(const c8 *pch, size_t iLength, bool bJSON) {
+  size_t i = 0;
+
+#if _DREAMY_SSE2
+  const __m128i vControl = _mm_set1_epi8(0x1F);
+  const __m128i vQuote = _mm_set1_epi8('"');
+  const __m128i vBackslash = _mm_set1_epi8('\\');
+  const __m128i vDelete = _mm_set1_epi8(bJSON ? '"' : 0x7F);
+
+  for (; i + 16 <= iLength; i += 16) {
+    const __m128i v = _mm_loadu_si128((const __m128i *)(pch + i));
+
+    // Control characters are less than 0x20 when compared as unsigned bytes
+    __m128i vMatch = _mm_cmpeq_epi8(_mm_min_epu8(v, vControl), v);
+    vMatch = _mm_or_si128(vMatch, _mm_cmpeq_epi8(v, vQuote));
+    vMatch = _mm_or_si128(vMatch, _mm_cmpeq_epi8(v, vBackslash));
+    vMatch = _mm_or_si128(vMatch, _mm_cmpeq_epi8(v, vDelete));
+
+    const u32 iMask = u32(_mm_movemask_epi8(vMatch));
+    if (iMask != 0) return i + LowestSetBit(iMask);
+  }
+#endif
+
+  for (; i < iLength; ++i) {
+    if (EscapeLetter(u8(pch[i]), bJSON) != '\0') return i;
+  }
+
+  return NULL_POS;
+};
+
+void CString::AppendEscaped(const c8 *pch, size_t iLength, bool bJSON) {
+  // Most characters are copied as is
+  reserve(length() + iLength + iLength / 8);
+
+  while (iLength != 0) {
+    size_t iRun = FindCharToEscape(pch, iLength, bJSON);
+    if (iRun == NULL_POS) iRun = iLength;
+
+    append(pch, iRun);
+    pch += iRun;
+    iLength -= iRun;
+
+    if (iLength == 0) break;
+
+    const u8 ch = u8(*pch);
+    const c8 chLetter = EscapeLetter(ch, bJSON);
+
+    if (chLetter != 'u') {
+      const c8 strEscape[2] = { '\\', chLetter };
+      append(strEscape, 2);
+
+    } else if (bJSON) {
+      // Unicode code point, e.g. "\u001F"
+      const c8 strEscape[6] = { '\\', 'u', '0', '0', "0123456789abcdef"[ch >> 4], "0123456789abcdef"[ch & 0xF] };
+      append(strEscape, 6);
+
+    } else {
+      // Three octal digits that can't be mistaken for the following characters
+      const c8 strEscape[4] = { '\\', c8('0' + (ch >> 6)), c8('0' + ((ch >> 3) & 7)), c8('0' + (ch & 7)) };
+      append(strEscape, 4);
     }
 
-    // Find the next escape character
-    iEscapeSeq = find('\\', iEscapeSeq + 1);
-    ++iReplaced;
+    ++pch;
+    --iLength;
   }
 };
 
+// Skip leading whitespace like sscanf() does
+static size_t SkipSpaces(const CString &str) {
+  size_t i = 0;
+  while (i < str.length() && ::isspace(static_cast<u8>(str[i]))) ++i;
+
+  return i;
+};
+
 s64 CString::ToS64(void) const {
-  s64 i64bit;
-  sscanf_s(c_str(), "%lld", &i64bit);
+  const size_t iStart = SkipSpaces(*this);
 
-  return i64bit;
+  s64 iValue = 0;
+  ParseS64(data() + iStart, length() - iStart, iValue);
+
+  return iValue;
 };
 
 u64 CString::ToU64(void) const {
-  u64 i64bit;
-  sscanf_s(c_str(), "%llu", &i64bit);
+  const size_t iStart = SkipSpaces(*this);
+
+  u64 iValue = 0;
+  ParseU64(data() + iStart, length() - iStart, iValue);
 
-  return i64bit;
+  return iValue;
 };
 
 c8 CString::CharToLower(c8 ch) {
@@ -106,12 +384,111 @@ bool CString::CompareChars(c8 ch1, c8 ch2) {
   return CharToLower(ch1) == CharToLower(ch2);
 };
 
+// Quick case-insensitive check for ASCII characters that falls back to CompareChars() for others
+static inline bool CompareCharsFast(c8 ch1, c8 ch2) {
+  if (ch1 == ch2) return true;
+
+  const u8 ub1 = static_cast<u8>(ch1);
+  const u8 ub2 = static_cast<u8>(ch2);
+
+  // Non-ASCII characters depend on the locale
+  if ((ub1 | ub2) & 0x80) return CString::CompareChars(ch1, ch2);
+
+  // Only letters can differ by case
+  const u8 ubLower = ub1 | 0x20;
+  return ubLower == (ub2 | 0x20) && ubLower >= 'a' && ubLower <= 'z';
+};
+
+#if _DREAMY_SSE2
+
+// Convert ASCII letters within a block into a specific case
+// Lowercase: chFirst = 'A'; Uppercase: chFirst = 'a'
+static inline __m128i ChangeCase_SSE2(__m128i v, c8 chFirst) {
+  // Shift the letter range to the bottom of signed bytes and compare it
+  const __m128i vShifted = _mm_add_epi8(v, _mm_set1_epi8(c8(0x80 - chFirst)));
+  const __m128i vLetters = _mm_cmplt_epi8(vShifted, _mm_set1_epi8(-128 + 26));
+
+  return _mm_xor_si128(v, _mm_and_si128(vLetters, _mm_set1_epi8(0x20)));
+};
+
+#endif
+
+// Convert characters into a specific case, vectorizing blocks of ASCII characters
+static void ChangeCharsCase(c8 *pch, size_t iLength, bool bLower) {
+  size_t i = 0;
+
+#if _DREAMY_SSE2
+  const c8 chFirst = (bLower ? 'A' : 'a');
+
+  for (; i + 16 <= iLength; i += 16) {
+    const __m128i v = _mm_loadu_si128((const __m128i *)(pch + i));
+
+    // Non-ASCII characters depend on the locale
+    if (_mm_movemask_epi8(v) != 0) {
+      for (size_t j = i; j < i + 16; ++j) {
+        pch[j] = (bLower ? CString::CharToLower(pch[j]) : CString::CharToUpper(pch[j]));
+      }
+      continue;
+    }
+
+    _mm_storeu_si128((__m128i *)(pch + i), ChangeCase_SSE2(v, chFirst));
+  }
+#endif
+
+  for (; i < iLength; ++i) {
+    pch[i] = (bLower ? CString::CharToLower(pch[i]) : CString::CharToUpper(pch[i]));
+  }
+};
+
+void CString::CharsToLower(c8 *pch, size_t iLength) {
+  ChangeCharsCase(pch, iLength, true);
+};
+
+void CString::CharsToUpper(c8 *pch, size_t iLength) {
+  ChangeCharsCase(pch, iLength, false);
+};
+
+bool CString::CompareChars(const c8 *pch1, const c8 *pch2, size_t iLength) {
+  size_t i = 0;
+
+#if _DREAMY_SSE2
+  for (; i + 16 <= iLength; i += 16) {
+    const __m128i v1 = _mm_loadu_si128((const __m128i *)(pch1 + i));
+    const __m128i v2 = _mm_loadu_si128((const __m128i *)(pch2 + i));
+
+    // Exactly the same
+    if (_mm_movemask_epi8(_mm_cmpeq_epi8(v1, v2)) == 0xFFFF) continue;
+
+    // Compare non-ASCII characters one by one
+    if (_mm_movemask_epi8(_mm_or_si128(v1, v2)) != 0) {
+      for (size_t j = i; j < i + 16; ++j) {
+        if (!CompareCharsFast(pch1[j], pch2[j])) return false;
+      }
+      continue;
+    }
+
+    const __m128i vLower1 = ChangeCase_SSE2(v1, 'A');
+    const __m128i vLower2 = ChangeCase_SSE2(v2, 'A');
+
+    if (_mm_movemask_epi8(_mm_cmpeq_epi8(vLower1, vLower2)) != 0xFFFF) return false;
+  }
+#endif
+
+  for (; i < iLength; ++i) {
+    if (!CompareCharsFast(pch1[i], pch2[i])) return false;
+  }
+
+  return true;
+};
+
 void CString::ToLower(void) {
-  std::transform(begin(), end(), begin(), CString::CharToLower);
+  if (empty()) return;
+  CharsToLower(&(*this)[0], length());
 };
 
 void CString::ToUpper(void) {
-  std::transform(begin(), end(), begin(), CString::CharToUpper);
+  if (empty()) return;
+  CharsToUpper(&(*this)[0], length());
 };
 
 CString CString::AsLower(void) const {
@@ -131,19 +508,25 @@ void CString::Replace(c8 chOld, c8 chNew) {
 };
 
 bool CString::Compare(const CString &str) const {
-  return size() == str.size() && std::equal(begin(), end(), str.begin(), CompareChars);
+  return size() == str.size() && CompareChars(data(), str.data(), size());
 };
 
-bool CString::StartsWith(const CString &str) const {
-  return rfind(str, 0) != NULL_POS;
+bool CString::StartsWith(const CString &str, bool bCaseSensitive) const {
+  const size_t ctOther = str.length();
+  if (ctOther > length()) return false;
+
+  if (bCaseSensitive) return memcmp(data(), str.data(), ctOther) == 0;
+  return CompareChars(data(), str.data(), ctOther);
 };
 
-bool CString::EndWith(const CString &str) const {
+bool CString::EndWith(const CString &str, bool bCaseSensitive) const {
   const size_t ctThis = length();
   const size_t ctOther = str.length();
 
   if (ctOther > ctThis) return false;
-  return find(str, ctThis - ctOther) != NULL_POS;
+
+  if (bCaseSensitive) return memcmp(data() + ctThis - ctOther, str.data(), ctOther) == 0;
+  return CompareChars(data() + ctThis - ctOther, str.data(), ctOther);
 };
 
 bool CString::WildcardMatch(const c8 *str, const c8 *strWildcardMask) {
@@ -208,7 +591,7 @@ bool CString::WildcardMatch(const c8 *str, const c8 *strWildcardMask) {
     }
 
     // Current characters don't match and it's either an "any character" wildcard or an escape sequence
-    if (!CString::CompareChars(*pchMask, *pchCur) && (*pchMask != '?' || bEscapeChar)) {
+    if (!CompareCharsFast(*pchMask, *pchCur) && (*pchMask != '?' || bEscapeChar)) {
       // Expected a wildcard
       if (!bWildcard) return false;
 
@@ -271,82 +654,155 @@ CString CString::GetFileExt(void) const {
   return substr(iPeriodPos);
 };
 
+// Check if a directory name is at some position in the path (case insensitive; any path separators in the path)
+static bool DirNameAt(const CString &strPath, size_t iPos, const CString &strDirName) {
+  const size_t ctName = strDirName.length();
+
+  for (size_t i = 0; i < ctName; ++i) {
+    c8 chPath = strPath[iPos + i];
+    c8 chName = strDirName[i];
+
+    if (chPath == '\\') chPath = '/';
+
+    if (!CompareCharsFast(chPath, chName)) return false;
+  }
+
+  return true;
+};
+
 // Go up the path until a certain directory
 size_t CString::GoUpUntilDir(CString strDirName) const {
-  // Convert every string in the same case
-  CString strPath = AsLower();
-  strDirName.ToLower();
+  const size_t ctPath = length();
+  const size_t ctName = strDirName.length();
 
-  // Make consistent slashes
-  strPath.Replace('\\', '/');
+  if (ctName > ctPath) return NULL_POS;
 
   // Absolute path, e.g. "abc/strDirName/qwe"
-  size_t iDir(strPath.rfind("/" + strDirName + "/"));
-  if (iDir != NULL_POS) return iDir + 1;
+  if (ctPath >= ctName + 2) {
+    for (size_t iDir = ctPath - ctName - 1; iDir > 0; --iDir) {
+      if (PathSeparatorAt(iDir - 1) && PathSeparatorAt(iDir + ctName) && DirNameAt(*this, iDir, strDirName)) {
+        return iDir;
+      }
+    }
+  }
 
   // Relative down to the desired directory, e.g. "abc/qwe/strDirName"
-  iDir = strPath.rfind("/" + strDirName) + 1;
-  if (iDir == strPath.length() - strDirName.length()) return iDir;
+  const size_t iLast = ctPath - ctName;
+
+  if (iLast > 0 && PathSeparatorAt(iLast - 1) && DirNameAt(*this, iLast, strDirName)) {
+    return iLast;
+  }
 
   // Relative up to the desired directory, e.g. "strDirName/abc/qwe"
-  iDir = strPath.find(strDirName + "/");
-  if (iDir == 0) return 0;
+  if (ctPath > ctName && PathSeparatorAt(ctName) && DirNameAt(*this, 0, strDirName)) {
+    return 0;
+  }
 
   // No extra directories up or down the path, must be the same
-  if (strPath == strDirName) {
+  if (ctPath == ctName && DirNameAt(*this, 0, strDirName)) {
     return 0;
   }
 
   return NULL_POS;
 };
 
-// Normalize the path taking "backward" and "current" directories into consideration
-// E.g. "abc/sub1/../sub2/./qwe" -> "abc/sub2/qwe" or ".././.." -> "../.."
-void CString::Normalize(void) {
-  CString strPath(*this);
-  strPath.Replace('\\', '/');
+// Positions of path segments written so far, kept on the stack for typical paths
+class CPathSegments {
+
+private:
+  size_t _aFixed[32];
+  std::vector<size_t> _aExtra;
+  size_t _ct;
+
+public:
+  CPathSegments() : _ct(0) {};
+
+  inline void Clear(void) {
+    _aExtra.clear();
+    _ct = 0;
+  };
+
+  inline size_t Count(void) const {
+    return _ct;
+  };
+
+  inline void Push(size_t iPos) {
+    if (_ct < 32) {
+      _aFixed[_ct] = iPos;
+    } else {
+      _aExtra.push_back(iPos);
+    }
+
+    ++_ct;
+  };
+
+  inline void Pop(void) {
+    if (--_ct >= 32) _aExtra.pop_back();
+  };
+
+  inline size_t Top(void) const {
+    return (_ct <= 32) ? _aFixed[_ct - 1] : _aExtra.back();
+  };
+};
+
+// Check if the last written segment is a "backward" directory
+static inline bool LastSegmentIsBackward(const c8 *pch, size_t iWrite, const CPathSegments &aSegments) {
+  return iWrite - aSegments.Top() == 2 && pch[iWrite - 2] == '.' && pch[iWrite - 1] == '.';
+};
 
-  // Gather parts of the entire path
-  std::list<CString> aParts;
-  strPath.CharSplit('/', aParts);
+// Normalize path characters in place and return the new length
+static size_t NormalizePath(c8 *pch, const size_t ctLength, CPathSegments &aSegments) {
+  aSegments.Clear();
 
-  std::list<CString> aFinalPath;
-  std::list<CString>::const_iterator it;
+  size_t iWrite = 0;
+  size_t iRead = 0;
 
-  // Iterate through the list of directories
-  for (it = aParts.begin(); it != aParts.end(); ++it) {
-    const CString &strPart = *it;
+  // Reading always stays ahead of writing because parts are only removed
+  while (true) {
+    // Find the end of the current part
+    size_t iEnd = iRead;
+    while (iEnd < ctLength && pch[iEnd] != '/' && pch[iEnd] != '\\') ++iEnd;
+
+    const c8 *pchPart = pch + iRead;
+    const size_t ctPart = iEnd - iRead;
+
+    const bool bCurrent = (ctPart == 1 && pchPart[0] == '.');
+    const bool bBackward = (ctPart == 2 && pchPart[0] == '.' && pchPart[1] == '.');
 
     // Ignore current directories
-    if (strPart == ".") continue;
+    if (bCurrent) {
+      // Skip it
 
     // If encountered a "backward" directory and there are some directories written
     // AND it's not another "backward" directory (that has been written because it can't go up any more)
-    if (strPart == ".." && !aFinalPath.empty() && aFinalPath.back() != "..") {
-      // Remove the last directory (go up one directory) and go to the next one
-      aFinalPath.pop_back();
-      continue;
-    }
+    } else if (bBackward && aSegments.Count() != 0 && !LastSegmentIsBackward(pch, iWrite, aSegments)) {
+      // Remove the last directory with its separator
+      iWrite = (aSegments.Count() > 1) ? aSegments.Top() - 1 : 0;
+      aSegments.Pop();
 
-    // Add directory to the final path
-    aFinalPath.push_back(strPart);
-  }
+    } else {
+      // Add separators between the directories
+      if (aSegments.Count() != 0) pch[iWrite++] = '/';
 
-  // Reset current path
-  *this = "";
+      aSegments.Push(iWrite);
+      memmove(pch + iWrite, pchPart, ctPart);
+      iWrite += ctPart;
+    }
 
-  // No path to compose
-  if (aFinalPath.size() == 0) return;
+    if (iEnd >= ctLength) break;
+    iRead = iEnd + 1;
+  }
 
-  // Compose the final path
-  std::list<CString>::const_iterator itLast = --aFinalPath.end();
+  return iWrite;
+};
 
-  for (it = aFinalPath.begin(); it != aFinalPath.end(); ++it) {
-    *this += *it;
+// Normalize the path taking "backward" and "current" directories into consideration
+// E.g. "abc/sub1/../sub2/./qwe" -> "abc/sub2/qwe"
+void CString::Normalize(void) {
+  if (empty()) return;
 
-    // Add separators between the directories
-    if (it != itLast) *this += '/';
-  }
+  CPathSegments aSegments;
+  resize(NormalizePath(&(*this)[0], length(), aSegments));
 };
 
 // Get length of the root name, if there's any
@@ -375,6 +831,38 @@ size_t CString::RootNameLength() const {
   return 0;
 };
 
+size_t VPrintToBuffer(c8 *pBuffer, size_t iBufferSize, const c8 *strFormat, va_list arg) {
+  if (iBufferSize == 0) return NULL_POS;
+
+  const s32 iLength = vsnprintf(pBuffer, iBufferSize, strFormat, arg);
+
+  // Old printing functions don't terminate truncated strings
+  pBuffer[iBufferSize - 1] = '\0';
+
+  return (iLength >= 0) ? size_t(iLength) : NULL_POS;
+};
+
+size_t PrintToBuffer(c8 *pBuffer, size_t iBufferSize, const c8 *strFormat, ...) {
+  va_list arg;
+  va_start(arg, strFormat);
+  const size_t iLength = VPrintToBuffer(pBuffer, iBufferSize, strFormat, arg);
+  va_end(arg);
+
+  return iLength;
+};
+
+void NormalizePaths(CString *aPaths, size_t ct) {
+  // Share segment positions between all paths
+  CPathSegments aSegments;
+
+  for (size_t i = 0; i < ct; ++i) {
+    CString &strPath = aPaths[i];
+    if (strPath.empty()) continue;
+
+    strPath.resize(NormalizePath(&strPath[0], strPath.length(), aSegments));
+  }
+};
+
 u64 MultiCharLiteral(const c8 strLiteral[9]) {
   // Empty literal
   if (strLiteral[0] == '\0') return 0;
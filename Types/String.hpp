@@ -6,6 +6,8 @@
 
 #include "../DreamyUtilitiesBase.hpp"
 
+#include "StringSplitter.hpp"
+
 #include <string>
 #include <vector>
 
@@ -31,13 +33,15 @@ public:
 
   CString(size_t iSize, c8 ch) : CStringBase(iSize, ch) {};
 
+  CString(const CStringView &str) : CStringBase(str.data(), str.length()) {};
+
   template<typename Iter>
   CString(Iter itFirst, Iter itLast) : CStringBase(itFirst, itLast) {};
 
 #if _DREAMY_CPP11
   CString(std::initializer_list<c8> il) : CStringBase(il) {};
 
-  CString(CStringBase &&str) DREAMY_NOEXCEPT : CStringBase(str) {};
+  CString(CStringBase &&str) DREAMY_NOEXCEPT : CStringBase(std::move(str)) {};
 #endif
 
 // Generic methods
@@ -49,9 +53,27 @@ public:
   // Custom string formatting
   void PrintF(const c8 *strFormat, ...);
 
+  // Append formatted text to the string using a list of arguments
+  void VAppendF(const c8 *strFormat, va_list arg);
+
+  // Append formatted text to the string
+  void AppendF(const c8 *strFormat, ...);
+
   // Convert character escape sequences into escape characters
+  // Supports single letters, "\xHH", "\uXXXX" (in UTF-8, lone surrogates become U+FFFD) and up to three octal digits
+  // Throws CFormattingException with the original position of an invalid sequence, which is left unconverted with the rest of the string
   void ConvertEscapeChars(void);
 
+  // Append characters with special ones replaced by escape sequences for JSON or C strings
+  void AppendEscaped(const c8 *pch, size_t iLength, bool bJSON = true);
+
+  // Get a copy of the string with special characters replaced by escape sequences for JSON or C strings
+  inline CString AsEscaped(bool bJSON = true) const {
+    CString strEscaped;
+    strEscaped.AppendEscaped(data(), length(), bJSON);
+    return strEscaped;
+  };
+
   // Convert real number into a string without trailing zeros
   template<typename Type>
   void FromReal(const Type fNumber) {
@@ -98,6 +120,15 @@ public:
   // Check if two characters are equal (case insensitive)
   static bool CompareChars(c8 ch1, c8 ch2);
 
+  // Convert an array of characters into lowercase
+  static void CharsToLower(c8 *pch, size_t iLength);
+
+  // Convert an array of characters into uppercase
+  static void CharsToUpper(c8 *pch, size_t iLength);
+
+  // Check if two arrays of characters are equal (case insensitive)
+  static bool CompareChars(const c8 *pch1, const c8 *pch2, size_t iLength);
+
   // Convert entire string into lowercase
   void ToLower(void);
 
@@ -117,57 +148,33 @@ public:
   bool Compare(const CString &str) const;
 
   // Check if a string starts with a substring
-  bool StartsWith(const CString &str) const;
+  bool StartsWith(const CString &str, bool bCaseSensitive = true) const;
 
   // Check if a string ends with a substring
-  bool EndWith(const CString &str) const;
+  bool EndWith(const CString &str, bool bCaseSensitive = true) const;
 
   // Split a string using a character delimiter
+  // Containers of CStringView receive views into this string instead of copies
   template<typename TypeContainer>
   void CharSplit(const c8 chDelimiter, TypeContainer &aStrings) const {
-    size_t iLast = 0;
-    size_t iPos = find(chDelimiter);
-
-    while (iPos != NULL_POS) {
-      aStrings.push_back(substr(iLast, iPos - iLast));
-
-      // Skip delimiter
-      iPos += 1;
+    CStringSplitter split(*this, chDelimiter);
+    CStringView strToken;
 
-      // Remember position after the delimiter
-      iLast = iPos;
-
-      // Get position of the next one
-      iPos = find(chDelimiter, iPos);
+    while (split.Next(strToken)) {
+      aStrings.push_back(typename TypeContainer::value_type(strToken.data(), strToken.length()));
     }
-
-    // Last token
-    aStrings.push_back(substr(iLast));
   };
 
   // Split a string using a string delimiter
+  // Containers of CStringView receive views into this string instead of copies
   template<typename TypeContainer>
-  void StringSplit(const CString &strDelimiter, TypeContainer &aStrings) const {
-    const size_t iSize = strDelimiter.length();
-
-    size_t iLast = 0;
-    size_t iPos = find(strDelimiter);
-
-    while (iPos != NULL_POS) {
-      aStrings.push_back(substr(iLast, iPos - iLast));
-
-      // Skip delimiter
-      iPos += iSize;
-
-      // Remember position after the delimiter
-      iLast = iPos;
+  void StringSplit(const CStringView &strDelimiter, TypeContainer &aStrings) const {
+    CStringSplitter split(*this, strDelimiter);
+    CStringView strToken;
 
-      // Get position of the next one
-      iPos = find(strDelimiter, iPos);
+    while (split.Next(strToken)) {
+      aStrings.push_back(typename TypeContainer::value_type(strToken.data(), strToken.length()));
     }
-
-    // Last token
-    aStrings.push_back(substr(iLast));
   };
 
   // Compare strings using wildcards
@@ -243,6 +250,22 @@ public:
   va_end(arg); \
 }
 
+// Format text into a fixed buffer using a list of arguments (always null-terminated)
+// Returns full length of the formatted text, which may exceed the buffer, or NULL_POS if it's unknown
+size_t VPrintToBuffer(c8 *pBuffer, size_t iBufferSize, const c8 *strFormat, va_list arg);
+
+// Format text into a fixed buffer (always null-terminated)
+// Returns full length of the formatted text, which may exceed the buffer, or NULL_POS if it's unknown
+size_t PrintToBuffer(c8 *pBuffer, size_t iBufferSize, const c8 *strFormat, ...);
+
+// Normalize an array of paths (see CString::Normalize)
+void NormalizePaths(CString *aPaths, size_t ct);
+
+// Normalize a list of paths (see CString::Normalize)
+inline void NormalizePaths(std::vector<CString> &aPaths) {
+  if (!aPaths.empty()) NormalizePaths(&aPaths[0], aPaths.size());
+};
+
 // Convert string up to 8 characters into a 64-bit integer in constant order
 u64 MultiCharLiteral(const c8 strLiteral[9]);
 
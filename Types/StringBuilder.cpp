@@ -0,0 +1,170 @@
+//! This file is a part of Dreamy Utilities.
+//! Licensed under the MIT license (see LICENSE file).
+
+#include "StringBuilder.hpp"
+
+namespace dreamy {
+
+void CStringBuilder::Clear(void) {
+  const size_t ct = _aBlocks.size();
+
+  for (size_t i = 0; i < ct; ++i) {
+    delete[] _aBlocks[i].pData;
+  }
+
+  _aBlocks.clear();
+  _iLength = 0;
+  _iNextBlock = MIN_BLOCK;
+};
+
+CStringBuilder::Block &CStringBuilder::AddBlock(size_t iMinCapacity) {
+  Block block;
+  block.iUsed = 0;
+  block.iCapacity = (iMinCapacity > _iNextBlock) ? iMinCapacity : _iNextBlock;
+  block.pData = new c8[block.iCapacity];
+
+  // Allocate larger blocks as the string grows
+  if (_iNextBlock < MAX_BLOCK) _iNextBlock *= 2;
+
+  _aBlocks.push_back(block);
+  return _aBlocks.back();
+};
+
+void CStringBuilder::Reserve(size_t iSize) {
+  if (iSize == 0) return;
+
+  if (!_aBlocks.empty()) {
+    Block &block = _aBlocks.back();
+    if (block.iCapacity - block.iUsed >= iSize) return;
+
+    // Replace an unused block instead of leaving it behind
+    if (block.iUsed == 0) {
+      delete[] block.pData;
+      _aBlocks.pop_back();
+    }
+  }
+
+  AddBlock(iSize);
+};
+
+CStringBuilder &CStringBuilder::Append(const c8 *pch, size_t iLength) {
+  if (iLength == 0) return *this;
+
+  _iLength += iLength;
+
+  // Fill the rest of the current block
+  if (!_aBlocks.empty()) {
+    Block &block = _aBlocks.back();
+    const size_t iFree = block.iCapacity - block.iUsed;
+
+    if (iLength <= iFree) {
+      memcpy(block.pData + block.iUsed, pch, iLength);
+      block.iUsed += iLength;
+      return *this;
+    }
+
+    memcpy(block.pData + block.iUsed, pch, iFree);
+    block.iUsed += iFree;
+
+    pch += iFree;
+    iLength -= iFree;
+  }
+
+  // Put everything else into one new block
+  Block &block = AddBlock(iLength);
+  memcpy(block.pData, pch, iLength);
+  block.iUsed = iLength;
+
+  return *this;
+};
+
+CStringBuilder &CStringBuilder::Append(size_t ct, c8 ch) {
+  if (ct == 0) return *this;
+
+  Reserve(ct);
+
+  Block &block = _aBlocks.back();
+  memset(block.pData + block.iUsed, ch, ct);
+  block.iUsed += ct;
+
+  _iLength += ct;
+  return *this;
+};
+
+void CStringBuilder::VPrintF(const c8 *strFormat, va_list arg) {
+  // Try printing into the rest of the current block first
+  Reserve(1);
+
+  Block *pBlock = &_aBlocks.back();
+
+  va_list argCopy;
+  va_copy(argCopy, arg);
+  const size_t iLength = VPrintToBuffer(pBlock->pData + pBlock->iUsed, pBlock->iCapacity - pBlock->iUsed, strFormat, argCopy);
+  va_end(argCopy);
+
+  // Length is unknown
+  if (iLength == NULL_POS) {
+    CString strOut;
+    strOut.VPrintF(strFormat, arg);
+
+    Append(strOut.data(), strOut.length());
+    return;
+  }
+
+  // Print again into a block that fits the entire text with the null terminator
+  if (iLength >= pBlock->iCapacity - pBlock->iUsed) {
+    Reserve(iLength + 1);
+
+    pBlock = &_aBlocks.back();
+    VPrintToBuffer(pBlock->pData + pBlock->iUsed, iLength + 1, strFormat, arg);
+  }
+
+  // Terminator is left outside the string
+  pBlock->iUsed += iLength;
+  _iLength += iLength;
+};
+
+void CStringBuilder::PrintF(const c8 *strFormat, ...) {
+  DREAMY_PRINTF_INLINE(*this, strFormat);
+};
+
+void CStringBuilder::CopyTo(c8 *pBuffer) const {
+  const size_t ct = _aBlocks.size();
+
+  for (size_t i = 0; i < ct; ++i) {
+    const Block &block = _aBlocks[i];
+    if (block.iUsed == 0) continue;
+
+    memcpy(pBuffer, block.pData, block.iUsed);
+    pBuffer += block.iUsed;
+  }
+};
+
+void CStringBuilder::ToString(CString &str) const {
+  str.resize(_iLength);
+  if (_iLength != 0) CopyTo(&str[0]);
+};
+
+void CStringBuilder::ToByteArray(CByteArray &ba) const {
+  ba.Clear();
+  if (_iLength == 0) return;
+
+  ba.Resize(_iLength);
+  CopyTo(ba.Data());
+};
+
+size_t CStringBuilder::WriteTo(IReadWriteDevice &d) const {
+  const size_t ct = _aBlocks.size();
+  if (ct == 0) return 0;
+
+  std::vector<IReadWriteDevice::DataChunk> aChunks(ct);
+
+  for (size_t i = 0; i < ct; ++i) {
+    aChunks[i].pData = _aBlocks[i].pData;
+    aChunks[i].iSize = _aBlocks[i].iUsed;
+  }
+
+  return d.WriteChunks(&aChunks[0], ct);
+};
+
+}; // namespace dreamy
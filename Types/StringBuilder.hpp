@@ -0,0 +1,165 @@
+//! This file is a part of Dreamy Utilities.
+//! Licensed under the MIT license (see LICENSE file).
+
+#ifndef _DREAMYUTILITIES_INCL_STRINGBUILDER_H
+#define _DREAMYUTILITIES_INCL_STRINGBUILDER_H
+
+#include "../DreamyUtilitiesBase.hpp"
+
+#include "ByteArray.hpp"
+#include "String.hpp"
+#include "StringView.hpp"
+#include "../IO/ReadWriteDevice.hpp"
+
+#include <vector>
+
+namespace dreamy {
+
+// Builder of large strings that appends characters into a list of blocks
+// Appended content is never moved until the final string is assembled with a single copy
+class CStringBuilder {
+
+private:
+  // One block of characters
+  struct Block {
+    c8 *pData;
+    size_t iUsed; // Amount of written characters
+    size_t iCapacity;
+  };
+
+  std::vector<Block> _aBlocks;
+  size_t _iLength; // Amount of characters in all blocks
+  size_t _iNextBlock; // Capacity of the next allocated block
+
+public:
+  // Smallest and largest capacity of automatically allocated blocks
+  enum {
+    MIN_BLOCK = (1 << 12),
+    MAX_BLOCK = (1 << 22),
+  };
+
+public:
+  // Default constructor
+  CStringBuilder() : _iLength(0), _iNextBlock(MIN_BLOCK) {};
+
+  // Constructor with an expected amount of characters
+  CStringBuilder(size_t iReserve) : _iLength(0), _iNextBlock(MIN_BLOCK) {
+    Reserve(iReserve);
+  };
+
+  // Destructor
+  ~CStringBuilder() {
+    Clear();
+  };
+
+  // Free all blocks
+  void Clear(void);
+
+  // Get amount of characters
+  inline size_t Length(void) const {
+    return _iLength;
+  };
+
+  // Check if there are no characters
+  inline bool IsEmpty(void) const {
+    return _iLength == 0;
+  };
+
+  // Get amount of allocated blocks
+  inline size_t CountBlocks(void) const {
+    return _aBlocks.size();
+  };
+
+  // Make sure that a certain amount of characters can be appended without allocating memory
+  void Reserve(size_t iSize);
+
+  // Append a range of characters
+  CStringBuilder &Append(const c8 *pch, size_t iLength);
+
+  // Append a null-terminated string
+  inline CStringBuilder &Append(const c8 *str) {
+    return Append(str, strlen(str));
+  };
+
+  // Append a string
+  inline CStringBuilder &Append(const CStringView &str) {
+    return Append(str.data(), str.length());
+  };
+
+  // Append a byte array
+  inline CStringBuilder &Append(const CByteArray &ba) {
+    return Append(ba.ConstData(), ba.Size());
+  };
+
+  // Append a character multiple times
+  CStringBuilder &Append(size_t ct, c8 ch);
+
+  // Append one character
+  inline CStringBuilder &Append(c8 ch) {
+    // Fast path for the current block
+    if (!_aBlocks.empty()) {
+      Block &block = _aBlocks.back();
+
+      if (block.iUsed < block.iCapacity) {
+        block.pData[block.iUsed++] = ch;
+        ++_iLength;
+        return *this;
+      }
+    }
+
+    return Append(&ch, 1);
+  };
+
+  // Print formatted text using a list of arguments
+  void VPrintF(const c8 *strFormat, va_list arg);
+
+  // Print formatted text
+  void PrintF(const c8 *strFormat, ...);
+
+  inline CStringBuilder &operator+=(const c8 *str) {
+    return Append(str);
+  };
+
+  inline CStringBuilder &operator+=(const CStringView &str) {
+    return Append(str);
+  };
+
+  inline CStringBuilder &operator+=(const CByteArray &ba) {
+    return Append(ba);
+  };
+
+  inline CStringBuilder &operator+=(c8 ch) {
+    return Append(ch);
+  };
+
+  // Copy all characters into a contiguous buffer of at least Length() bytes
+  void CopyTo(c8 *pBuffer) const;
+
+  // Assemble all characters into a string
+  void ToString(CString &str) const;
+
+  // Assemble all characters into a string
+  inline CString ToString(void) const {
+    CString str;
+    ToString(str);
+    return str;
+  };
+
+  // Assemble all characters into a byte array
+  void ToByteArray(CByteArray &ba) const;
+
+  // Write all blocks into a device at once and return amount of written bytes
+  size_t WriteTo(IReadWriteDevice &d) const;
+
+private:
+  // Add a new block that can fit a certain amount of characters
+  Block &AddBlock(size_t iMinCapacity);
+
+  // Builders own their blocks and cannot be copied
+  CStringBuilder(const CStringBuilder &);
+  CStringBuilder &operator=(const CStringBuilder &);
+};
+
+}; // namespace dreamy
+
+#endif // (Dreamy Utilities Include Guard)
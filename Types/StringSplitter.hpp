@@ -0,0 +1,182 @@
+//! This file is a part of Dreamy Utilities.
+//! Licensed under the MIT license (see LICENSE file).
+
+#ifndef _DREAMYUTILITIES_INCL_STRINGSPLITTER_H
+#define _DREAMYUTILITIES_INCL_STRINGSPLITTER_H
+
+#include "../DreamyUtilitiesBase.hpp"
+
+#include "CharSet.hpp"
+#include "StringView.hpp"
+
+namespace dreamy {
+
+// Lazy string splitter that yields tokens as views into the original string
+// The string and the delimiter string must outlive the splitter
+class CStringSplitter {
+
+public:
+  // Delimiter types
+  enum EDelimiter {
+    DELIM_CHAR,   // Single character
+    DELIM_STRING, // Sequence of characters
+    DELIM_SET,    // Any character from a set
+  };
+
+  // Forward iterator over the tokens
+  class iterator {
+
+  private:
+    const CStringSplitter *_pSplitter;
+    size_t _iNext; // Position of the next token (NULL_POS after the last one)
+    CStringView _strToken;
+    bool _bEnd;
+
+  public:
+    // End iterator
+    iterator() : _pSplitter(nullptr), _iNext(NULL_POS), _bEnd(true) {};
+
+    // Iterator at the first token
+    iterator(const CStringSplitter &split) : _pSplitter(&split), _iNext(0), _bEnd(false) {
+      ++(*this);
+    };
+
+    inline const CStringView &operator*(void) const {
+      return _strToken;
+    };
+
+    inline const CStringView *operator->(void) const {
+      return &_strToken;
+    };
+
+    inline iterator &operator++(void) {
+      _bEnd = !_pSplitter->NextFrom(_iNext, _strToken);
+      return *this;
+    };
+
+    inline bool operator==(const iterator &other) const {
+      if (_bEnd || other._bEnd) return _bEnd == other._bEnd;
+      return _strToken.data() == other._strToken.data() && _iNext == other._iNext;
+    };
+
+    inline bool operator!=(const iterator &other) const {
+      return !(*this == other);
+    };
+  };
+
+private:
+  CStringView _str;
+  size_t _iNext; // Position of the next token for Next()
+
+  EDelimiter _eType;
+  c8 _chDelimiter;
+  CStringView _strDelimiter;
+  CCharSet _set;
+  bool _bSkipEmpty;
+
+public:
+  // Split by a character
+  CStringSplitter(const CStringView &str, c8 chDelimiter, bool bSkipEmpty = false) :
+    _str(str), _iNext(0), _eType(DELIM_CHAR), _chDelimiter(chDelimiter), _bSkipEmpty(bSkipEmpty)
+  {
+  };
+
+  // Split by a string (empty delimiter doesn't split anything)
+  CStringSplitter(const CStringView &str, const CStringView &strDelimiter, bool bSkipEmpty = false) :
+    _str(str), _iNext(0), _eType(DELIM_STRING), _chDelimiter('\0'), _strDelimiter(strDelimiter), _bSkipEmpty(bSkipEmpty)
+  {
+  };
+
+  // Split by any character from a set
+  CStringSplitter(const CStringView &str, const CCharSet &set, bool bSkipEmpty = false) :
+    _str(str), _iNext(0), _eType(DELIM_SET), _chDelimiter('\0'), _set(set), _bSkipEmpty(bSkipEmpty)
+  {
+  };
+
+  // Get the next token and return false if there are none left
+  inline bool Next(CStringView &strToken) {
+    return NextFrom(_iNext, strToken);
+  };
+
+  // Start from the first token again
+  inline void Reset(void) {
+    _iNext = 0;
+  };
+
+  inline iterator begin(void) const {
+    return iterator(*this);
+  };
+
+  inline iterator end(void) const {
+    return iterator();
+  };
+
+  // Get a token at some position and advance it to the next one
+  bool NextFrom(size_t &iPos, CStringView &strToken) const {
+    while (iPos != NULL_POS) {
+      const c8 *pchRest = _str.data() + iPos;
+      const size_t iRest = _str.length() - iPos;
+
+      size_t iDelimiterLength;
+      const size_t iFound = FindDelimiter(pchRest, iRest, iDelimiterLength);
+
+      // Last token
+      if (iFound == NULL_POS) {
+        strToken = CStringView(pchRest, iRest);
+        iPos = NULL_POS;
+
+      } else {
+        strToken = CStringView(pchRest, iFound);
+        iPos += iFound + iDelimiterLength;
+      }
+
+      if (!_bSkipEmpty || !strToken.empty()) return true;
+    }
+
+    return false;
+  };
+
+private:
+  // Find the next delimiter in a character sequence
+  size_t FindDelimiter(const c8 *pch, size_t iLength, size_t &iDelimiterLength) const {
+    iDelimiterLength = 1;
+
+    switch (_eType) {
+      case DELIM_CHAR: {
+        const c8 *pchFound = (const c8 *)memchr(pch, _chDelimiter, iLength);
+        return (pchFound != nullptr) ? size_t(pchFound - pch) : NULL_POS;
+      }
+
+      case DELIM_STRING: {
+        iDelimiterLength = _strDelimiter.length();
+        if (iDelimiterLength == 0 || iDelimiterLength > iLength) return NULL_POS;
+
+        // Look for the first character and then check the rest
+        const c8 *pchDelimiter = _strDelimiter.data();
+        const size_t iLastStart = iLength - iDelimiterLength;
+
+        for (size_t i = 0; i <= iLastStart; ++i) {
+          const c8 *pchFound = (const c8 *)memchr(pch + i, *pchDelimiter, iLastStart - i + 1);
+          if (pchFound == nullptr) break;
+
+          if (memcmp(pchFound + 1, pchDelimiter + 1, iDelimiterLength - 1) == 0) {
+            return pchFound - pch;
+          }
+
+          i = pchFound - pch;
+        }
+
+        return NULL_POS;
+      }
+
+      case DELIM_SET:
+        return _set.FindFirst(pch, iLength);
+    }
+
+    return NULL_POS;
+  };
+};
+
+}; // namespace dreamy
+
+#endif // (Dreamy Utilities Include Guard)
@@ -0,0 +1,169 @@
+//! This file is a part of Dreamy Utilities.
+//! Licensed under the MIT license (see LICENSE file).
+
+#ifndef _DREAMYUTILITIES_INCL_STRINGVIEW_H
+#define _DREAMYUTILITIES_INCL_STRINGVIEW_H
+
+#include "../DreamyUtilitiesBase.hpp"
+
+#include "../Data/ByteSearch.hpp"
+
+#include <string>
+
+namespace dreamy {
+
+class CByteArray;
+
+// Non-owning view of a character sequence that isn't necessarily null-terminated
+class CStringView {
+
+private:
+  const c8 *_pch;
+  size_t _iLength;
+
+public:
+  CStringView() : _pch(""), _iLength(0) {};
+
+  CStringView(const c8 *str) : _pch(str), _iLength(strlen(str)) {};
+
+  CStringView(const c8 *pch, size_t iLength) : _pch(pch), _iLength(iLength) {};
+
+  CStringView(const std::string &str) : _pch(str.data()), _iLength(str.length()) {};
+
+  CStringView(const CByteArray &ba);
+
+  // Get pointer to the first character
+  inline const c8 *data(void) const {
+    return _pch;
+  };
+
+  // Get amount of characters
+  inline size_t length(void) const {
+    return _iLength;
+  };
+
+  inline size_t size(void) const {
+    return _iLength;
+  };
+
+  // Check if there are no characters
+  inline bool empty(void) const {
+    return _iLength == 0;
+  };
+
+  inline const c8 *begin(void) const {
+    return _pch;
+  };
+
+  inline const c8 *end(void) const {
+    return _pch + _iLength;
+  };
+
+  inline c8 operator[](size_t i) const {
+    D_ASSERT(i < _iLength);
+    return _pch[i];
+  };
+
+  // Get part of the view
+  inline CStringView substr(size_t iPos, size_t iLength = NULL_POS) const {
+    D_ASSERT(iPos <= _iLength);
+
+    const size_t iRest = _iLength - iPos;
+    return CStringView(_pch + iPos, (iLength < iRest) ? iLength : iRest);
+  };
+
+  // Get part of the view without some characters at the beginning
+  inline CStringView RemovePrefix(size_t iLength) const {
+    return substr((iLength < _iLength) ? iLength : _iLength);
+  };
+
+  // Get part of the view without some characters at the end
+  inline CStringView RemoveSuffix(size_t iLength) const {
+    return CStringView(_pch, (iLength < _iLength) ? _iLength - iLength : 0);
+  };
+
+  // Find position of the first occurrence of a character starting from some position
+  inline size_t find(c8 ch, size_t iFrom = 0) const {
+    if (iFrom >= _iLength) return NULL_POS;
+
+    const size_t iPos = FindByte(_pch + iFrom, _iLength - iFrom, ch);
+    return (iPos != NULL_POS) ? iFrom + iPos : NULL_POS;
+  };
+
+  // Find position of the first occurrence of a substring starting from some position
+  inline size_t find(const CStringView &str, size_t iFrom = 0) const {
+    if (iFrom > _iLength) return NULL_POS;
+
+    const size_t iPos = FindBytes(_pch + iFrom, _iLength - iFrom, str._pch, str._iLength);
+    return (iPos != NULL_POS) ? iFrom + iPos : NULL_POS;
+  };
+
+  // Find position of the last occurrence of a character at or before some position
+  inline size_t rfind(c8 ch, size_t iFrom = NULL_POS) const {
+    return FindLastByte(_pch, (iFrom < _iLength) ? iFrom + 1 : _iLength, ch);
+  };
+
+  // Find position of the last occurrence of a substring that begins at or before some position
+  inline size_t rfind(const CStringView &str, size_t iFrom = NULL_POS) const {
+    if (str._iLength > _iLength) return NULL_POS;
+
+    const size_t iEnd = (iFrom < _iLength - str._iLength) ? iFrom + str._iLength : _iLength;
+    return FindLastBytes(_pch, iEnd, str._pch, str._iLength);
+  };
+
+  // Count occurrences of a character
+  inline size_t Count(c8 ch) const {
+    return CountByte(_pch, _iLength, ch);
+  };
+
+  // Count non-overlapping occurrences of a substring
+  inline size_t Count(const CStringView &str) const {
+    return CountBytes(_pch, _iLength, str._pch, str._iLength);
+  };
+
+  // Check if there's a certain character
+  inline bool Contains(c8 ch) const {
+    return find(ch) != NULL_POS;
+  };
+
+  // Check if there's a certain substring
+  inline bool Contains(const CStringView &str) const {
+    return find(str) != NULL_POS;
+  };
+
+  // Check if the view starts with a substring
+  inline bool StartsWith(const CStringView &str) const {
+    return str._iLength <= _iLength && memcmp(_pch, str._pch, str._iLength) == 0;
+  };
+
+  // Check if the view ends with a substring
+  inline bool EndsWith(const CStringView &str) const {
+    return str._iLength <= _iLength && memcmp(_pch + _iLength - str._iLength, str._pch, str._iLength) == 0;
+  };
+
+  // Compare character sequences lexicographically (negative if this one goes first)
+  inline int compare(const CStringView &other) const {
+    const size_t iMin = (_iLength < other._iLength) ? _iLength : other._iLength;
+    const int iCompare = memcmp(_pch, other._pch, iMin);
+
+    if (iCompare != 0) return iCompare;
+    return (_iLength < other._iLength) ? -1 : (_iLength > other._iLength);
+  };
+
+  // Compare character sequences
+  inline bool operator==(const CStringView &other) const {
+    return _iLength == other._iLength && memcmp(_pch, other._pch, _iLength) == 0;
+  };
+
+  inline bool operator!=(const CStringView &other) const {
+    return !(*this == other);
+  };
+
+  inline bool operator<(const CStringView &other) const {
+    return compare(other) < 0;
+  };
+};
+
+}; // namespace dreamy
+
+#endif // (Dreamy Utilities Include Guard)
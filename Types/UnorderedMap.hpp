@@ -6,15 +6,102 @@
 
 #include "../DreamyUtilitiesBase.hpp"
 
-#include <list>
+#include "String.hpp"
+#include "../Data/SIMD.hpp"
+
+#include <cstring>
+#include <functional>
+#include <iterator>
+#include <memory>
 #include <stdexcept>
+#include <utility>
 
 namespace dreamy {
 
-// Own simple implementation of std::unordered_map for C++98
-template<typename Key, typename Type, typename Hash_unused = int, typename KeyEqual_unused = int,
+// Default hash function for keys of dreamy::unordered_map
+template<typename Key>
+struct MapHash {
+  inline size_t operator()(const Key &key) const {
+  #if _DREAMY_CPP11
+    return std::hash<Key>()(key);
+  #else
+    // Numbers and pointers by default, other types specialize this structure
+    return (size_t)key;
+  #endif
+  };
+};
+
+#if !_DREAMY_CPP11
+// String hash function (FNV-1a)
+template<>
+struct MapHash<CStringBase> {
+  inline size_t operator()(const CStringBase &str) const {
+    size_t iHash = 2166136261U;
+    const size_t iLength = str.length();
+
+    for (size_t i = 0; i < iLength; ++i) {
+      iHash = (iHash ^ (u8)str[i]) * 16777619U;
+    }
+
+    return iHash;
+  };
+};
+
+template<>
+struct MapHash<CString> : public MapHash<CStringBase> {
+};
+#endif
+
+// Control bytes of hash table slots in dreamy::unordered_map
+// Occupied slots store lowest 7 bits of the key hash
+enum EMapControl {
+  MAP_EMPTY   = 0x80, // Slot has never been used
+  MAP_DELETED = 0xFE, // Slot has been freed but lookups need to probe past it
+};
+
+// Amount of slots in a group that's checked at once
+enum { MAP_GROUP = 16 };
+
+// Get mask of slots in a group that have a specific control byte
+inline u32 MapGroupMatch(const u8 *pGroup, u8 iControl) {
+#if _DREAMY_SSE2
+  const __m128i vGroup = _mm_loadu_si128((const __m128i *)pGroup);
+  return (u32)_mm_movemask_epi8(_mm_cmpeq_epi8(vGroup, _mm_set1_epi8((c8)iControl)));
+
+#else
+  u32 iMask = 0;
+
+  for (u32 i = 0; i < MAP_GROUP; ++i) {
+    if (pGroup[i] == iControl) iMask |= (1 << i);
+  }
+
+  return iMask;
+#endif
+};
+
+// Get mask of slots in a group that are empty or deleted
+inline u32 MapGroupFree(const u8 *pGroup) {
+#if _DREAMY_SSE2
+  // Only free slots have the highest bit set
+  return (u32)_mm_movemask_epi8(_mm_loadu_si128((const __m128i *)pGroup));
+
+#else
+  u32 iMask = 0;
+
+  for (u32 i = 0; i < MAP_GROUP; ++i) {
+    if (pGroup[i] & 0x80) iMask |= (1 << i);
+  }
+
+  return iMask;
+#endif
+};
+
+// Own implementation of std::unordered_map for C++98
+// Open addressing hash table with groups of control bytes that are probed with SIMD
+// Pairs are stored in separate nodes that keep the insertion order and never move in memory
+template<typename Key, typename Type, typename Hash = MapHash<Key>, typename KeyEqual = std::equal_to<Key>,
   typename Allocator = std::allocator< std::pair<const Key, Type> > >
-class unordered_map : public std::list< std::pair<const Key, Type>, Allocator > {
+class unordered_map {
 
 public:
   // Dreamy Utilities styled typedefs
@@ -22,58 +109,431 @@ public:
   typedef Type T;
 
   // STL styled typedefs
+  typedef Key key_type;
+  typedef Type mapped_type;
   typedef std::pair<const Key, Type> value_type;
-  typedef std::list<value_type> _Myt;
-  typedef typename _Myt::iterator iterator;
-  typedef typename _Myt::const_iterator const_iterator;
+  typedef Hash hasher;
+  typedef KeyEqual key_equal;
+  typedef Allocator allocator_type;
+  typedef size_t size_type;
+  typedef ptrdiff_t difference_type;
+  typedef value_type &reference;
+  typedef const value_type &const_reference;
+
+private:
+  // Link between neighbor entries
+  struct Link {
+    Link *pPrev;
+    Link *pNext;
+  };
+
+  // Entry with a pair (only the pair is ever constructed)
+  struct Node : public Link {
+    size_t iHash; // Mixed hash of the key
+    value_type val;
+  };
+
+#if _DREAMY_CPP11
+  typedef typename std::allocator_traits<Allocator>::template rebind_alloc<Node> NodeAllocator;
+  typedef typename std::allocator_traits<Allocator>::template rebind_alloc<u8> ControlAllocator;
+  typedef typename std::allocator_traits<Allocator>::template rebind_alloc<Node *> SlotAllocator;
+#else
+  typedef typename Allocator::template rebind<Node>::other NodeAllocator;
+  typedef typename Allocator::template rebind<u8>::other ControlAllocator;
+  typedef typename Allocator::template rebind<Node *>::other SlotAllocator;
+#endif
+
+public:
+  class const_iterator;
+
+  // Iterator over pairs in insertion order
+  class iterator {
+    friend class unordered_map;
+    friend class const_iterator;
+
+  public:
+    typedef std::bidirectional_iterator_tag iterator_category;
+    typedef std::pair<const Key, Type> value_type;
+    typedef ptrdiff_t difference_type;
+    typedef value_type *pointer;
+    typedef value_type &reference;
+
+  private:
+    Link *_pLink;
+
+  public:
+    iterator() : _pLink(nullptr) {};
+    explicit iterator(Link *pLink) : _pLink(pLink) {};
+
+    inline reference operator*(void) const {
+      return static_cast<Node *>(_pLink)->val;
+    };
+
+    inline pointer operator->(void) const {
+      return &static_cast<Node *>(_pLink)->val;
+    };
+
+    inline iterator &operator++(void) {
+      _pLink = _pLink->pNext;
+      return *this;
+    };
+
+    inline iterator operator++(int) {
+      iterator itOld = *this;
+      _pLink = _pLink->pNext;
+      return itOld;
+    };
+
+    inline iterator &operator--(void) {
+      _pLink = _pLink->pPrev;
+      return *this;
+    };
+
+    inline iterator operator--(int) {
+      iterator itOld = *this;
+      _pLink = _pLink->pPrev;
+      return itOld;
+    };
+
+    inline bool operator==(const iterator &itOther) const {
+      return _pLink == itOther._pLink;
+    };
+
+    inline bool operator!=(const iterator &itOther) const {
+      return _pLink != itOther._pLink;
+    };
+  };
+
+  // Constant iterator over pairs in insertion order
+  class const_iterator {
+    friend class unordered_map;
+
+  public:
+    typedef std::bidirectional_iterator_tag iterator_category;
+    typedef std::pair<const Key, Type> value_type;
+    typedef ptrdiff_t difference_type;
+    typedef const value_type *pointer;
+    typedef const value_type &reference;
+
+  private:
+    const Link *_pLink;
+
+  public:
+    const_iterator() : _pLink(nullptr) {};
+    explicit const_iterator(const Link *pLink) : _pLink(pLink) {};
+    const_iterator(const iterator &it) : _pLink(it._pLink) {};
+
+    inline reference operator*(void) const {
+      return static_cast<const Node *>(_pLink)->val;
+    };
+
+    inline pointer operator->(void) const {
+      return &static_cast<const Node *>(_pLink)->val;
+    };
+
+    inline const_iterator &operator++(void) {
+      _pLink = _pLink->pNext;
+      return *this;
+    };
+
+    inline const_iterator operator++(int) {
+      const_iterator itOld = *this;
+      _pLink = _pLink->pNext;
+      return itOld;
+    };
+
+    inline const_iterator &operator--(void) {
+      _pLink = _pLink->pPrev;
+      return *this;
+    };
+
+    inline const_iterator operator--(int) {
+      const_iterator itOld = *this;
+      _pLink = _pLink->pPrev;
+      return itOld;
+    };
+
+    // Comparisons also work between both iterator types
+    friend inline bool operator==(const const_iterator &it1, const const_iterator &it2) {
+      return it1._pLink == it2._pLink;
+    };
+
+    friend inline bool operator!=(const const_iterator &it1, const const_iterator &it2) {
+      return it1._pLink != it2._pLink;
+    };
+  };
+
   typedef std::pair<iterator, bool> _Pairib;
 
+private:
+  Link _lnkEntries; // Beginning and end of the entry list (links to itself if empty)
+  size_t _ctEntries; // Amount of entries
+
+  u8 *_aControl; // Control byte per slot
+  Node **_aSlots; // Entry per occupied slot
+  size_t _ctSlots; // Amount of slots (zero or a power of two that's no less than a group)
+  size_t _ctGrowth; // Amount of empty slots that can be taken before rehashing
+
+  Hash _hash;
+  KeyEqual _equal;
+  Allocator _alloc;
+
+public:
+  // Default constructor
+  unordered_map() : _hash(), _equal(), _alloc()
+  {
+    Reset();
+  };
+
+  // Constructor with an allocator for pairs
+  explicit unordered_map(const Allocator &alloc) : _hash(), _equal(), _alloc(alloc)
+  {
+    Reset();
+  };
+
+  // Constructor with room for some amount of pairs
+  explicit unordered_map(size_t ctReserve, const Hash &hash = Hash(), const KeyEqual &equal = KeyEqual(),
+    const Allocator &alloc = Allocator()) : _hash(hash), _equal(equal), _alloc(alloc)
+  {
+    Reset();
+    reserve(ctReserve);
+  };
+
+  // Copy constructor
+  unordered_map(const unordered_map &mapOther) :
+    _hash(mapOther._hash), _equal(mapOther._equal), _alloc(mapOther._alloc)
+  {
+    Reset();
+
+    try {
+      reserve(mapOther.size());
+      insert(mapOther.begin(), mapOther.end());
+
+    } catch (...) {
+      Destroy();
+      throw;
+    }
+  };
+
+#if _DREAMY_CPP11
+  // Move constructor
+  unordered_map(unordered_map &&mapOther) DREAMY_NOEXCEPT :
+    _hash(mapOther._hash), _equal(mapOther._equal), _alloc(mapOther._alloc)
+  {
+    Reset();
+    swap(mapOther);
+  };
+#endif
+
+  // Destructor
+  ~unordered_map() {
+    Destroy();
+  };
+
+  // Assignment operator
+  unordered_map &operator=(const unordered_map &mapOther) {
+    if (this != &mapOther) {
+      unordered_map mapCopy(mapOther);
+      swap(mapCopy);
+    }
+
+    return *this;
+  };
+
+#if _DREAMY_CPP11
+  // Move assignment operator
+  unordered_map &operator=(unordered_map &&mapOther) DREAMY_NOEXCEPT {
+    if (this != &mapOther) {
+      unordered_map mapTemp(std::move(mapOther));
+      swap(mapTemp);
+    }
+
+    return *this;
+  };
+#endif
+
+  // Swap contents with another map
+  void swap(unordered_map &mapOther) DREAMY_NOEXCEPT {
+    std::swap(_lnkEntries, mapOther._lnkEntries);
+    std::swap(_ctEntries, mapOther._ctEntries);
+    std::swap(_aControl, mapOther._aControl);
+    std::swap(_aSlots, mapOther._aSlots);
+    std::swap(_ctSlots, mapOther._ctSlots);
+    std::swap(_ctGrowth, mapOther._ctGrowth);
+    std::swap(_hash, mapOther._hash);
+    std::swap(_equal, mapOther._equal);
+    std::swap(_alloc, mapOther._alloc);
+
+    // Relink ends of the lists
+    RelinkEntries();
+    mapOther.RelinkEntries();
+  };
+
+  // Get allocator for pairs
+  inline allocator_type get_allocator(void) const {
+    return _alloc;
+  };
+
+  // Get hash function
+  inline hasher hash_function(void) const {
+    return _hash;
+  };
+
+  // Get key comparison function
+  inline key_equal key_eq(void) const {
+    return _equal;
+  };
+
 public:
   // Beginning of the map
   inline iterator begin(void) {
-    return _Myt::begin();
+    return iterator(_lnkEntries.pNext);
   };
 
   // Constant beginning of the map
   inline const_iterator begin(void) const {
-    return _Myt::begin();
+    return const_iterator(_lnkEntries.pNext);
   };
 
   // End of the map
   inline iterator end(void) {
-    return _Myt::end();
+    return iterator(&_lnkEntries);
   };
 
   // Constant end of the map
   inline const_iterator end(void) const {
-    return _Myt::end();
+    return const_iterator(&_lnkEntries);
+  };
+
+  // Amount of pairs
+  inline size_t size(void) const {
+    return _ctEntries;
+  };
+
+  // Check if there are no pairs
+  inline bool empty(void) const {
+    return _ctEntries == 0;
+  };
+
+  // Amount of slots in the hash table
+  inline size_t bucket_count(void) const {
+    return _ctSlots;
+  };
+
+  // Make room for some amount of pairs without rehashing
+  void reserve(size_t ct) {
+    if (ct == 0) return;
+
+    size_t ctSlots = MAP_GROUP;
+
+    while (MaxLoad(ctSlots) < ct) {
+      // Slots and their control bytes must fit in memory
+      if (ctSlots > ~size_t(0) / 2 / (sizeof(Node *) + 1)) {
+        throw std::length_error("dreamy::unordered_map::reserve() - too many pairs");
+      }
+
+      ctSlots *= 2;
+    }
+
+    if (ctSlots > _ctSlots) Rehash(ctSlots);
+  };
+
+  // Remove all pairs while keeping the hash table
+  void clear(void) {
+    DestroyEntries();
+
+    if (_ctSlots != 0) {
+      memset(_aControl, MAP_EMPTY, _ctSlots);
+      _ctGrowth = MaxLoad(_ctSlots);
+    }
   };
 
 public:
   // Insert a new pair at the end or find an existing one
   _Pairib insert(const value_type &pair) {
-    iterator it = find(pair.first);
-    if (it != end()) return std::make_pair(it, false);
+    const size_t iHash = HashKey(pair.first);
+    const size_t iSlot = FindSlot(pair.first, iHash);
+
+    if (iSlot != NULL_POS) return std::make_pair(iterator(_aSlots[iSlot]), false);
+
+    return std::make_pair(AddNode(NewNode(pair), iHash), true);
+  };
+
+#if _DREAMY_CPP11
+  // Insert a new pair that's taken over at the end or find an existing one
+  _Pairib insert(value_type &&pair) {
+    const size_t iHash = HashKey(pair.first);
+    const size_t iSlot = FindSlot(pair.first, iHash);
+
+    if (iSlot != NULL_POS) return std::make_pair(iterator(_aSlots[iSlot]), false);
+
+    return std::make_pair(AddNode(NewNode(std::move(pair)), iHash), true);
+  };
+
+  // Construct a new pair at the end or find an existing one
+  template<typename... Args>
+  _Pairib emplace(Args &&... args) {
+    Node *pNode = NewNode(std::forward<Args>(args)...);
+    const size_t iHash = HashKey(pNode->val.first);
+    const size_t iSlot = FindSlot(pNode->val.first, iHash);
+
+    if (iSlot != NULL_POS) {
+      DeleteNode(pNode);
+      return std::make_pair(iterator(_aSlots[iSlot]), false);
+    }
+
+    return std::make_pair(AddNode(pNode, iHash), true);
+  };
+#endif
+
+  // Insert pairs from a range
+  template<typename Iter>
+  void insert(Iter itFirst, Iter itLast) {
+    for (; itFirst != itLast; ++itFirst) {
+      insert(*itFirst);
+    }
+  };
+
+  // Remove a pair and return iterator to the next one
+  iterator erase(const_iterator it) {
+    Node *pNode = static_cast<Node *>(const_cast<Link *>(it._pLink));
+    iterator itNext(pNode->pNext);
+
+    FreeSlot(FindNodeSlot(pNode));
+    Unlink(pNode);
+    DeleteNode(pNode);
 
-    return std::make_pair(_Myt::insert(end(), pair), true);
+    return itNext;
+  };
+
+  // Remove a pair under some key and return amount of removed pairs
+  size_t erase(const Key &key) {
+    const size_t iSlot = FindSlot(key, HashKey(key));
+    if (iSlot == NULL_POS) return 0;
+
+    Node *pNode = _aSlots[iSlot];
+
+    FreeSlot(iSlot);
+    Unlink(pNode);
+    DeleteNode(pNode);
+
+    return 1;
   };
 
   // Get iterator to a desired key
   iterator find(const Key &key) {
-    for (iterator it = begin(); it != end(); ++it) {
-      if (it->first == key) return it;
-    }
+    const size_t iSlot = FindSlot(key, HashKey(key));
+    if (iSlot == NULL_POS) return end();
 
-    return end();
+    return iterator(_aSlots[iSlot]);
   };
 
   // Get constant iterator to a desired key
   const_iterator find(const Key &key) const {
-    for (const_iterator it = begin(); it != end(); ++it) {
-      if (it->first == key) return it;
-    }
+    const size_t iSlot = FindSlot(key, HashKey(key));
+    if (iSlot == NULL_POS) return end();
 
-    return end();
+    return const_iterator(_aSlots[iSlot]);
   };
 
   // Get value under some key
@@ -94,11 +554,25 @@ public:
 
   // Get value under some key or create a new pair, if there's none
   Type &operator[](const Key &key) {
-    iterator it = find(key);
-    if (it == end()) it = _Myt::insert(end(), value_type(key, Type()));
+    const size_t iHash = HashKey(key);
+    const size_t iSlot = FindSlot(key, iHash);
 
-    return it->second;
+    if (iSlot != NULL_POS) return _aSlots[iSlot]->val.second;
+
+    return AddNode(NewNode(value_type(key, Type())), iHash)->second;
+  };
+
+#if _DREAMY_CPP11
+  // Get value under some key or create a new pair with a key that's taken over, if there's none
+  Type &operator[](Key &&key) {
+    const size_t iHash = HashKey(key);
+    const size_t iSlot = FindSlot(key, iHash);
+
+    if (iSlot != NULL_POS) return _aSlots[iSlot]->val.second;
+
+    return AddNode(NewNode(value_type(std::move(key), Type())), iHash)->second;
   };
+#endif
 
   // Get constant value under some key
   inline const Type &operator[](const Key &key) const {
@@ -107,19 +581,311 @@ public:
 
   // Count elements under a specific key
   inline size_t count(const Key &key) const {
-    size_t ct = 0;
+    return (FindSlot(key, HashKey(key)) != NULL_POS) ? 1 : 0;
+  };
+
+  // Check if there are any elements under a specific key
+  inline bool contains(const Key &key) const {
+    return FindSlot(key, HashKey(key)) != NULL_POS;
+  };
+
+private:
+  // Maximum amount of entries for some amount of slots (7/8 of the table)
+  static inline size_t MaxLoad(size_t ctSlots) {
+    return ctSlots - ctSlots / 8;
+  };
+
+  // Spread bits of the key hash, since identity hashes of numbers are common
+  inline size_t HashKey(const Key &key) const {
+    const u64 iMixed = (u64)_hash(key) * DREAMY_U64(0x9E3779B9, 0x7F4A7C15);
+    return size_t(iMixed ^ (iMixed >> 32));
+  };
+
+  // Make an empty map without any memory
+  void Reset(void) {
+    _lnkEntries.pPrev = _lnkEntries.pNext = &_lnkEntries;
+    _ctEntries = 0;
 
-    for (const_iterator it = begin(); it != end(); ++it) {
-      if (it->first == key) ++ct;
+    _aControl = nullptr;
+    _aSlots = nullptr;
+    _ctSlots = 0;
+    _ctGrowth = 0;
+  };
+
+  // Free all memory
+  void Destroy(void) {
+    DestroyEntries();
+    FreeTable();
+  };
+
+  // Point ends of the entry list back at the list beginning
+  void RelinkEntries(void) {
+    if (_ctEntries == 0) {
+      _lnkEntries.pPrev = _lnkEntries.pNext = &_lnkEntries;
+    } else {
+      _lnkEntries.pNext->pPrev = &_lnkEntries;
+      _lnkEntries.pPrev->pNext = &_lnkEntries;
     }
+  };
+
+  // Delete all entries without touching the hash table
+  void DestroyEntries(void) {
+    Link *pLink = _lnkEntries.pNext;
 
-    return ct;
+    while (pLink != &_lnkEntries) {
+      Node *pNode = static_cast<Node *>(pLink);
+      pLink = pLink->pNext;
+
+      DeleteNode(pNode);
+    }
+
+    _lnkEntries.pPrev = _lnkEntries.pNext = &_lnkEntries;
+    _ctEntries = 0;
   };
 
-  // Check if there are any elements under a specific key
-  inline bool contains(const Key &key) const {
-    return find(key) != end();
+  // Free the hash table
+  void FreeTable(void) {
+    if (_ctSlots == 0) return;
+
+    ControlAllocator(_alloc).deallocate(_aControl, _ctSlots);
+    SlotAllocator(_alloc).deallocate(_aSlots, _ctSlots);
+
+    _aControl = nullptr;
+    _aSlots = nullptr;
+    _ctSlots = 0;
+    _ctGrowth = 0;
+  };
+
+#if _DREAMY_CPP11
+  // Create an unlinked entry from any arguments
+  template<typename... Args>
+  Node *NewNode(Args &&... args) {
+    Node *pNode = NodeAllocator(_alloc).allocate(1);
+
+    try {
+      new ((void *)&pNode->val) value_type(std::forward<Args>(args)...);
+
+    } catch (...) {
+      NodeAllocator(_alloc).deallocate(pNode, 1);
+      throw;
+    }
+
+    return pNode;
   };
+
+#else
+  // Create an unlinked entry from a pair
+  Node *NewNode(const value_type &pair) {
+    Node *pNode = NodeAllocator(_alloc).allocate(1);
+
+    try {
+      new ((void *)&pNode->val) value_type(pair);
+
+    } catch (...) {
+      NodeAllocator(_alloc).deallocate(pNode, 1);
+      throw;
+    }
+
+    return pNode;
+  };
+#endif
+
+  // Destroy an unlinked entry
+  void DeleteNode(Node *pNode) {
+    pNode->val.~value_type();
+    NodeAllocator(_alloc).deallocate(pNode, 1);
+  };
+
+  // Remove an entry from the list
+  void Unlink(Node *pNode) {
+    pNode->pPrev->pNext = pNode->pNext;
+    pNode->pNext->pPrev = pNode->pPrev;
+    --_ctEntries;
+  };
+
+  // Put a new entry in the hash table and at the end of the list
+  iterator AddNode(Node *pNode, size_t iHash) {
+    pNode->iHash = iHash;
+
+    try {
+      size_t iSlot = (_ctSlots != 0) ? FindFreeSlot(iHash) : NULL_POS;
+
+      // Only empty slots count towards the load since deleted ones are already in use
+      if (iSlot == NULL_POS || (_ctGrowth == 0 && _aControl[iSlot] == MAP_EMPTY)) {
+        Grow();
+        iSlot = FindFreeSlot(iHash);
+      }
+
+      TakeSlot(iSlot, pNode);
+
+    } catch (...) {
+      DeleteNode(pNode);
+      throw;
+    }
+
+    pNode->pPrev = _lnkEntries.pPrev;
+    pNode->pNext = &_lnkEntries;
+    _lnkEntries.pPrev->pNext = pNode;
+    _lnkEntries.pPrev = pNode;
+    ++_ctEntries;
+
+    return iterator(pNode);
+  };
+
+  // Make room for at least one more entry
+  void Grow(void) {
+    // Clear deleted slots if the table isn't loaded enough to grow
+    if (_ctSlots != 0 && _ctEntries < MaxLoad(_ctSlots) / 2) {
+      Rehash(_ctSlots);
+    } else {
+      Rehash(_ctSlots != 0 ? _ctSlots * 2 : (size_t)MAP_GROUP);
+    }
+  };
+
+  // Rebuild the hash table with a specific amount of slots
+  void Rehash(size_t ctSlots) {
+    u8 *aControl = ControlAllocator(_alloc).allocate(ctSlots);
+    Node **aSlots;
+
+    try {
+      aSlots = SlotAllocator(_alloc).allocate(ctSlots);
+
+    } catch (...) {
+      ControlAllocator(_alloc).deallocate(aControl, ctSlots);
+      throw;
+    }
+
+    FreeTable();
+
+    _aControl = aControl;
+    _aSlots = aSlots;
+    _ctSlots = ctSlots;
+
+    memset(_aControl, MAP_EMPTY, _ctSlots);
+
+    // Put all entries back without comparing keys
+    for (Link *pLink = _lnkEntries.pNext; pLink != &_lnkEntries; pLink = pLink->pNext) {
+      Node *pNode = static_cast<Node *>(pLink);
+      const size_t iSlot = FindFreeSlot(pNode->iHash);
+
+      _aControl[iSlot] = u8(pNode->iHash & 0x7F);
+      _aSlots[iSlot] = pNode;
+    }
+
+    _ctGrowth = MaxLoad(_ctSlots) - _ctEntries;
+  };
+
+  // Occupy a free slot with an entry
+  void TakeSlot(size_t iSlot, Node *pNode) {
+    if (_aControl[iSlot] == MAP_EMPTY) --_ctGrowth;
+
+    _aControl[iSlot] = u8(pNode->iHash & 0x7F);
+    _aSlots[iSlot] = pNode;
+  };
+
+  // Free an occupied slot
+  void FreeSlot(size_t iSlot) {
+    // Lookups stop at groups with empty slots, so the slot can become empty again only if
+    // there's another empty slot in its group that would've stopped them anyway
+    const u8 *pGroup = _aControl + (iSlot & ~size_t(MAP_GROUP - 1));
+
+    if (MapGroupMatch(pGroup, MAP_EMPTY) != 0) {
+      _aControl[iSlot] = MAP_EMPTY;
+      ++_ctGrowth;
+
+    } else {
+      _aControl[iSlot] = MAP_DELETED;
+    }
+  };
+
+  // Find slot with a specific key
+  size_t FindSlot(const Key &key, size_t iHash) const {
+    if (_ctEntries == 0) return NULL_POS;
+
+    const size_t iGroupMask = _ctSlots / MAP_GROUP - 1;
+    const u8 iTag = u8(iHash & 0x7F);
+    size_t iGroup = (iHash >> 7) & iGroupMask;
+
+    // Triangular probing visits every group
+    for (size_t iProbe = 1; ; ++iProbe) {
+      const size_t iFirst = iGroup * MAP_GROUP;
+      u32 iMatch = MapGroupMatch(_aControl + iFirst, iTag);
+
+      while (iMatch != 0) {
+        const size_t iSlot = iFirst + LowestSetBit(iMatch);
+        const Node *pNode = _aSlots[iSlot];
+
+        if (pNode->iHash == iHash && _equal(pNode->val.first, key)) return iSlot;
+        iMatch &= iMatch - 1;
+      }
+
+      // Key would've been put in an empty slot in this group
+      if (MapGroupMatch(_aControl + iFirst, MAP_EMPTY) != 0) return NULL_POS;
+
+      iGroup = (iGroup + iProbe) & iGroupMask;
+    }
+  };
+
+  // Find slot of a specific entry
+  size_t FindNodeSlot(const Node *pNode) const {
+    const size_t iGroupMask = _ctSlots / MAP_GROUP - 1;
+    const u8 iTag = u8(pNode->iHash & 0x7F);
+    size_t iGroup = (pNode->iHash >> 7) & iGroupMask;
+
+    for (size_t iProbe = 1; ; ++iProbe) {
+      const size_t iFirst = iGroup * MAP_GROUP;
+      u32 iMatch = MapGroupMatch(_aControl + iFirst, iTag);
+
+      while (iMatch != 0) {
+        const size_t iSlot = iFirst + LowestSetBit(iMatch);
+        if (_aSlots[iSlot] == pNode) return iSlot;
+
+        iMatch &= iMatch - 1;
+      }
+
+      D_ASSERT(MapGroupMatch(_aControl + iFirst, MAP_EMPTY) == 0);
+      iGroup = (iGroup + iProbe) & iGroupMask;
+    }
+  };
+
+  // Find first free slot for some hash
+  size_t FindFreeSlot(size_t iHash) const {
+    const size_t iGroupMask = _ctSlots / MAP_GROUP - 1;
+    size_t iGroup = (iHash >> 7) & iGroupMask;
+
+    for (size_t iProbe = 1; ; ++iProbe) {
+      const size_t iFirst = iGroup * MAP_GROUP;
+      const u32 iFree = MapGroupFree(_aControl + iFirst);
+
+      if (iFree != 0) return iFirst + LowestSetBit(iFree);
+
+      iGroup = (iGroup + iProbe) & iGroupMask;
+    }
+  };
+};
+
+// Check if maps have the same pairs regardless of their order
+template<typename Key, typename Type, typename Hash, typename KeyEqual, typename Allocator>
+bool operator==(const unordered_map<Key, Type, Hash, KeyEqual, Allocator> &map1,
+  const unordered_map<Key, Type, Hash, KeyEqual, Allocator> &map2)
+{
+  if (map1.size() != map2.size()) return false;
+
+  typename unordered_map<Key, Type, Hash, KeyEqual, Allocator>::const_iterator it, itOther;
+
+  for (it = map1.begin(); it != map1.end(); ++it) {
+    itOther = map2.find(it->first);
+    if (itOther == map2.end() || !(itOther->second == it->second)) return false;
+  }
+
+  return true;
+};
+
+template<typename Key, typename Type, typename Hash, typename KeyEqual, typename Allocator>
+bool operator!=(const unordered_map<Key, Type, Hash, KeyEqual, Allocator> &map1,
+  const unordered_map<Key, Type, Hash, KeyEqual, Allocator> &map2)
+{
+  return !(map1 == map2);
 };
 
 }; // namespace dreamy
@@ -2,6 +2,7 @@
 //! Licensed under the MIT license (see LICENSE file).
 
 #include "Variant.hpp"
+#include "../IO/StringBuilderDevice.hpp"
 
 namespace dreamy {
 
@@ -44,6 +45,207 @@ VARIANT_COMPARE_METHOD(StrArray);
 VARIANT_COMPARE_METHOD(Vec2Array);
 VARIANT_COMPARE_METHOD(Vec3Array);
 
+// Copy a value of some type on the heap
+template<typename Type> static void *CopyVariantPayload(const void *pPayload) {
+  return new Type(*static_cast<const Type *>(pPayload));
+};
+
+// Delete a value of some type on the heap
+template<typename Type> static void DeleteVariantPayload(void *pPayload) {
+  delete static_cast<Type *>(pPayload);
+};
+
+// Methods for values on the heap per main type (none for types that are stored inside the variant)
+struct VariantPayloadFuncs {
+  void *(*pCopy)(const void *);
+  void (*pDelete)(void *);
+};
+
+#define VARIANT_NO_PAYLOAD { nullptr, nullptr }
+#define VARIANT_PAYLOAD(Type) { &CopyVariantPayload<Type>, &DeleteVariantPayload<Type> }
+
+static const VariantPayloadFuncs _aVariantPayloads[CAbstractValue::VAL_LAST] = {
+  VARIANT_NO_PAYLOAD, // VAL_INVALID
+  VARIANT_NO_PAYLOAD, // VAL_BOOL
+  VARIANT_NO_PAYLOAD, // VAL_FLOAT
+  VARIANT_NO_PAYLOAD, // VAL_INT
+  VARIANT_PAYLOAD(CString),
+  VARIANT_PAYLOAD(CValObject),
+  VARIANT_NO_PAYLOAD, // VAL_PTR
+  VARIANT_NO_PAYLOAD, // VAL_VEC2
+  VARIANT_NO_PAYLOAD, // VAL_VEC3
+  VARIANT_PAYLOAD(mat2d),
+  VARIANT_PAYLOAD(mat3d),
+  VARIANT_PAYLOAD(CValArray),
+  VARIANT_PAYLOAD(Bits_t),
+  VARIANT_PAYLOAD(Bytes_t),
+  VARIANT_PAYLOAD(Ints_t),
+  VARIANT_PAYLOAD(Numbers_t),
+  VARIANT_PAYLOAD(Strings_t),
+  VARIANT_PAYLOAD(Vec2Array_t),
+  VARIANT_PAYLOAD(Vec3Array_t),
+};
+
+#undef VARIANT_NO_PAYLOAD
+#undef VARIANT_PAYLOAD
+
+void *CAbstractValue::CopyPayload(const CAbstractValue &valOther) {
+  if ((u32)valOther._type >= VAL_LAST) {
+    return new CustomValue(*static_cast<const CustomValue *>(valOther._data.pPayload));
+  }
+
+  return _aVariantPayloads[valOther._type].pCopy(valOther._data.pPayload);
+};
+
+void CAbstractValue::DeletePayload(void) {
+  if ((u32)_type >= VAL_LAST) {
+    delete static_cast<CustomValue *>(_data.pPayload);
+    return;
+  }
+
+  _aVariantPayloads[_type].pDelete(_data.pPayload);
+};
+
+// Get value of some type from the heap
+#define VARIANT_PAYLOAD_VALUE(Type) (*static_cast<const Type *>(_data.pPayload))
+
+CAny CAbstractValue::GetValue(void) const {
+  switch (_type) {
+    case VAL_INVALID: return CAny(s64(0));
+    case VAL_BOOL:    return CAny(_data.b);
+    case VAL_FLOAT:   return CAny(_data.f);
+    case VAL_INT:     return CAny(_data.i);
+    case VAL_STRING:  return CAny(VARIANT_PAYLOAD_VALUE(CString));
+    case VAL_OBJ:     return CAny(VARIANT_PAYLOAD_VALUE(CValObject));
+    case VAL_PTR:     return CAny(_data.pPtr);
+    case VAL_VEC2:    return CAny(*reinterpret_cast<const vec2d *>(_data.aVector));
+    case VAL_VEC3:    return CAny(*reinterpret_cast<const vec3d *>(_data.aVector));
+    case VAL_MAT2:    return CAny(VARIANT_PAYLOAD_VALUE(mat2d));
+    case VAL_MAT3:    return CAny(VARIANT_PAYLOAD_VALUE(mat3d));
+    case VAL_ARR:       return CAny(VARIANT_PAYLOAD_VALUE(CValArray));
+    case VAL_ARR_BOOL:  return CAny(VARIANT_PAYLOAD_VALUE(Bits_t));
+    case VAL_ARR_BYTE:  return CAny(VARIANT_PAYLOAD_VALUE(Bytes_t));
+    case VAL_ARR_INT:   return CAny(VARIANT_PAYLOAD_VALUE(Ints_t));
+    case VAL_ARR_FLOAT: return CAny(VARIANT_PAYLOAD_VALUE(Numbers_t));
+    case VAL_ARR_STR:   return CAny(VARIANT_PAYLOAD_VALUE(Strings_t));
+    case VAL_ARR_VEC2:  return CAny(VARIANT_PAYLOAD_VALUE(Vec2Array_t));
+    case VAL_ARR_VEC3:  return CAny(VARIANT_PAYLOAD_VALUE(Vec3Array_t));
+    default: break;
+  }
+
+  // Custom type
+  return VARIANT_PAYLOAD_VALUE(CustomValue).val;
+};
+
+#undef VARIANT_PAYLOAD_VALUE
+
+// Replace the value with a copy of some type on the heap
+#define VARIANT_SET_PAYLOAD(Type) SetPayload(iType, new Type(AnyCast<Type>(valSet)))
+
+void CAbstractValue::Set(s32 iType, const CAny &valSet, CVariantPrintFunc pPrintSet) {
+  switch (iType) {
+    case VAL_STRING:    VARIANT_SET_PAYLOAD(CString); return;
+    case VAL_OBJ:       VARIANT_SET_PAYLOAD(CValObject); return;
+    case VAL_MAT2:      VARIANT_SET_PAYLOAD(mat2d); return;
+    case VAL_MAT3:      VARIANT_SET_PAYLOAD(mat3d); return;
+    case VAL_ARR:       VARIANT_SET_PAYLOAD(CValArray); return;
+    case VAL_ARR_BOOL:  VARIANT_SET_PAYLOAD(Bits_t); return;
+    case VAL_ARR_BYTE:  VARIANT_SET_PAYLOAD(Bytes_t); return;
+    case VAL_ARR_INT:   VARIANT_SET_PAYLOAD(Ints_t); return;
+    case VAL_ARR_FLOAT: VARIANT_SET_PAYLOAD(Numbers_t); return;
+    case VAL_ARR_STR:   VARIANT_SET_PAYLOAD(Strings_t); return;
+    case VAL_ARR_VEC2:  VARIANT_SET_PAYLOAD(Vec2Array_t); return;
+    case VAL_ARR_VEC3:  VARIANT_SET_PAYLOAD(Vec3Array_t); return;
+  }
+
+  // Custom type
+  if ((u32)iType >= VAL_LAST) {
+    SetPayload(iType, new CustomValue(valSet, pPrintSet));
+    return;
+  }
+
+  // Types that are stored inside the value (copied before the current value is cleared)
+  CAbstractValue valNew;
+  valNew._type = (EType)iType;
+
+  switch (iType) {
+    case VAL_BOOL:  valNew._data.b = AnyCast<bool>(valSet); break;
+    case VAL_FLOAT: valNew._data.f = AnyCast<f64>(valSet); break;
+    case VAL_INT:   valNew._data.i = AnyCast<s64>(valSet); break;
+    case VAL_PTR:   valNew._data.pPtr = AnyCast<CVariant *>(valSet); break;
+    case VAL_VEC2:  new (valNew._data.aVector) vec2d(AnyCast<vec2d>(valSet)); break;
+    case VAL_VEC3:  new (valNew._data.aVector) vec3d(AnyCast<vec3d>(valSet)); break;
+  }
+
+  Swap(valNew);
+};
+
+#undef VARIANT_SET_PAYLOAD
+
+// Variant printing methods per main type
+static const CVariantPrintFunc _aVariantPrints[CAbstractValue::VAL_LAST] = {
+  &PrintInvalid,
+  &PrintBool,
+  &PrintFloat,
+  &PrintInt,
+  &PrintString,
+  &PrintObject,
+  &PrintPtr,
+  &PrintVec2,
+  &PrintVec3,
+  &PrintMat2,
+  &PrintMat3,
+  &PrintArray,
+  &PrintBoolArray,
+  &PrintByteArray,
+  &PrintIntArray,
+  &PrintFloatArray,
+  &PrintStrArray,
+  &PrintVec2Array,
+  &PrintVec3Array,
+};
+
+void CVariant::Print(CStringStream &strm, const ValPrintOpts &opts, const c8 *strUndefined) const {
+  const EType eType = GetType();
+
+  if ((u32)eType < VAL_LAST) {
+    _aVariantPrints[eType](*this, strm, opts, strUndefined);
+  } else {
+    static_cast<const CustomValue *>(_data.pPayload)->pPrint(*this, strm, opts, strUndefined);
+  }
+};
+
+void CVariant::Print(CStringBuilder &sb, const ValPrintOpts &opts, const c8 *strUndefined) const {
+  // Append printed text straight to the builder
+  CStringBuilderDevice d(&sb);
+  CStringStream strm(&d, IReadWriteDevice::OM_WRITEONLY);
+
+  Print(strm, opts, strUndefined);
+};
+
+// Variant comparison methods per main type
+static const CVariantCompareFunc _aVariantCompares[CAbstractValue::VAL_LAST] = {
+  &CompareInvalid,
+  &CompareBool,
+  &CompareFloat,
+  &CompareInt,
+  &CompareString,
+  &CompareObject,
+  &ComparePtr,
+  &CompareVec2,
+  &CompareVec3,
+  &CompareMat2,
+  &CompareMat3,
+  &CompareArray,
+  &CompareBoolArray,
+  &CompareByteArray,
+  &CompareIntArray,
+  &CompareFloatArray,
+  &CompareStrArray,
+  &CompareVec2Array,
+  &CompareVec3Array,
+};
+
 // Compare main types directly
 bool CVariant::Compare(const CVariant &valOther) const {
   const EType eThis = GetType();
@@ -54,32 +256,10 @@ bool CVariant::Compare(const CVariant &valOther) const {
 
   // Comparators for custom types should be called directly instead of using CVariant methods
   D_ASSERT(eThis >= VAL_INVALID && eThis < VAL_LAST);
-
-  // Variant comparison methods per type
-  CVariantCompareFunc aMethods[VAL_LAST] = {
-    &CompareInvalid,
-    &CompareBool,
-    &CompareFloat,
-    &CompareInt,
-    &CompareString,
-    &CompareObject,
-    &ComparePtr,
-    &CompareVec2,
-    &CompareVec3,
-    &CompareMat2,
-    &CompareMat3,
-    &CompareArray,
-    &CompareBoolArray,
-    &CompareByteArray,
-    &CompareIntArray,
-    &CompareFloatArray,
-    &CompareStrArray,
-    &CompareVec2Array,
-    &CompareVec3Array,
-  };
+  if ((u32)eThis >= VAL_LAST) return false;
 
   // Compare values of the same type
-  return aMethods[eThis](*this, valOther);
+  return _aVariantCompares[eThis](*this, valOther);
 };
 
 // Comparison
@@ -108,12 +288,21 @@ VARIANT_PRINT_METHOD_CUSTOM(Bool, (val.ToBool() ? "true" : "false"));
 VARIANT_PRINT_METHOD(Float);
 VARIANT_PRINT_METHOD(Int);
 
+// Print string in quotes with special characters escaped
+static void PrintQuotedString(CStringStream &strm, const CString &str) {
+  CString strQuoted("\"");
+  strQuoted.AppendEscaped(str.data(), str.length());
+  strQuoted += '"';
+
+  strm << strQuoted;
+};
+
 // Print string optionally surrounded with quotes
 VARIANT_DEFINE_PRINT(PrintString, val, strm, opts, strUndefined) {
   if (opts.eType == ValPrintOpts::E_INLINE && opts.aiArgs[1]) {
     strm << val.ToString();
   } else {
-    strm << '"' << val.ToString() << '"';
+    PrintQuotedString(strm, val.ToString());
   }
 };
 
@@ -233,12 +422,15 @@ VARIANT_DEFINE_PRINT(PrintObject, val, strm, opts, strUndefined) {
 
     // Print key name
     if (opts.IsInline()) {
-      strm << '"' << it->first.GetString() << '"' << (opts.aiArgs[0] != 0 ? ":" : " : ");
+      PrintQuotedString(strm, it->first.GetString());
+      strm << (opts.aiArgs[0] != 0 ? ":" : " : ");
 
     } else {
       // Indent values in the formatted printout
       optsNext.aiArgs[0] += 1;
-      strm << VARIANT_PRINT_INDENT(optsNext.aiArgs[0]) << '"' << it->first.GetString() << "\" : ";
+      strm << VARIANT_PRINT_INDENT(optsNext.aiArgs[0]);
+      PrintQuotedString(strm, it->first.GetString());
+      strm << " : ";
     }
 
     // "key" : <value>, "key" : <value>...
@@ -9,6 +9,7 @@
 #include "Any.hpp"
 #include "Arrays.hpp"
 #include "HashedString.hpp"
+#include "StringBuilder.hpp"
 
 // Extra types
 #include "../IO/StringStream.hpp"
@@ -17,14 +18,14 @@
 
 // Value containers
 #include <vector>
-#include "UnorderedMap.hpp"
+#include "ObjectShape.hpp"
 
 namespace dreamy {
 
 class CVariant; // Pre-define variant
 
 typedef std::vector<CVariant>                          CValArray;  // Array of values
-typedef dreamy::unordered_map<CHashedString, CVariant> CValObject; // Variable map
+typedef CShapedMap<CVariant>                           CValObject; // Variable map with shared keys
 typedef std::pair<CHashedString, CVariant>             CValPair;   // Key-value pair
 
 // Structure that handles options for specific printout of variant types
@@ -107,24 +108,56 @@ VARIANT_DECLARE_PRINT(PrintStrArray);
 VARIANT_DECLARE_PRINT(PrintVec2Array);
 VARIANT_DECLARE_PRINT(PrintVec3Array);
 
-// Define methods for a full type
+// Define methods for a type that's stored inside the variant
+#define VARIANT_INLINE_METHODS(ValueType, TypeIndex, FuncIdentifier, Member) \
+  /* Type constructor */ \
+  CVariant(ValueType valSet) { From##FuncIdentifier(valSet); } \
+  /* Type assignment (method instead of 'operator=' to avoid confusion between the class and its types) */ \
+  inline void From##FuncIdentifier(ValueType valSet) { Clear(); _data.Member = valSet; _type = (EType)TypeIndex; } \
+  /* Type casting */ \
+  inline       ValueType &To##FuncIdentifier(void)       { CheckType(TypeIndex); return _data.Member; } \
+  inline const ValueType &To##FuncIdentifier(void) const { CheckType(TypeIndex); return _data.Member; }
+
+// Define methods for a vector type that's stored inside the variant
+#define VARIANT_VECTOR_METHODS(ValueType, TypeIndex, FuncIdentifier) \
+  /* Type constructor */ \
+  CVariant(const ValueType &valSet) { From##FuncIdentifier(valSet); } \
+  /* Type assignment (copy first in case it's a part of the current value) */ \
+  inline void From##FuncIdentifier(const ValueType &valSet) { \
+    const ValueType vCopy(valSet); Clear(); new (_data.aVector) ValueType(vCopy); _type = (EType)TypeIndex; } \
+  /* Type casting */ \
+  inline       ValueType &To##FuncIdentifier(void)       { CheckType(TypeIndex); return *reinterpret_cast<ValueType *>(_data.aVector); } \
+  inline const ValueType &To##FuncIdentifier(void) const { CheckType(TypeIndex); return *reinterpret_cast<const ValueType *>(_data.aVector); }
+
+// Define methods for a type that's stored on the heap
 #define VARIANT_TYPE_METHODS(ArgumentType, ValueType, TypeIndex, FuncIdentifier) \
   /* Type constructor */ \
   CVariant(ArgumentType valSet) { From##FuncIdentifier(valSet); } \
   /* Type assignment (method instead of 'operator=' to avoid confusion between the class and its types) */ \
-  inline void From##FuncIdentifier(ArgumentType valSet) { _type = (EType)TypeIndex; _val = valSet; _print = &Print##FuncIdentifier; } \
+  inline void From##FuncIdentifier(ArgumentType valSet) { SetPayload(TypeIndex, new ValueType(valSet)); } \
   /* Type casting */ \
-  inline       ValueType &To##FuncIdentifier(void)       { return AnyCast<ValueType>(_val); } \
-  inline const ValueType &To##FuncIdentifier(void) const { return AnyCast<ValueType>(_val); }
+  inline       ValueType &To##FuncIdentifier(void)       { CheckType(TypeIndex); return *static_cast<ValueType *>(_data.pPayload); } \
+  inline const ValueType &To##FuncIdentifier(void) const { CheckType(TypeIndex); return *static_cast<const ValueType *>(_data.pPayload); }
+
+// Define methods for taking over values of a type that's stored on the heap
+#if _DREAMY_CPP11
+  #define VARIANT_MOVE_METHODS(ValueType, TypeIndex, FuncIdentifier) \
+    /* Type constructor */ \
+    CVariant(ValueType &&valSet) { From##FuncIdentifier(std::move(valSet)); } \
+    /* Type assignment */ \
+    inline void From##FuncIdentifier(ValueType &&valSet) { SetPayload(TypeIndex, new ValueType(std::move(valSet))); }
+#else
+  #define VARIANT_MOVE_METHODS(ValueType, TypeIndex, FuncIdentifier)
+#endif
 
 // Define methods for a pointer type
 #define VARIANT_PTR_METHODS(ValueType, TypeIndex, FuncIdentifier) \
   /* Type constructor */ \
   CVariant(ValueType valSet) { From##FuncIdentifier(valSet); } \
   /* Type assignment (method instead of 'operator=' to avoid confusion between the class and its types) */ \
-  inline void From##FuncIdentifier(ValueType valSet) { _type = (EType)TypeIndex; _val = valSet; _print = &Print##FuncIdentifier; } \
+  inline void From##FuncIdentifier(ValueType valSet) { Clear(); _data.pPtr = valSet; _type = (EType)TypeIndex; } \
   /* Type casting */ \
-  inline ValueType To##FuncIdentifier(void) const { return AnyCast<ValueType>(_val); }
+  inline ValueType To##FuncIdentifier(void) const { CheckType(TypeIndex); return _data.pPtr; }
 
 // Define a global method for converting arrays of some type into an array of variants
 #define VARIANT_CONVERT_ARRAY_METHOD(ArrayType, TypeName) \
@@ -137,6 +170,7 @@ VARIANT_DECLARE_PRINT(PrintVec3Array);
   }
 
 // Class that houses a value of any type
+// Scalars, vectors and pointers are stored inside the value and everything else on the heap
 class CAbstractValue {
 
 public:
@@ -175,21 +209,52 @@ public:
     VAL_LAST,
   };
 
+  // Value of a custom type after the main ones
+  struct CustomValue {
+    CAny val; // Actual value
+    CVariantPrintFunc pPrint; // Printing method associated with the type
+
+    CustomValue(const CAny &valSet, CVariantPrintFunc pPrintSet) : val(valSet), pPrint(pPrintSet) {};
+  };
+
 protected:
+  // Value storage for each type
+  union Storage {
+    bool b; // VAL_BOOL
+    f64 f; // VAL_FLOAT
+    s64 i; // VAL_INT
+    CVariant *pPtr; // VAL_PTR
+    c8 aVector[sizeof(vec3d)]; // VAL_VEC2 and VAL_VEC3
+    void *pPayload; // Value on the heap for other types
+  };
+
+  Storage _data; // Actual value
   EType _type; // Value type index
-  CAny _val; // Actual value
-  CVariantPrintFunc _print; // Printing method associated with the type
 
 public:
   // Default constructor
-  CAbstractValue() : _type(VAL_INVALID), _val(s64(0)), _print(&PrintInvalid)
+  CAbstractValue() : _type(VAL_INVALID)
   {
+    _data.i = 0;
   };
 
   // Copy constructor
-  CAbstractValue(const CAbstractValue &valOther) :
-    _type(valOther._type), _val(valOther._val), _print(valOther._print)
+  CAbstractValue(const CAbstractValue &valOther) : _data(valOther._data), _type(valOther._type)
   {
+    if (HasPayload()) _data.pPayload = CopyPayload(valOther);
+  };
+
+#if _DREAMY_CPP11
+  // Move constructor (leaves the other value invalid)
+  CAbstractValue(CAbstractValue &&valOther) DREAMY_NOEXCEPT : _data(valOther._data), _type(valOther._type)
+  {
+    valOther._type = VAL_INVALID;
+  };
+#endif
+
+  // Destructor
+  ~CAbstractValue() {
+    if (HasPayload()) DeletePayload();
   };
 
   // Get value type
@@ -197,27 +262,72 @@ public:
     return _type;
   };
 
-  // Get actual value
-  inline const CAny &GetValue(void) const {
-    return _val;
-  };
+  // Get a copy of the actual value
+  CAny GetValue(void) const;
 
   // Custom assignment
-  inline void Set(s32 iType, const CAny &valSet, CVariantPrintFunc pPrintSet) {
-    _type = (EType)iType;
-    _val = valSet;
-    _print = pPrintSet;
+  // Printing method is only used for custom types after VAL_LAST
+  void Set(s32 iType, const CAny &valSet, CVariantPrintFunc pPrintSet);
+
+  // Reset to an invalid value
+  inline void Clear(void) {
+    if (HasPayload()) DeletePayload();
+
+    _type = VAL_INVALID;
+    _data.i = 0;
   };
 
   // Assignment
   CAbstractValue &operator=(const CAbstractValue &valOther) {
+    if (&valOther != this) CAbstractValue(valOther).Swap(*this);
+    return *this;
+  };
+
+#if _DREAMY_CPP11
+  // Move assignment (leaves the other value invalid)
+  CAbstractValue &operator=(CAbstractValue &&valOther) DREAMY_NOEXCEPT {
     if (&valOther == this) return *this;
 
-    _type = valOther._type;
-    _val = valOther._val;
-    _print = valOther._print;
+    Clear();
+    Swap(valOther);
     return *this;
   };
+#endif
+
+  // Swap values
+  inline void Swap(CAbstractValue &valOther) DREAMY_NOEXCEPT {
+    std::swap(_data, valOther._data);
+    std::swap(_type, valOther._type);
+  };
+
+protected:
+  // Check if the value is stored on the heap
+  inline bool HasPayload(void) const {
+    // Types that are stored inside the value
+    const u32 ulInline = (1UL << VAL_INVALID) | (1UL << VAL_BOOL) | (1UL << VAL_FLOAT) | (1UL << VAL_INT)
+                       | (1UL << VAL_PTR) | (1UL << VAL_VEC2) | (1UL << VAL_VEC3);
+
+    return (u32)_type >= VAL_LAST || !((ulInline >> _type) & 1);
+  };
+
+  // Throw an exception if the value is of a different type
+  inline void CheckType(s32 iType) const {
+    if (_type != iType) throw CBadAnyCastException();
+  };
+
+  // Replace the value with a new one on the heap
+  inline void SetPayload(s32 iType, void *pPayload) {
+    Clear();
+
+    _data.pPayload = pPayload;
+    _type = (EType)iType;
+  };
+
+  // Make a copy of another value on the heap
+  static void *CopyPayload(const CAbstractValue &valOther);
+
+  // Delete value on the heap
+  void DeletePayload(void);
 };
 
 // Class that houses a value of any valid type
@@ -230,9 +340,9 @@ public:
   };
 
   // Type-specific methods
-  VARIANT_TYPE_METHODS(f64,  f64,  VAL_FLOAT, Float);
-  VARIANT_TYPE_METHODS(bool, bool, VAL_BOOL,  Bool);
-  VARIANT_TYPE_METHODS(s64,  s64,  VAL_INT,   Int);
+  VARIANT_INLINE_METHODS(f64,  VAL_FLOAT, Float, f);
+  VARIANT_INLINE_METHODS(bool, VAL_BOOL,  Bool,  b);
+  VARIANT_INLINE_METHODS(s64,  VAL_INT,   Int,   i);
 
   // Different integer types
   CVariant(u8  i) { FromInt(i); };
@@ -246,13 +356,15 @@ public:
 
   // Strings
   VARIANT_TYPE_METHODS(const CString &, CString, VAL_STRING, String);
+  VARIANT_MOVE_METHODS(CString, VAL_STRING, String);
   CVariant(const c8 *str) { FromString(str); };
 
   VARIANT_TYPE_METHODS(const CValObject &, CValObject, VAL_OBJ, Object);
+  VARIANT_MOVE_METHODS(CValObject, VAL_OBJ, Object);
   VARIANT_PTR_METHODS(CVariant *, VAL_PTR, Ptr);
 
-  VARIANT_TYPE_METHODS(const vec2d &, vec2d, VAL_VEC2, Vec2);
-  VARIANT_TYPE_METHODS(const vec3d &, vec3d, VAL_VEC3, Vec3);
+  VARIANT_VECTOR_METHODS(vec2d, VAL_VEC2, Vec2);
+  VARIANT_VECTOR_METHODS(vec3d, VAL_VEC3, Vec3);
   VARIANT_TYPE_METHODS(const mat2d &, mat2d, VAL_MAT2, Mat2);
   VARIANT_TYPE_METHODS(const mat3d &, mat3d, VAL_MAT3, Mat3);
 
@@ -265,6 +377,15 @@ public:
   VARIANT_TYPE_METHODS(const Vec2Array_t &, Vec2Array_t, VAL_ARR_VEC2,  Vec2Array);
   VARIANT_TYPE_METHODS(const Vec3Array_t &, Vec3Array_t, VAL_ARR_VEC3,  Vec3Array);
 
+  VARIANT_MOVE_METHODS(CValArray,   VAL_ARR,       Array);
+  VARIANT_MOVE_METHODS(Bits_t,      VAL_ARR_BOOL,  BoolArray);
+  VARIANT_MOVE_METHODS(Bytes_t,     VAL_ARR_BYTE,  ByteArray);
+  VARIANT_MOVE_METHODS(Ints_t,      VAL_ARR_INT,   IntArray);
+  VARIANT_MOVE_METHODS(Numbers_t,   VAL_ARR_FLOAT, FloatArray);
+  VARIANT_MOVE_METHODS(Strings_t,   VAL_ARR_STR,   StrArray);
+  VARIANT_MOVE_METHODS(Vec2Array_t, VAL_ARR_VEC2,  Vec2Array);
+  VARIANT_MOVE_METHODS(Vec3Array_t, VAL_ARR_VEC3,  Vec3Array);
+
   // Check for a distinctive number type (float, integer or invalid)
   inline EType GetNumberType(void) const {
     const EType eType = GetType();
@@ -279,9 +400,10 @@ public:
   };
 
   // Print variant value ('null' is used in place of undefined values in JSON)
-  inline void Print(CStringStream &strm, const ValPrintOpts &opts, const c8 *strUndefined = "null") const {
-    _print(*this, strm, opts, strUndefined);
-  };
+  void Print(CStringStream &strm, const ValPrintOpts &opts, const c8 *strUndefined = "null") const;
+
+  // Print variant value at the end of a string builder (for very large printouts)
+  void Print(CStringBuilder &sb, const ValPrintOpts &opts, const c8 *strUndefined = "null") const;
 
   // Compare vanilla types directly
   bool Compare(const CVariant &valOther) const;
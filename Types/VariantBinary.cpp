@@ -0,0 +1,641 @@
+//! This file is a part of Dreamy Utilities.
+//! Licensed under the MIT license (see LICENSE file).
+
+#include "VariantBinary.hpp"
+
+#include "Exception.hpp"
+#include "../Data/Endian.hpp"
+
+#include <cstring>
+
+namespace dreamy {
+
+namespace varbin {
+
+// Constructor with a stream to write into
+CWriter::CWriter(CDataStream &strm) : _strm(strm)
+{
+  _bSwap = (strm.GetByteOrder() != CDataStream::BO_PLATFORM);
+};
+
+// Write one value frame
+void CWriter::Write(const CVariant &val) {
+  // Each frame can be read on its own
+  _aPayload.clear();
+  _mapShapes.clear();
+
+  PutValue(val);
+
+  // Frame header
+  u8 aHeader[11];
+  size_t iHeader = 0;
+  aHeader[iHeader++] = BIN_VERSION;
+
+  u64 iSize = _aPayload.size();
+
+  while (iSize >= 0x80) {
+    aHeader[iHeader++] = (u8)(iSize | 0x80);
+    iSize >>= 7;
+  }
+
+  aHeader[iHeader++] = (u8)iSize;
+
+  if (_strm.Write(aHeader, iHeader) != iHeader) {
+    _strm.SetStatus(CDataStream::STATUS_WRITEFAILED);
+    return;
+  }
+
+  if (!_aPayload.empty() && _strm.Write(&_aPayload[0], _aPayload.size()) != _aPayload.size()) {
+    _strm.SetStatus(CDataStream::STATUS_WRITEFAILED);
+  }
+};
+
+void CWriter::PutValue(const CVariant &val) {
+  switch (val.GetType()) {
+    case CVariant::VAL_INVALID: PutByte(BIN_NULL); return;
+    case CVariant::VAL_BOOL: PutByte(val.ToBool() ? BIN_TRUE : BIN_FALSE); return;
+
+    case CVariant::VAL_INT: {
+      const s64 i = val.ToInt();
+
+      if (i >= 0 && i < 0x80) {
+        PutByte((u8)(BIN_FIXINT | i));
+        return;
+      }
+
+      // Zigzag encoding for small negative numbers
+      PutByte(BIN_INT);
+      PutVarint(((u64)i << 1) ^ (u64)(i >> 63));
+    } return;
+
+    case CVariant::VAL_FLOAT:
+      PutByte(BIN_FLOAT);
+      PutFloat(val.ToFloat());
+      return;
+
+    case CVariant::VAL_STRING:
+      PutByte(BIN_STRING);
+      PutString(val.ToString());
+      return;
+
+    case CVariant::VAL_OBJ: {
+      const CValObject &obj = val.ToObject();
+      PutByte(BIN_OBJECT);
+
+      // Empty objects are new shapes without keys that aren't remembered
+      if (obj.empty()) {
+        PutVarint(0);
+        PutVarint(0);
+        return;
+      }
+
+      const CObjectShape *pShape = obj.GetShape();
+      std::pair<unordered_map<const CObjectShape *, u32>::iterator, bool> itShape;
+      itShape = _mapShapes.insert(std::make_pair(pShape, (u32)_mapShapes.size()));
+
+      if (itShape.second) {
+        // Define a new shape
+        const size_t ctKeys = pShape->Size();
+        PutVarint(0);
+        PutVarint(ctKeys);
+
+        for (size_t i = 0; i < ctKeys; ++i) {
+          PutString(pShape->GetKey(i).GetString());
+        }
+
+      } else {
+        PutVarint(itShape.first->second + 1);
+      }
+
+      CValObject::const_iterator it;
+
+      for (it = obj.begin(); it != obj.end(); ++it) {
+        PutValue(it->second);
+      }
+    } return;
+
+    case CVariant::VAL_VEC2:
+      PutByte(BIN_VEC2);
+      PutBlock64(val.ToVec2().Array(), 2);
+      return;
+
+    case CVariant::VAL_VEC3:
+      PutByte(BIN_VEC3);
+      PutBlock64(val.ToVec3().Array(), 3);
+      return;
+
+    case CVariant::VAL_MAT2: {
+      const mat2d &m = val.ToMat2();
+      PutByte(BIN_MAT2);
+
+      for (s32 iRow = 0; iRow < 2; ++iRow) {
+        PutBlock64(m[iRow].Array(), 2);
+      }
+    } return;
+
+    case CVariant::VAL_MAT3: {
+      const mat3d &m = val.ToMat3();
+      PutByte(BIN_MAT3);
+
+      for (s32 iRow = 0; iRow < 3; ++iRow) {
+        PutBlock64(m[iRow].Array(), 3);
+      }
+    } return;
+
+    case CVariant::VAL_ARR: {
+      const CValArray &aValues = val.ToArray();
+      const size_t ct = aValues.size();
+
+      PutByte(BIN_ARR);
+      PutVarint(ct);
+
+      for (size_t i = 0; i < ct; ++i) {
+        PutValue(aValues[i]);
+      }
+    } return;
+
+    case CVariant::VAL_ARR_BOOL: {
+      const Bits_t &aBits = val.ToBoolArray();
+      const size_t ct = aBits.size();
+
+      PutByte(BIN_ARR_BOOL);
+      PutVarint(ct);
+
+      // Eight bits per byte starting from the lowest one
+      for (size_t i = 0; i < ct; i += 8) {
+        u8 ub = 0;
+
+        for (size_t iBit = 0; iBit < 8 && i + iBit < ct; ++iBit) {
+          if (aBits[i + iBit]) ub |= (u8)(1 << iBit);
+        }
+
+        PutByte(ub);
+      }
+    } return;
+
+    case CVariant::VAL_ARR_BYTE: {
+      const Bytes_t &aBytes = val.ToByteArray();
+
+      PutByte(BIN_ARR_BYTE);
+      PutVarint(aBytes.size());
+      _aPayload.insert(_aPayload.end(), aBytes.begin(), aBytes.end());
+    } return;
+
+    case CVariant::VAL_ARR_INT: {
+      const Ints_t &aInts = val.ToIntArray();
+
+      PutByte(BIN_ARR_INT);
+      PutVarint(aInts.size());
+
+      // Integers have the same size as floats
+      if (!aInts.empty()) PutBlock64(&aInts[0], aInts.size());
+    } return;
+
+    case CVariant::VAL_ARR_FLOAT: {
+      const Numbers_t &aNumbers = val.ToFloatArray();
+
+      PutByte(BIN_ARR_FLOAT);
+      PutVarint(aNumbers.size());
+
+      if (!aNumbers.empty()) PutBlock64(&aNumbers[0], aNumbers.size());
+    } return;
+
+    case CVariant::VAL_ARR_STR: {
+      const Strings_t &aStrings = val.ToStrArray();
+      const size_t ct = aStrings.size();
+
+      PutByte(BIN_ARR_STR);
+      PutVarint(ct);
+
+      for (size_t i = 0; i < ct; ++i) {
+        PutString(aStrings[i]);
+      }
+    } return;
+
+    case CVariant::VAL_ARR_VEC2: {
+      const Vec2Array_t &aVectors = val.ToVec2Array();
+
+      PutByte(BIN_ARR_VEC2);
+      PutVarint(aVectors.size());
+
+      if (!aVectors.empty()) PutBlock64(aVectors[0].Array(), aVectors.size() * 2);
+    } return;
+
+    case CVariant::VAL_ARR_VEC3: {
+      const Vec3Array_t &aVectors = val.ToVec3Array();
+
+      PutByte(BIN_ARR_VEC3);
+      PutVarint(aVectors.size());
+
+      if (!aVectors.empty()) PutBlock64(aVectors[0].Array(), aVectors.size() * 3);
+    } return;
+
+    // Pointers and custom types
+    default: break;
+  }
+
+  throw CMessageException("Variant of this type can't be written in binary");
+};
+
+void CWriter::PutVarint(u64 i) {
+  while (i >= 0x80) {
+    PutByte((u8)(i | 0x80));
+    i >>= 7;
+  }
+
+  PutByte((u8)i);
+};
+
+void CWriter::PutFloat(f64 f) {
+  PutBlock64(&f, 1);
+};
+
+void CWriter::PutString(const CString &str) {
+  const size_t iLength = str.length();
+  PutVarint(iLength);
+
+  _aPayload.insert(_aPayload.end(), (const u8 *)str.c_str(), (const u8 *)str.c_str() + iLength);
+};
+
+// Put a block of raw 64-bit values of any type
+void CWriter::PutBlock64(const void *pData, size_t ct) {
+  const size_t iStart = _aPayload.size();
+  const size_t iSize = ct * sizeof(u64);
+
+  _aPayload.resize(iStart + iSize);
+
+  if (!_bSwap) {
+    memcpy(&_aPayload[iStart], pData, iSize);
+    return;
+  }
+
+  // Swap bytes in an aligned copy
+  std::vector<u64> aSwapped(ct);
+  memcpy(&aSwapped[0], pData, iSize);
+  ByteSwapArray64(&aSwapped[0], &aSwapped[0], ct);
+  memcpy(&_aPayload[iStart], &aSwapped[0], iSize);
+};
+
+// Constructor with a stream to read from
+CReader::CReader(CDataStream &strm) : _strm(strm), _pCur(nullptr), _pEnd(nullptr), _iDepth(0)
+{
+  _bSwap = (strm.GetByteOrder() != CDataStream::BO_PLATFORM);
+};
+
+// Destructor
+CReader::~CReader() {
+  ReleaseShapes();
+};
+
+// Read one value frame (invalid value if the stream ended)
+void CReader::Read(CVariant &val) {
+  val.Clear();
+  ReleaseShapes();
+  _iDepth = 0;
+
+  // Nothing to read from
+  IReadWriteDevice *pDevice = _strm.Device();
+  if (pDevice == nullptr) Corrupted();
+
+  u8 ubVersion = 0;
+  if (_strm.Read(&ubVersion, 1) != 1) return;
+
+  if (ubVersion != BIN_VERSION) {
+    CMessageException::Throw("Unsupported binary variant version %u", (u32)ubVersion);
+  }
+
+  // Payload size
+  u64 iSize = 0;
+
+  for (u32 iShift = 0;; iShift += 7) {
+    u8 ub;
+    if (_strm.Read(&ub, 1) != 1) Corrupted();
+
+    if (iShift > 63) Corrupted();
+    iSize |= (u64)(ub & 0x7F) << iShift;
+
+    if (!(ub & 0x80)) break;
+  }
+
+  if (iSize == 0 || iSize != (size_t)iSize) Corrupted();
+
+  // Payload can't be larger than the rest of the stream
+  const size_t iPos = pDevice->Pos();
+  const size_t iDeviceSize = pDevice->Size();
+
+  if (iPos > iDeviceSize || iSize > iDeviceSize - iPos) Corrupted();
+
+  // Decode the whole payload from memory
+  _aPayload.resize((size_t)iSize);
+  if (_strm.Read(&_aPayload[0], (size_t)iSize) != iSize) Corrupted();
+
+  _pCur = &_aPayload[0];
+  _pEnd = _pCur + _aPayload.size();
+
+  GetValue(val);
+
+  // Extra bytes after the value
+  if (_pCur != _pEnd) Corrupted();
+};
+
+void CReader::GetValue(CVariant &val) {
+  const u8 ubTag = GetByte();
+
+  if (ubTag & BIN_FIXINT) {
+    val.FromInt(ubTag & 0x7F);
+    return;
+  }
+
+  switch (ubTag) {
+    case BIN_NULL: val.Clear(); return;
+    case BIN_FALSE: val.FromBool(false); return;
+    case BIN_TRUE: val.FromBool(true); return;
+
+    case BIN_INT: {
+      const u64 i = GetVarint();
+      val.FromInt((s64)(i >> 1) ^ -(s64)(i & 1));
+    } return;
+
+    case BIN_FLOAT: val.FromFloat(GetFloat()); return;
+
+    case BIN_STRING: {
+      val.FromString(CString());
+      GetString(val.ToString());
+    } return;
+
+    case BIN_OBJECT: GetObject(val); return;
+
+    case BIN_VEC2: {
+      vec2d v;
+      GetBlock64(&v[0], 2);
+      val.FromVec2(v);
+    } return;
+
+    case BIN_VEC3: {
+      vec3d v;
+      GetBlock64(&v[0], 3);
+      val.FromVec3(v);
+    } return;
+
+    case BIN_MAT2: {
+      mat2d m;
+
+      for (s32 iRow = 0; iRow < 2; ++iRow) {
+        GetBlock64(&m[iRow][0], 2);
+      }
+
+      val.FromMat2(m);
+    } return;
+
+    case BIN_MAT3: {
+      mat3d m;
+
+      for (s32 iRow = 0; iRow < 3; ++iRow) {
+        GetBlock64(&m[iRow][0], 3);
+      }
+
+      val.FromMat3(m);
+    } return;
+
+    case BIN_ARR: {
+      const size_t ct = GetCount(1);
+      CValArray aValues(ct);
+      Nest();
+
+      for (size_t i = 0; i < ct; ++i) {
+        GetValue(aValues[i]);
+      }
+
+      --_iDepth;
+
+      // Take over the array instead of copying it
+      val.FromArray(CValArray());
+      val.ToArray().swap(aValues);
+    } return;
+
+    case BIN_ARR_BOOL: {
+      const size_t ct = (size_t)GetVarint();
+      if (ct / 8 > (size_t)(_pEnd - _pCur)) Corrupted();
+
+      Need((ct + 7) / 8);
+
+      val.FromBoolArray(Bits_t());
+      Bits_t &aBits = val.ToBoolArray();
+      aBits.resize(ct);
+
+      for (size_t i = 0; i < ct; ++i) {
+        aBits[i] = ((_pCur[i / 8] >> (i % 8)) & 1) != 0;
+      }
+
+      _pCur += (ct + 7) / 8;
+    } return;
+
+    case BIN_ARR_BYTE: {
+      const size_t ct = GetCount(1);
+
+      val.FromByteArray(Bytes_t(_pCur, _pCur + ct));
+      _pCur += ct;
+    } return;
+
+    case BIN_ARR_INT: {
+      const size_t ct = GetCount(sizeof(s64));
+
+      val.FromIntArray(Ints_t());
+      Ints_t &aInts = val.ToIntArray();
+      aInts.resize(ct);
+
+      if (ct != 0) GetBlock64(&aInts[0], ct);
+    } return;
+
+    case BIN_ARR_FLOAT: {
+      const size_t ct = GetCount(sizeof(f64));
+
+      val.FromFloatArray(Numbers_t());
+      Numbers_t &aNumbers = val.ToFloatArray();
+      aNumbers.resize(ct);
+
+      if (ct != 0) GetBlock64(&aNumbers[0], ct);
+    } return;
+
+    case BIN_ARR_STR: {
+      const size_t ct = GetCount(1);
+
+      val.FromStrArray(Strings_t());
+      Strings_t &aStrings = val.ToStrArray();
+      aStrings.resize(ct);
+
+      for (size_t i = 0; i < ct; ++i) {
+        GetString(aStrings[i]);
+      }
+    } return;
+
+    case BIN_ARR_VEC2: {
+      const size_t ct = GetCount(sizeof(vec2d));
+
+      val.FromVec2Array(Vec2Array_t());
+      Vec2Array_t &aVectors = val.ToVec2Array();
+      aVectors.resize(ct);
+
+      if (ct != 0) GetBlock64(&aVectors[0][0], ct * 2);
+    } return;
+
+    case BIN_ARR_VEC3: {
+      const size_t ct = GetCount(sizeof(vec3d));
+
+      val.FromVec3Array(Vec3Array_t());
+      Vec3Array_t &aVectors = val.ToVec3Array();
+      aVectors.resize(ct);
+
+      if (ct != 0) GetBlock64(&aVectors[0][0], ct * 3);
+    } return;
+  }
+
+  CMessageException::Throw("Unknown binary variant tag 0x%02X", (u32)ubTag);
+};
+
+u64 CReader::GetVarint(void) {
+  u64 i = 0;
+
+  for (u32 iShift = 0; iShift < 64; iShift += 7) {
+    const u8 ub = GetByte();
+    i |= (u64)(ub & 0x7F) << iShift;
+
+    if (!(ub & 0x80)) return i;
+  }
+
+  Corrupted();
+  return 0;
+};
+
+f64 CReader::GetFloat(void) {
+  f64 f;
+  GetBlock64(&f, 1);
+  return f;
+};
+
+void CReader::GetString(CString &str) {
+  const size_t iLength = GetCount(1);
+
+  str.assign((const c8 *)_pCur, iLength);
+  _pCur += iLength;
+};
+
+// Get a block of raw 64-bit values of any type
+void CReader::GetBlock64(void *pData, size_t ct) {
+  const size_t iSize = ct * sizeof(u64);
+  Need(iSize);
+
+  if (!_bSwap) {
+    memcpy(pData, _pCur, iSize);
+
+  } else {
+    // Swap bytes in an aligned copy
+    std::vector<u64> aSwapped(ct);
+    memcpy(&aSwapped[0], _pCur, iSize);
+    ByteSwapArray64(&aSwapped[0], &aSwapped[0], ct);
+    memcpy(pData, &aSwapped[0], iSize);
+  }
+
+  _pCur += iSize;
+};
+
+void CReader::GetObject(CVariant &val) {
+  const size_t iShape = (size_t)GetVarint();
+  CObjectShape *pShape;
+
+  if (iShape == 0) {
+    // Define a new shape
+    const size_t ctKeys = GetCount(1);
+
+    if (ctKeys == 0) {
+      val.FromObject(CValObject());
+      return;
+    }
+
+    std::vector<CHashedString> aKeys(ctKeys);
+    unordered_map<u64, u32> mapKeys(ctKeys);
+
+    for (size_t i = 0; i < ctKeys; ++i) {
+      CString strKey;
+      GetString(strKey);
+      aKeys[i] = CHashedString(strKey);
+
+      std::pair<unordered_map<u64, u32>::iterator, bool> res = mapKeys.insert(std::make_pair(aKeys[i].GetHash(), (u32)i));
+      if (res.second) continue;
+
+      // Shapes can't have repeating keys
+      const CString &strOther = aKeys[res.first->second].GetString();
+      if (strOther == strKey) Corrupted();
+
+      // Different keys with the same hash can't be told apart by a shape
+      CMessageException::Throw("Object keys '%s' and '%s' have the same hash", strOther.c_str(), strKey.c_str());
+    }
+
+    _aShapes.reserve(_aShapes.size() + 1);
+    pShape = _shapes.Intern(&aKeys[0], ctKeys);
+    _aShapes.push_back(pShape);
+
+  } else {
+    if (iShape > _aShapes.size()) Corrupted();
+    pShape = _aShapes[iShape - 1];
+  }
+
+  const size_t ctValues = pShape->Size();
+  if (ctValues > (size_t)(_pEnd - _pCur)) Corrupted();
+
+  CValObject::Values_t aValues(ctValues);
+  Nest();
+
+  for (size_t i = 0; i < ctValues; ++i) {
+    GetValue(aValues[i]);
+  }
+
+  --_iDepth;
+
+  val.FromObject(CValObject());
+  val.ToObject().Assign(pShape, aValues);
+};
+
+// Get amount of elements that must fit in the rest of the payload
+size_t CReader::GetCount(size_t iElementSize) {
+  const u64 ct = GetVarint();
+  if (ct > (u64)(_pEnd - _pCur) / iElementSize) Corrupted();
+
+  return (size_t)ct;
+};
+
+// Forget shapes of the current frame
+void CReader::ReleaseShapes(void) {
+  const size_t ctShapes = _aShapes.size();
+
+  for (size_t i = 0; i < ctShapes; ++i) {
+    _aShapes[i]->Release();
+  }
+
+  _aShapes.clear();
+};
+
+// Throw an exception about malformed data
+void CReader::Corrupted(void) {
+  throw CMessageException("Malformed binary variant data");
+};
+
+}; // namespace varbin
+
+// Write variant in the compact binary format
+CDataStream &operator<<(CDataStream &strm, const CVariant &val) {
+  varbin::CWriter writer(strm);
+  writer.Write(val);
+
+  return strm;
+};
+
+// Read variant in the compact binary format
+CDataStream &operator>>(CDataStream &strm, CVariant &val) {
+  varbin::CReader reader(strm);
+  reader.Read(val);
+
+  return strm;
+};
+
+}; // namespace dreamy
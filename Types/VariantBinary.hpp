@@ -0,0 +1,162 @@
+//! This file is a part of Dreamy Utilities.
+//! Licensed under the MIT license (see LICENSE file).
+
+#ifndef _DREAMYUTILITIES_INCL_VARIANTBINARY_H
+#define _DREAMYUTILITIES_INCL_VARIANTBINARY_H
+
+#include "../DreamyUtilitiesBase.hpp"
+
+#include "Variant.hpp"
+#include "../IO/DataStream.hpp"
+
+#include <vector>
+
+namespace dreamy {
+
+// Compact binary format of variant trees
+// Each value is written as a frame: format version, payload size as a varint and the payload
+// Payload values start with a tag byte and typed arrays are stored as raw blocks in the byte order of the stream
+namespace varbin {
+
+// Current format version
+static const u8 BIN_VERSION = 1;
+
+// Maximum nesting depth of arrays and objects that can be read
+static const u32 BIN_MAX_DEPTH = 512;
+
+// Value tags
+enum ETag {
+  BIN_NULL,
+  BIN_FALSE,
+  BIN_TRUE,
+  BIN_INT,    // Zigzag varint
+  BIN_FLOAT,  // 64-bit float
+  BIN_STRING, // Varint length and characters
+  BIN_OBJECT, // Varint shape reference (0 for a new shape) and values of each key
+
+  BIN_VEC2,
+  BIN_VEC3,
+  BIN_MAT2,
+  BIN_MAT3,
+
+  BIN_ARR,       // Varint count and values
+  BIN_ARR_BOOL,  // Varint count and packed bits
+  BIN_ARR_BYTE,  // Varint count and raw bytes
+  BIN_ARR_INT,   // Varint count and raw 64-bit integers
+  BIN_ARR_FLOAT, // Varint count and raw 64-bit floats
+  BIN_ARR_STR,   // Varint count and strings
+  BIN_ARR_VEC2,  // Varint count and raw 2D vectors
+  BIN_ARR_VEC3,  // Varint count and raw 3D vectors
+
+  // Integers from 0 to 127 are stored in the tag itself
+  BIN_FIXINT = 0x80,
+};
+
+// Writer of variant trees into a stream
+// Keys of objects are written once per shape and later objects refer to it
+class CWriter {
+
+private:
+  CDataStream &_strm;
+  Bytes_t _aPayload; // Encoded value before it's written into the stream
+  unordered_map<const CObjectShape *, u32> _mapShapes; // Indices of written shapes
+  bool _bSwap; // Stream uses a different byte order
+
+public:
+  // Constructor with a stream to write into
+  CWriter(CDataStream &strm);
+
+  // Write one value frame
+  void Write(const CVariant &val);
+
+private:
+  void PutValue(const CVariant &val);
+  void PutVarint(u64 i);
+  void PutFloat(f64 f);
+  void PutString(const CString &str);
+  void PutBlock64(const void *pData, size_t ct);
+
+  inline void PutByte(u8 ub) {
+    _aPayload.push_back(ub);
+  };
+
+  // Copying is not allowed
+  CWriter(const CWriter &);
+  CWriter &operator=(const CWriter &);
+};
+
+// Reader of variant trees from a stream
+// Objects that are read by the same reader share keys
+class CReader {
+
+private:
+  CDataStream &_strm;
+  Bytes_t _aPayload; // Encoded value that's being read
+  const u8 *_pCur; // Current payload byte
+  const u8 *_pEnd; // End of the payload
+
+  CObjectShapeCache _shapes; // Shapes shared between frames
+  std::vector<CObjectShape *> _aShapes; // Shapes of the current frame in the order of appearance
+  u32 _iDepth; // Nesting depth of the current value
+  bool _bSwap; // Stream uses a different byte order
+
+public:
+  // Constructor with a stream to read from
+  CReader(CDataStream &strm);
+
+  // Destructor
+  ~CReader();
+
+  // Read one value frame (invalid value if the stream ended)
+  void Read(CVariant &val);
+
+private:
+  void GetValue(CVariant &val);
+  u64 GetVarint(void);
+  f64 GetFloat(void);
+  void GetString(CString &str);
+  void GetBlock64(void *pData, size_t ct);
+  void GetObject(CVariant &val);
+
+  // Get amount of elements that must fit in the rest of the payload
+  size_t GetCount(size_t iElementSize);
+
+  // Make sure there are enough bytes left
+  inline void Need(size_t iBytes) {
+    if ((size_t)(_pEnd - _pCur) < iBytes) Corrupted();
+  };
+
+  inline u8 GetByte(void) {
+    Need(1);
+    return *(_pCur++);
+  };
+
+  // Go one level deeper into an array or an object
+  inline void Nest(void) {
+    if (++_iDepth > BIN_MAX_DEPTH) Corrupted();
+  };
+
+  // Forget shapes of the current frame
+  void ReleaseShapes(void);
+
+  // Throw an exception about malformed data
+  void Corrupted(void);
+
+  // Copying is not allowed
+  CReader(const CReader &);
+  CReader &operator=(const CReader &);
+};
+
+}; // namespace varbin
+
+// Write variant in the compact binary format
+// Pointers and custom types can't be written and throw CMessageException
+CDataStream &operator<<(CDataStream &strm, const CVariant &val);
+
+// Read variant in the compact binary format
+// Throws CMessageException on malformed data
+CDataStream &operator>>(CDataStream &strm, CVariant &val);
+
+}; // namespace dreamy
+
+#endif // (Dreamy Utilities Include Guard)
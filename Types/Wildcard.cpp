@@ -0,0 +1,248 @@
+//! This file is a part of Dreamy Utilities.
+//! Licensed under the MIT license (see LICENSE file).
+
+#include "Wildcard.hpp"
+
+namespace dreamy {
+
+void CWildcardPattern::Compile(const c8 *strMask, bool bCaseSensitive) {
+  _strChars.clear();
+  _aAnyChar.clear();
+  _aSegments.clear();
+  _bStars = false;
+  _bCaseSensitive = bCaseSensitive;
+
+  memset(_aRequired, 0, sizeof(_aRequired));
+
+  for (u32 i = 0; i < 256; ++i) {
+    _aFold[i] = (bCaseSensitive ? u8(i) : u8(CString::CharToLower(c8(i))));
+  }
+
+  Segment seg;
+  seg.iStart = 0;
+  seg.bAnyChars = false;
+
+  const c8 *pch = strMask;
+
+  while (true) {
+    c8 ch = *pch;
+
+    // End of the current segment
+    if (ch == '\0' || ch == '*') {
+      seg.iLength = u32(_strChars.length()) - seg.iStart;
+      _aSegments.push_back(seg);
+
+      if (ch == '\0') break;
+
+      // Skip subsequent wildcards
+      while (*pch == '*') ++pch;
+
+      _bStars = true;
+      seg.iStart = u32(_strChars.length());
+      seg.bAnyChars = false;
+      continue;
+    }
+
+    // Escape character followed by a wildcard character
+    if (ch == '\\' && (pch[1] == '*' || pch[1] == '?')) {
+      ch = *++pch;
+
+    } else if (ch == '?') {
+      _strChars += '\0';
+      _aAnyChar.push_back(1);
+      seg.bAnyChars = true;
+
+      ++pch;
+      continue;
+    }
+
+    _strChars += c8(_aFold[u8(ch)]);
+    _aAnyChar.push_back(0);
+
+    // Remember which characters must be present
+    const u8 iRequired = u8(CString::CharToLower(ch));
+    _aRequired[iRequired >> 5] |= (1UL << (iRequired & 31));
+
+    ++pch;
+  }
+
+  _iMinLength = _strChars.length();
+};
+
+bool CWildcardPattern::SegmentAt(const Segment &seg, const c8 *pch) const {
+  if (seg.iLength == 0) return true;
+
+  const c8 *pchPattern = _strChars.data() + seg.iStart;
+
+  if (!seg.bAnyChars) {
+    if (_bCaseSensitive) return memcmp(pch, pchPattern, seg.iLength) == 0;
+
+    for (u32 i = 0; i < seg.iLength; ++i) {
+      if (c8(_aFold[u8(pch[i])]) != pchPattern[i]) return false;
+    }
+
+    return true;
+  }
+
+  const u8 *aAnyChar = &_aAnyChar[seg.iStart];
+
+  for (u32 i = 0; i < seg.iLength; ++i) {
+    if (!aAnyChar[i] && c8(_aFold[u8(pch[i])]) != pchPattern[i]) return false;
+  }
+
+  return true;
+};
+
+const c8 *CWildcardPattern::FindSegment(const Segment &seg, const c8 *pchBegin, const c8 *pchEnd) const {
+  if (size_t(pchEnd - pchBegin) < seg.iLength) return nullptr;
+
+  const c8 *pchLast = pchEnd - seg.iLength;
+
+  // Look for the first character that isn't a '?' wildcard
+  u32 iAnchor = 0;
+
+  if (seg.bAnyChars) {
+    const u8 *aAnyChar = &_aAnyChar[seg.iStart];
+    while (iAnchor < seg.iLength && aAnyChar[iAnchor]) ++iAnchor;
+
+    // Matches anywhere
+    if (iAnchor == seg.iLength) return pchBegin;
+  }
+
+  const c8 chAnchor = _strChars[seg.iStart + iAnchor];
+
+  for (const c8 *pch = pchBegin; pch <= pchLast; ++pch) {
+    if (_bCaseSensitive) {
+      pch = (const c8 *)memchr(pch + iAnchor, chAnchor, pchLast - pch + 1);
+      if (pch == nullptr) return nullptr;
+
+      pch -= iAnchor;
+
+    } else if (c8(_aFold[u8(pch[iAnchor])]) != chAnchor) {
+      continue;
+    }
+
+    if (SegmentAt(seg, pch)) return pch;
+  }
+
+  return nullptr;
+};
+
+bool CWildcardPattern::Match(const CStringView &str) const {
+  const size_t iLength = str.length();
+  if (iLength < _iMinLength) return false;
+
+  const c8 *pch = str.data();
+  const Segment &segFirst = _aSegments.front();
+
+  // Exact length without wildcards
+  if (!_bStars) return iLength == _iMinLength && SegmentAt(segFirst, pch);
+
+  // Check the suffix (e.g. file extension) and the prefix first
+  const Segment &segLast = _aSegments.back();
+
+  if (!SegmentAt(segLast, pch + iLength - segLast.iLength)) return false;
+  if (!SegmentAt(segFirst, pch)) return false;
+
+  const c8 *pchCur = pch + segFirst.iLength;
+  const c8 *pchEnd = pch + iLength - segLast.iLength;
+
+  // Find pieces in the middle in order
+  // Taking the leftmost occurrence of each piece leaves the most room for the rest, so there's no need to backtrack
+  const size_t ctSegments = _aSegments.size();
+
+  for (size_t iSeg = 1; iSeg + 1 < ctSegments; ++iSeg) {
+    const Segment &seg = _aSegments[iSeg];
+
+    pchCur = FindSegment(seg, pchCur, pchEnd);
+    if (pchCur == nullptr) return false;
+
+    pchCur += seg.iLength;
+  }
+
+  return true;
+};
+
+// Gather a bitmap of characters in a string, including their lowercase variants
+static void GatherPresentChars(const CStringView &str, u32 *aPresent) {
+  memset(aPresent, 0, 8 * sizeof(u32));
+
+  const u8 *pch = (const u8 *)str.data();
+  const size_t iLength = str.length();
+
+  for (size_t i = 0; i < iLength; ++i) {
+    aPresent[pch[i] >> 5] |= (1UL << (pch[i] & 31));
+  }
+
+  // Add lowercase variants of uppercase ASCII letters and non-ASCII characters
+  for (u32 iChar = 'A'; iChar < 256; ++iChar) {
+    if (iChar == 'Z' + 1) iChar = 128;
+    if (!(aPresent[iChar >> 5] & (1UL << (iChar & 31)))) continue;
+
+    const u8 iLower = u8(CString::CharToLower(c8(iChar)));
+    aPresent[iLower >> 5] |= (1UL << (iLower & 31));
+  }
+};
+
+size_t CWildcardSet::Add(const c8 *strMask, bool bCaseSensitive) {
+  _aPatterns.push_back(CWildcardPattern(strMask, bCaseSensitive));
+
+  const size_t iMinLength = _aPatterns.back().MinLength();
+  if (iMinLength < _iMinLength) _iMinLength = iMinLength;
+
+  return _aPatterns.size() - 1;
+};
+
+void CWildcardSet::Clear(void) {
+  _aPatterns.clear();
+  _iMinLength = NULL_POS;
+};
+
+bool CWildcardSet::MatchPattern(const CWildcardPattern &pattern, const CStringView &str, const u32 *aPresent) const {
+  if (str.length() < pattern._iMinLength) return false;
+
+  // Some required character is missing
+  for (s32 i = 0; i < 8; ++i) {
+    if (pattern._aRequired[i] & ~aPresent[i]) return false;
+  }
+
+  return pattern.Match(str);
+};
+
+size_t CWildcardSet::MatchFirst(const CStringView &str) const {
+  if (str.length() < _iMinLength) return NULL_POS;
+
+  // Examine the string once for all masks
+  u32 aPresent[8];
+  GatherPresentChars(str, aPresent);
+
+  const size_t ct = _aPatterns.size();
+
+  for (size_t i = 0; i < ct; ++i) {
+    if (MatchPattern(_aPatterns[i], str, aPresent)) return i;
+  }
+
+  return NULL_POS;
+};
+
+size_t CWildcardSet::MatchAll(const CStringView &str, std::vector<size_t> &aMatches) const {
+  if (str.length() < _iMinLength) return 0;
+
+  // Examine the string once for all masks
+  u32 aPresent[8];
+  GatherPresentChars(str, aPresent);
+
+  const size_t ct = _aPatterns.size();
+  size_t ctMatches = 0;
+
+  for (size_t i = 0; i < ct; ++i) {
+    if (!MatchPattern(_aPatterns[i], str, aPresent)) continue;
+
+    aMatches.push_back(i);
+    ++ctMatches;
+  }
+
+  return ctMatches;
+};
+
+}; // namespace dreamy
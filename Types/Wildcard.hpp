@@ -0,0 +1,115 @@
+//! This file is a part of Dreamy Utilities.
+//! Licensed under the MIT license (see LICENSE file).
+
+#ifndef _DREAMYUTILITIES_INCL_WILDCARD_H
+#define _DREAMYUTILITIES_INCL_WILDCARD_H
+
+#include "../DreamyUtilitiesBase.hpp"
+
+#include "String.hpp"
+#include "StringView.hpp"
+
+#include <vector>
+
+namespace dreamy {
+
+// Wildcard mask that's compiled once and then matched against many strings
+// '*' matches any amount of characters, '?' matches any single character, "\*" and "\?" match the characters themselves
+// Matching never backtracks: the mask is split into literal pieces between '*' wildcards that are found left to right
+class CWildcardPattern {
+
+friend class CWildcardSet;
+
+private:
+  // Piece of the mask between '*' wildcards
+  struct Segment {
+    u32 iStart; // Position within the pattern characters
+    u32 iLength;
+    bool bAnyChars; // Has '?' wildcards
+  };
+
+  CString _strChars; // Characters of all segments (folded if case-insensitive)
+  std::vector<u8> _aAnyChar; // Whether each character is a '?' wildcard
+  std::vector<Segment> _aSegments; // Prefix, required pieces in the middle and suffix
+  bool _bStars; // Has '*' wildcards (otherwise there's exactly one segment)
+  bool _bCaseSensitive;
+  size_t _iMinLength; // Minimal length of a matching string
+
+  u8 _aFold[256]; // Character conversion before comparison
+  u32 _aRequired[8]; // Bitmap of lowercase characters that every match must contain
+
+public:
+  // Empty mask that only matches an empty string
+  CWildcardPattern() {
+    Compile("");
+  };
+
+  // Compile a mask
+  CWildcardPattern(const c8 *strMask, bool bCaseSensitive = false) {
+    Compile(strMask, bCaseSensitive);
+  };
+
+  // Compile a new mask
+  void Compile(const c8 *strMask, bool bCaseSensitive = false);
+
+  // Check if a string matches the mask
+  bool Match(const CStringView &str) const;
+
+  // Get minimal length of a matching string
+  inline size_t MinLength(void) const {
+    return _iMinLength;
+  };
+
+private:
+  // Check if a segment matches characters at some position
+  bool SegmentAt(const Segment &seg, const c8 *pch) const;
+
+  // Find the leftmost position of a segment within a range of characters or return nullptr
+  const c8 *FindSegment(const Segment &seg, const c8 *pchBegin, const c8 *pchEnd) const;
+};
+
+// Set of compiled wildcard masks that can be tested against one string at once
+class CWildcardSet {
+
+private:
+  std::vector<CWildcardPattern> _aPatterns;
+  size_t _iMinLength; // Minimal length among all masks
+
+public:
+  CWildcardSet() : _iMinLength(NULL_POS) {};
+
+  // Compile and add a mask and return its index
+  size_t Add(const c8 *strMask, bool bCaseSensitive = false);
+
+  // Remove all masks
+  void Clear(void);
+
+  // Get amount of masks
+  inline size_t Count(void) const {
+    return _aPatterns.size();
+  };
+
+  // Get a compiled mask
+  inline const CWildcardPattern &operator[](size_t i) const {
+    return _aPatterns[i];
+  };
+
+  // Get index of the first mask that matches a string or NULL_POS
+  size_t MatchFirst(const CStringView &str) const;
+
+  // Gather indices of all masks that match a string and return their amount
+  size_t MatchAll(const CStringView &str, std::vector<size_t> &aMatches) const;
+
+  // Check if any mask matches a string
+  inline bool MatchAny(const CStringView &str) const {
+    return MatchFirst(str) != NULL_POS;
+  };
+
+private:
+  // Check one mask against a string with known characters
+  bool MatchPattern(const CWildcardPattern &pattern, const CStringView &str, const u32 *aPresent) const;
+};
+
+}; // namespace dreamy
+
+#endif // (Dreamy Utilities Include Guard)